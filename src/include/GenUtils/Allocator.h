@@ -0,0 +1,129 @@
+/// @file Allocator.h
+/// @author DP-Dev
+/// @brief Interface to plug custom allocators into the
+/// containers.
+///
+/// Every container can be created with an allocator, that
+/// is used for the container itself and for its nodes. A
+/// NULL allocator means that malloc and free are used
+/// directly.
+#ifndef GENUTILS_ALLOCATOR_H
+#define GENUTILS_ALLOCATOR_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief An structure to represent an allocator.
+  typedef struct GenUtils_Allocator
+  {
+    /// @brief Allocate memory. It receives the context and
+    /// the number of bytes, and returns the memory or NULL
+    /// on error. The memory must be aligned like the memory
+    /// returned by malloc.
+    void *(*alloc)(void *context, size_t size);
+    /// @brief Release memory. It receives the context, the
+    /// memory and the number of bytes that were requested.
+    void (*free)(void *context, void *pointer, size_t size);
+    /// @brief Release all the memory of the allocator at
+    /// once, NULL if it isn't supported. When it's set, a
+    /// container destroyed calls it once instead of
+    /// releasing every node, so the allocator must be used
+    /// by a single container. A container made of other
+    /// containers gives them a copy made with
+    /// GenUtils_AllocatorShare, so only it resets it.
+    void (*reset)(void *context);
+    /// @brief User data passed to the functions.
+    void *context;
+  } GenUtils_Allocator;
+
+  /// @brief Allocate memory with an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc.
+  /// @param size The number of bytes to allocate.
+  /// @return The memory or NULL on error.
+  static inline void *GenUtils_AllocatorAlloc(
+    const GenUtils_Allocator *allocator, size_t size)
+  {
+    if (allocator == NULL)
+    {
+      return malloc(size);
+    }
+    return allocator->alloc(allocator->context, size);
+  }
+
+  /// @brief Release memory with an allocator.
+  /// @param allocator The allocator that allocated the
+  /// memory, or NULL to use free.
+  /// @param pointer The memory to release, NULL is allowed.
+  /// @param size The number of bytes that were allocated.
+  static inline void GenUtils_AllocatorFree(
+    const GenUtils_Allocator *allocator, void *pointer,
+    size_t size)
+  {
+    if (allocator == NULL)
+    {
+      free(pointer);
+    }
+    else if (pointer != NULL)
+    {
+      allocator->free(allocator->context, pointer, size);
+    }
+  }
+
+  /// @brief Check if an allocator can release all its
+  /// memory at once.
+  /// @param allocator The allocator to query.
+  /// @return true if the allocator have a reset function.
+  static inline bool GenUtils_AllocatorCanReset(
+    const GenUtils_Allocator *allocator)
+  {
+    return allocator != NULL && allocator->reset != NULL;
+  }
+
+  /// @brief Make a copy of an allocator that can't be
+  /// reset, for the containers used inside another one.
+  /// They release their memory block by block, and only
+  /// the outer container resets the allocator.
+  /// @param allocator The allocator to copy, or NULL.
+  /// @param shared Where the copy is stored. It must be
+  /// valid while the inner containers exist.
+  /// @return The copy, or NULL if allocator is NULL.
+  static inline const GenUtils_Allocator *
+    GenUtils_AllocatorShare(
+      const GenUtils_Allocator *allocator,
+      GenUtils_Allocator *shared)
+  {
+    if (allocator == NULL)
+    {
+      return NULL;
+    }
+    *shared = *allocator;
+    shared->reset = NULL;
+    return shared;
+  }
+
+  /// @brief Release all the memory of an allocator.
+  /// @param allocator The allocator to reset.
+  /// @return true if the allocator was reset, false if it
+  /// doesn't support it.
+  static inline bool GenUtils_AllocatorReset(
+    const GenUtils_Allocator *allocator)
+  {
+    if (!GenUtils_AllocatorCanReset(allocator))
+    {
+      return false;
+    }
+    allocator->reset(allocator->context);
+    return true;
+  }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
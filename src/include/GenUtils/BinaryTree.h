@@ -1,6 +1,17 @@
 /// @file BinaryTree.h
 /// @author DP-Dev
 /// @brief Implementation of a binary tree.
+///
+/// The tree is a red-black tree, so it keeps a height of
+/// O(log n) after every insertion and removal. The keys
+/// are compared with strcmp, lesser keys are stored in the
+/// first (left) child of a node and greater keys in the
+/// second (right) child. The userdata of every node points
+/// to its GenUtils_BinaryTreeKeyValue pair.
+/// Every node also stores the first bytes of its key in
+/// big-endian order and the length of the key, so most
+/// comparisons are one integer comparison and the keys are
+/// only read when their prefixes are equal.
 #ifndef GENUTILS_BYNARY_TREE
 #define GENUTILS_BYNARY_TREE
 
@@ -8,10 +19,47 @@
 extern "C"
 {
 #endif
+#include <GenUtils/Allocator.h>
+#include <GenUtils/Pool.h>
 #include <GenUtils/types.h>
 #include <stdbool.h>
 #include <stddef.h>
 
+  /// @brief Maximum height of a binary tree, and the number
+  /// of nodes stored by a cursor. The height of a red-black
+  /// tree is at most 2 * log2(n + 1), and n can't be
+  /// greater than SIZE_MAX / sizeof(node).
+#define GENUTILS_BINARY_TREE_MAX_HEIGHT 128
+
+  /// @brief An structure to represent a block of the arena
+  /// where a binary tree stores a copy of its keys.
+  typedef struct GenUtils_BinaryTreeKeyBlock
+  {
+    /// @brief The block filled before this one, or NULL.
+    struct GenUtils_BinaryTreeKeyBlock *previous;
+    /// @brief The number of bytes of the data.
+    size_t capacity;
+    /// @brief The keys, one after another with their null
+    /// characters, in the order they were inserted or in
+    /// sorted order after a compaction.
+    char data[];
+  } GenUtils_BinaryTreeKeyBlock;
+
+  /// @brief An structure to represent the arena where a
+  /// binary tree stores a copy of its keys.
+  typedef struct GenUtils_BinaryTreeKeyArena
+  {
+    /// @brief The block where the keys are copied, linked
+    /// to the full ones, or NULL if there is none.
+    GenUtils_BinaryTreeKeyBlock *block;
+    /// @brief The number of bytes used in the block.
+    size_t used;
+    /// @brief The number of bytes used in all the blocks.
+    size_t size;
+    /// @brief The number of used bytes of removed keys.
+    size_t garbage;
+  } GenUtils_BinaryTreeKeyArena;
+
   /// @brief An structure to represent a Binary Tree.
   typedef struct GenUtils_BinaryTree
   {
@@ -19,8 +67,59 @@ extern "C"
     GenUtils_DoubleNode *root;
     /// @brief The number of elements of the binary tree.
     size_t size;
+    /// @brief Pool of the nodes, or NULL if the nodes are
+    /// allocated with malloc.
+    GenUtils_Pool *pool;
+    /// @brief Arena of the keys, or NULL if the keys are
+    /// owned by the caller.
+    GenUtils_BinaryTreeKeyArena *keyArena;
+    /// @brief true if every node stores the number of nodes
+    /// of its subtree.
+    bool counted;
+    /// @brief Allocator of the tree and its nodes, or NULL
+    /// to use malloc.
+    const GenUtils_Allocator *allocator;
   } GenUtils_BinaryTree;
 
+  /// @brief An structure to represent the options of a
+  /// binary tree. A zeroed structure gives a plain tree
+  /// that uses malloc.
+  typedef struct GenUtils_BinaryTreeOptions
+  {
+    /// @brief Allocator of the tree and its nodes, or NULL
+    /// to use malloc. It must be valid until the tree is
+    /// destroyed.
+    const GenUtils_Allocator *allocator;
+    /// @brief true to take the nodes from a pool of the
+    /// tree, released at once when the tree is cleared.
+    bool pool;
+    /// @brief The number of elements expected by the pool.
+    size_t poolHint;
+    /// @brief true to store a copy of the keys in an arena.
+    ///
+    /// The inserted keys are copied one after another in
+    /// blocks, so the caller doesn't need to keep them and
+    /// the keys of near nodes are near in memory. A full
+    /// block is kept and a new one twice as big is chained
+    /// to it, so the keys never move. The space of the
+    /// removed keys is reclaimed only when the tree is
+    /// balanced, which copies the keys to a single block of
+    /// the new tree, and when it's cleared. The keys belong
+    /// to the tree: the keys got from it, and the keys of
+    /// the maps made from it, are valid until it's
+    /// balanced, cleared or destroyed.
+    bool keyArena;
+    /// @brief The number of bytes of the keys expected,
+    /// counting their null characters.
+    size_t keyArenaHint;
+    /// @brief true to store in every node the number of
+    /// nodes of its subtree, so the keys can be selected by
+    /// position and ranked in O(log n). The counts are kept
+    /// by insertions and removals, and every node takes a
+    /// size_t more.
+    bool counted;
+  } GenUtils_BinaryTreeOptions;
+
   /// @brief Structure representing a key/value pair.
   typedef struct GenUtils_BinaryTreeKeyValue
   {
@@ -30,10 +129,44 @@ extern "C"
     void *value;
   } GenUtils_BinaryTreeKeyValue;
 
+  /// @brief An structure to represent a cursor of a binary
+  /// tree. It stores the path from the root to the current
+  /// node, so it moves to the next or previous key in
+  /// amortized O(1) without recursion. A cursor is
+  /// invalidated by any change of its tree.
+  typedef struct GenUtils_BinaryTreeCursor
+  {
+    /// @brief The tree of the cursor.
+    GenUtils_BinaryTree *binaryTree;
+    /// @brief The nodes from the root to the current node.
+    GenUtils_DoubleNode
+      *path[GENUTILS_BINARY_TREE_MAX_HEIGHT];
+    /// @brief The number of nodes in the path, 0 if the
+    /// cursor is past the ends of the tree.
+    size_t depth;
+  } GenUtils_BinaryTreeCursor;
+
   /// @brief Create a new binary tree.
   /// @return The new binary tree or NULL on error.
   GenUtils_BinaryTree *GenUtils_BinaryTreeCreate();
 
+  /// @brief Create a new binary tree that takes the memory
+  /// of the tree and its nodes from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the tree is destroyed.
+  /// @return The new binary tree or NULL on error.
+  GenUtils_BinaryTree *
+    GenUtils_BinaryTreeCreateWithAllocator(
+      const GenUtils_Allocator *allocator);
+
+  /// @brief Create a new binary tree with some options.
+  /// @param options The options of the tree, or NULL to
+  /// create a plain tree that uses malloc.
+  /// @return The new binary tree or NULL on error.
+  GenUtils_BinaryTree *
+    GenUtils_BinaryTreeCreateWithOptions(
+      const GenUtils_BinaryTreeOptions *options);
+
   /// @brief Destroy a binary tree.
   /// @param binaryTree The binary tree to destroy.
   void GenUtils_BinaryTreeDestroy(
@@ -117,7 +250,13 @@ extern "C"
     GenUtils_BinaryTree *binaryTree, const char *key);
 
   /// @brief Balance a binary tree.
-  /// @param binaryTree The tree to balance.
+  ///
+  /// Insertions and removals already keep the tree
+  /// balanced, so calling this is never required.
+  /// @param binaryTree The tree to balance. It's destroyed
+  /// if the new tree is created, and the new tree has its
+  /// options. If the tree copies its keys, the new tree
+  /// copies them too, without the space of removed keys.
   /// @return The new binary tree.
   GenUtils_BinaryTree *GenUtils_BinaryTreeBalance(
     GenUtils_BinaryTree *binaryTree);
@@ -129,12 +268,35 @@ extern "C"
     GenUtils_BinaryTree *tree);
 
   /// @brief Make a balanced tree from a sorted array.
+  ///
+  /// The tree is built in linear time, taking the median of
+  /// every subarray as root. The tree takes its nodes from
+  /// a pool, and all of them are allocated in a single
+  /// block.
   /// @param array The array that will be used to create the
-  /// tree.
+  /// tree. Its keys must be sorted and unique.
   /// @param size The size of the array.
-  /// @return A new balanced tree.
+  /// @return A new balanced tree, or NULL on error or if
+  /// the array isn't sorted.
   GenUtils_BinaryTree *GenUtils_BinaryTreeFromArray(
-    GenUtils_BinaryTreeKeyValue *, size_t size);
+    GenUtils_BinaryTreeKeyValue *array, size_t size);
+
+  /// @brief Make a balanced tree with some options from a
+  /// sorted array, in linear time. If the tree has a pool,
+  /// all the nodes are allocated in a single block, and if
+  /// it has a key arena, all the keys are copied to a
+  /// single block.
+  /// @param array The array that will be used to create the
+  /// tree. Its keys must be sorted and unique.
+  /// @param size The size of the array.
+  /// @param options The options of the tree, or NULL to
+  /// create a plain tree that uses malloc.
+  /// @return A new balanced tree, or NULL on error or if
+  /// the array isn't sorted.
+  GenUtils_BinaryTree *
+    GenUtils_BinaryTreeFromArrayWithOptions(
+      GenUtils_BinaryTreeKeyValue *array, size_t size,
+      const GenUtils_BinaryTreeOptions *options);
 
   /// @brief Clear the content of a binary tree.
   /// @param binaryTree The binary tree to clear.
@@ -180,6 +342,147 @@ extern "C"
     void (*function)(
       const GenUtils_BinaryTreeKeyValue *, void *));
 
+  /// @brief Get the first pair of a binary tree whose key
+  /// is greater or equal to a key.
+  /// @param binaryTree The binary tree to search in.
+  /// @param key The key to search for.
+  /// @return The pair, or NULL if all the keys are lesser
+  /// or on error.
+  const GenUtils_BinaryTreeKeyValue *
+    GenUtils_BinaryTreeLowerBound(
+      GenUtils_BinaryTree *binaryTree, const char *key);
+
+  /// @brief Get the first pair of a binary tree whose key
+  /// is greater than a key.
+  /// @param binaryTree The binary tree to search in.
+  /// @param key The key to search for.
+  /// @return The pair, or NULL if no key is greater or on
+  /// error.
+  const GenUtils_BinaryTreeKeyValue *
+    GenUtils_BinaryTreeUpperBound(
+      GenUtils_BinaryTree *binaryTree, const char *key);
+
+  /// @brief Iterate in order through the elements of a
+  /// binary tree whose keys are in a range. Only the nodes
+  /// in the range and their ancestors are visited.
+  /// @param binaryTree The binary tree to iterate.
+  /// @param from The first key of the range, or NULL to
+  /// start at the first element.
+  /// @param to The key after the range, or NULL to end at
+  /// the last element.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function. It pass a
+  /// pointer to key/value pair and extradata.
+  void GenUtils_BinaryTreeRange(
+    GenUtils_BinaryTree *binaryTree, const char *from,
+    const char *to, void *extradata,
+    void (*function)(
+      const GenUtils_BinaryTreeKeyValue *, void *));
+
+  /// @brief Iterate in order through the elements of a
+  /// binary tree whose keys start with a prefix.
+  /// @param binaryTree The binary tree to iterate.
+  /// @param prefix The prefix of the keys.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function. It pass a
+  /// pointer to key/value pair and extradata.
+  void GenUtils_BinaryTreePrefixRange(
+    GenUtils_BinaryTree *binaryTree, const char *prefix,
+    void *extradata,
+    void (*function)(
+      const GenUtils_BinaryTreeKeyValue *, void *));
+
+  /// @brief Count the elements of a binary tree whose keys
+  /// are in a range. It takes O(log n) in the trees that
+  /// count the nodes of their subtrees.
+  /// @param binaryTree The binary tree to query.
+  /// @param from The first key of the range, or NULL to
+  /// start at the first element.
+  /// @param to The key after the range, or NULL to end at
+  /// the last element.
+  /// @return The number of keys in the range.
+  size_t GenUtils_BinaryTreeRangeCount(
+    GenUtils_BinaryTree *binaryTree, const char *from,
+    const char *to);
+
+  /// @brief Get the pair at a position of the sorted keys
+  /// of a binary tree. It takes O(log n) in the trees that
+  /// count the nodes of their subtrees and linear time in
+  /// the other ones.
+  /// @param binaryTree The binary tree to search in.
+  /// @param index The position of the pair, 0 for the
+  /// first key.
+  /// @return The pair, or NULL if the index isn't lesser
+  /// than the size of the tree or on error.
+  const GenUtils_BinaryTreeKeyValue *
+    GenUtils_BinaryTreeSelect(
+      GenUtils_BinaryTree *binaryTree, size_t index);
+
+  /// @brief Get the number of keys of a binary tree that
+  /// are lesser than a key, the position of the key if it
+  /// exists. It takes O(log n) in the trees that count the
+  /// nodes of their subtrees and linear time in the other
+  /// ones.
+  /// @param binaryTree The binary tree to search in.
+  /// @param key The key to rank.
+  /// @return The number of lesser keys, 0 on error.
+  size_t GenUtils_BinaryTreeRank(
+    GenUtils_BinaryTree *binaryTree, const char *key);
+
+  /// @brief Move a cursor to the first key of a binary
+  /// tree.
+  /// @param cursor The cursor to move.
+  /// @param binaryTree The tree to iterate.
+  /// @return true if the cursor is at a key, false if the
+  /// tree is empty or on error.
+  bool GenUtils_BinaryTreeCursorFirst(
+    GenUtils_BinaryTreeCursor *cursor,
+    GenUtils_BinaryTree *binaryTree);
+
+  /// @brief Move a cursor to the last key of a binary tree.
+  /// @param cursor The cursor to move.
+  /// @param binaryTree The tree to iterate.
+  /// @return true if the cursor is at a key, false if the
+  /// tree is empty or on error.
+  bool GenUtils_BinaryTreeCursorLast(
+    GenUtils_BinaryTreeCursor *cursor,
+    GenUtils_BinaryTree *binaryTree);
+
+  /// @brief Move a cursor to the first key of a binary tree
+  /// that is greater or equal to a key.
+  /// @param cursor The cursor to move.
+  /// @param binaryTree The tree to iterate.
+  /// @param key The key to search for.
+  /// @return true if the cursor is at a key, false if all
+  /// the keys are lesser or on error.
+  bool GenUtils_BinaryTreeCursorSeek(
+    GenUtils_BinaryTreeCursor *cursor,
+    GenUtils_BinaryTree *binaryTree, const char *key);
+
+  /// @brief Move a cursor to the next key.
+  /// @param cursor The cursor to move.
+  /// @return true if the cursor is at a key, false if it
+  /// was at the last key or past the ends.
+  bool GenUtils_BinaryTreeCursorNext(
+    GenUtils_BinaryTreeCursor *cursor);
+
+  /// @brief Move a cursor to the previous key.
+  /// @param cursor The cursor to move.
+  /// @return true if the cursor is at a key, false if it
+  /// was at the first key or past the ends.
+  bool GenUtils_BinaryTreeCursorPrev(
+    GenUtils_BinaryTreeCursor *cursor);
+
+  /// @brief Get the key/value pair at a cursor.
+  /// @param cursor The cursor to query.
+  /// @return The pair, or NULL if the cursor is past the
+  /// ends of its tree.
+  const GenUtils_BinaryTreeKeyValue *
+    GenUtils_BinaryTreeCursorGet(
+      const GenUtils_BinaryTreeCursor *cursor);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
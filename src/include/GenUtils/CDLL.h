@@ -3,11 +3,13 @@
 /// @brief Implementation of a CDLL.
 #ifndef GENUTILS_CDLL_H
 #define GENUTILS_CDLL_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/Pool.h>
 #include <GenUtils/types.h>
 #include <stdbool.h>
 #include <stdlib.h>
 
-#ifdef __cpluplus
+#ifdef __cplusplus
 extern "C"
 {
 #endif
@@ -19,16 +21,60 @@ extern "C"
     GenUtils_DoubleNode *head;
     /// @brief The number of elements of the list.
     size_t size;
+    /// @brief Pool of the nodes, or NULL if the nodes are
+    /// allocated with malloc.
+    GenUtils_Pool *pool;
+    /// @brief true if the pool belongs to the caller and
+    /// can be shared with other lists.
+    bool sharedPool;
+    /// @brief Allocator of the list and its nodes, or NULL
+    /// to use malloc.
+    const GenUtils_Allocator *allocator;
   } GenUtils_CDLL;
 
   /// @brief Create a new CDLL.
   /// @return The new CDLL structure or NULL on error.
   GenUtils_CDLL *GenUtils_CDLLCreate();
 
+  /// @brief Create a new CDLL that takes the memory of
+  /// the list and its nodes from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the list is destroyed.
+  /// @return The new CDLL structure or NULL on error.
+  GenUtils_CDLL *GenUtils_CDLLCreateWithAllocator(
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Create a new CDLL that takes its nodes from
+  /// its own pool. The nodes of the pool are released at
+  /// once when the list is cleared.
+  /// @param capacityHint The number of elements expected.
+  /// @return The new CDLL structure or NULL on error.
+  GenUtils_CDLL *GenUtils_CDLLCreateWithPool(
+    size_t capacityHint);
+
+  /// @brief Create a new CDLL that takes its nodes from a
+  /// pool of the caller. The lists that share a pool can
+  /// move nodes between them. The list returns its nodes to
+  /// the pool one by one, and never resets or destroys it.
+  /// @param pool The pool of the nodes, with objects of at
+  /// least sizeof(GenUtils_DoubleNode). It must be
+  /// valid until the list is destroyed.
+  /// @return The new CDLL structure or NULL on error.
+  GenUtils_CDLL *GenUtils_CDLLCreateWithSharedPool(
+    GenUtils_Pool *pool);
+
   /// @brief Destroy a CDLL.
   /// @param list The list to destroy.
   void GenUtils_CDLLDestroy(GenUtils_CDLL *list);
 
+  /// @brief Destroy a CDLL, calling a function with the
+  /// data of every element first.
+  /// @param list The list to destroy.
+  /// @param destructor The function that releases the data
+  /// of an element, NULL to do nothing.
+  void GenUtils_CDLLDestroyWith(
+    GenUtils_CDLL *list, void (*destructor)(void *));
+
   /// @brief Get the number of elements in a list.
   /// @param list The list to query.
   /// @return The number of elements in the list.
@@ -58,6 +104,14 @@ extern "C"
   GenUtils_DoubleNode *GenUtils_CDLLEnd(
     GenUtils_CDLL *list);
 
+  /// @brief Search a node by the pointer of its data.
+  /// @param list The list where to search.
+  /// @param userdata The data to search for.
+  /// @return The first node whose data is userdata, or NULL
+  /// if it isn't found.
+  GenUtils_DoubleNode *GenUtils_CDLLFind(
+    GenUtils_CDLL *list, void *userdata);
+
   /// @brief Insert data in the specified node.
   /// @param list The list where to insert.
   /// @param node The node where the data will be inserted.
@@ -128,6 +182,59 @@ extern "C"
   /// @param list The list to clear.
   void GenUtils_CDLLClear(GenUtils_CDLL *list);
 
+  /// @brief Clear the content of a list, calling a function
+  /// with the data of every element. The nodes are released
+  /// in the same pass.
+  /// @param list The list to clear.
+  /// @param destructor The function that releases the data
+  /// of an element, NULL to do nothing.
+  void GenUtils_CDLLClearWith(
+    GenUtils_CDLL *list, void (*destructor)(void *));
+
+  /// @brief Move all the nodes of a list to the tail of
+  /// another one in constant time.
+  /// @param destination The list that receives the nodes.
+  /// @param source The list that gives the nodes, it's left
+  /// empty.
+  /// @return true in success, false if the lists are the
+  /// same or if they don't share their pool or, without a
+  /// pool, their allocator.
+  bool GenUtils_CDLLConcat(
+    GenUtils_CDLL *destination, GenUtils_CDLL *source);
+
+  /// @brief Move a range of nodes from a list to another
+  /// one in constant time.
+  /// @param destination The list that receives the nodes.
+  /// @param position The node of destination before which
+  /// the range is inserted, or NULL to insert it at the
+  /// tail.
+  /// @param source The list that gives the nodes.
+  /// @param first The first node of the range.
+  /// @param last The last node of the range. The range goes
+  /// from first to last without passing the tail of source.
+  /// @param count The number of nodes of the range. It's
+  /// trusted to keep the move in constant time, and only
+  /// checked with assert in debug builds.
+  /// @return true in success, false if the lists are the
+  /// same or if they don't share their pool or, without a
+  /// pool, their allocator.
+  bool GenUtils_CDLLSplice(GenUtils_CDLL *destination,
+    GenUtils_DoubleNode *position, GenUtils_CDLL *source,
+    GenUtils_DoubleNode *first, GenUtils_DoubleNode *last,
+    size_t count);
+
+  /// @brief Split a list, moving a node and all the nodes
+  /// after it to the tail of another list. The cost is the
+  /// number of nodes moved.
+  /// @param list The list to split.
+  /// @param node The first node to move.
+  /// @param destination The list that receives the nodes.
+  /// @return true in success, false if the lists are the
+  /// same or if they don't share their pool or, without a
+  /// pool, their allocator.
+  bool GenUtils_CDLLSplit(GenUtils_CDLL *list,
+    GenUtils_DoubleNode *node, GenUtils_CDLL *destination);
+
   /// @brief Iterate through all the elements of a list.
   /// @param list The list where to be iterated.
   /// @param extradata Extradata to pass to the iterator
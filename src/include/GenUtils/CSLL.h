@@ -3,11 +3,13 @@
 /// @brief Implementation of a CSLL.
 #ifndef GENUTILS_CSLL_H
 #define GENUTILS_CSLL_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/Pool.h>
 #include <GenUtils/types.h>
 #include <stdbool.h>
 #include <stdlib.h>
 
-#ifdef __cpluplus
+#ifdef __cplusplus
 extern "C"
 {
 #endif
@@ -21,16 +23,60 @@ extern "C"
     GenUtils_SingleNode *tail;
     /// @brief The number of elements in the list.
     size_t size;
+    /// @brief Pool of the nodes, or NULL if the nodes are
+    /// allocated with malloc.
+    GenUtils_Pool *pool;
+    /// @brief true if the pool belongs to the caller and
+    /// can be shared with other lists.
+    bool sharedPool;
+    /// @brief Allocator of the list and its nodes, or NULL
+    /// to use malloc.
+    const GenUtils_Allocator *allocator;
   } GenUtils_CSLL;
 
   /// @brief Create a new CSLL.
   /// @return The new CSLL structure or NULL on error.
   GenUtils_CSLL *GenUtils_CSLLCreate();
 
+  /// @brief Create a new CSLL that takes the memory of
+  /// the list and its nodes from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the list is destroyed.
+  /// @return The new CSLL structure or NULL on error.
+  GenUtils_CSLL *GenUtils_CSLLCreateWithAllocator(
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Create a new CSLL that takes its nodes from
+  /// its own pool. The nodes of the pool are released at
+  /// once when the list is cleared.
+  /// @param capacityHint The number of elements expected.
+  /// @return The new CSLL structure or NULL on error.
+  GenUtils_CSLL *GenUtils_CSLLCreateWithPool(
+    size_t capacityHint);
+
+  /// @brief Create a new CSLL that takes its nodes from a
+  /// pool of the caller. The lists that share a pool can
+  /// move nodes between them. The list returns its nodes to
+  /// the pool one by one, and never resets or destroys it.
+  /// @param pool The pool of the nodes, with objects of at
+  /// least sizeof(GenUtils_SingleNode). It must be
+  /// valid until the list is destroyed.
+  /// @return The new CSLL structure or NULL on error.
+  GenUtils_CSLL *GenUtils_CSLLCreateWithSharedPool(
+    GenUtils_Pool *pool);
+
   /// @brief Destroy a CSLL.
   /// @param list The list to destroy.
   void GenUtils_CSLLDestroy(GenUtils_CSLL *list);
 
+  /// @brief Destroy a CSLL, calling a function with the
+  /// data of every element first.
+  /// @param list The list to destroy.
+  /// @param destructor The function that releases the data
+  /// of an element, NULL to do nothing.
+  void GenUtils_CSLLDestroyWith(
+    GenUtils_CSLL *list, void (*destructor)(void *));
+
   /// @brief Get the numbers of elements in a list.
   /// @param list The list to query.
   /// @return The number of elements in the list.
@@ -131,6 +177,62 @@ extern "C"
   /// @param list The list to clear.
   void GenUtils_CSLLClear(GenUtils_CSLL *list);
 
+  /// @brief Clear the content of a list, calling a function
+  /// with the data of every element. The nodes are released
+  /// in the same pass.
+  /// @param list The list to clear.
+  /// @param destructor The function that releases the data
+  /// of an element, NULL to do nothing.
+  void GenUtils_CSLLClearWith(
+    GenUtils_CSLL *list, void (*destructor)(void *));
+
+  /// @brief Move all the nodes of a list to the tail of
+  /// another one in constant time.
+  /// @param destination The list that receives the nodes.
+  /// @param source The list that gives the nodes, it's left
+  /// empty.
+  /// @return true in success, false if the lists are the
+  /// same or if they don't share their pool or, without a
+  /// pool, their allocator.
+  bool GenUtils_CSLLConcat(
+    GenUtils_CSLL *destination, GenUtils_CSLL *source);
+
+  /// @brief Move a range of nodes from a list to another
+  /// one in constant time.
+  /// @param destination The list that receives the nodes.
+  /// @param position The node of destination after which
+  /// the range is inserted, or NULL to insert it at the
+  /// tail.
+  /// @param source The list that gives the nodes.
+  /// @param previous The node before the range, the tail
+  /// if the range starts at the head.
+  /// @param last The last node of the range. The range goes
+  /// from the node after previous to last without passing
+  /// the tail of source.
+  /// @param count The number of nodes of the range. It's
+  /// trusted to keep the move in constant time, and only
+  /// checked with assert in debug builds.
+  /// @return true in success, false if the lists are the
+  /// same or if they don't share their pool or, without a
+  /// pool, their allocator.
+  bool GenUtils_CSLLSpliceAfter(GenUtils_CSLL *destination,
+    GenUtils_SingleNode *position, GenUtils_CSLL *source,
+    GenUtils_SingleNode *previous,
+    GenUtils_SingleNode *last, size_t count);
+
+  /// @brief Split a list, moving all the nodes after a node
+  /// to the tail of another list. The cost is the number of
+  /// nodes moved.
+  /// @param list The list to split.
+  /// @param node The node that will be the new tail of
+  /// list.
+  /// @param destination The list that receives the nodes.
+  /// @return true in success, false if the lists are the
+  /// same or if they don't share their pool or, without a
+  /// pool, their allocator.
+  bool GenUtils_CSLLSplitAfter(GenUtils_CSLL *list,
+    GenUtils_SingleNode *node, GenUtils_CSLL *destination);
+
   /// @brief Iterate through all the elements of a list.
   /// @param list The list where to be iterated.
   /// @param extradata Extradata to pass to the iterator
@@ -0,0 +1,174 @@
+/// @file Deque.h
+/// @author DP-Dev
+/// @brief Implementation of a double-ended queue.
+///
+/// The deque stores its elements in a ring buffer whose
+/// capacity is a power of two, so it can push and pop at
+/// both ends in O(1) and access any element by its index.
+/// Its functions have the same names as the CDLL ones.
+#ifndef GENUTILS_DEQUE_H
+#define GENUTILS_DEQUE_H
+#include <GenUtils/Allocator.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief An structure to represent a deque.
+  typedef struct GenUtils_Deque
+  {
+    /// @brief Ring buffer of the elements.
+    void **data;
+    /// @brief Index of the first element in the buffer.
+    size_t head;
+    /// @brief The number of elements of the deque.
+    size_t size;
+    /// @brief The number of elements that fit in the
+    /// buffer, zero or a power of two.
+    size_t capacity;
+    /// @brief Allocator of the deque and its buffer, or
+    /// NULL to use malloc.
+    const GenUtils_Allocator *allocator;
+  } GenUtils_Deque;
+
+  /// @brief Create a new deque.
+  /// @return The new deque or NULL on error.
+  GenUtils_Deque *GenUtils_DequeCreate();
+
+  /// @brief Create a new deque that takes its memory from
+  /// an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the deque is destroyed.
+  /// @return The new deque or NULL on error.
+  GenUtils_Deque *GenUtils_DequeCreateWithAllocator(
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a deque.
+  /// @param deque The deque to destroy.
+  void GenUtils_DequeDestroy(GenUtils_Deque *deque);
+
+  /// @brief Get the number of elements in a deque.
+  /// @param deque The deque to query.
+  /// @return The number of elements in the deque.
+  size_t GenUtils_DequeGetSize(GenUtils_Deque *deque);
+
+  /// @brief Check if a deque is empty.
+  /// @param deque The deque to query.
+  /// @return true if is empty.
+  bool GenUtils_DequeEmpty(GenUtils_Deque *deque);
+
+  /// @brief Check if a deque have been initialized.
+  /// @param deque The deque to query.
+  /// @return true if the deque have been initialized.
+  bool GenUtils_DequeWasInit(GenUtils_Deque *deque);
+
+  /// @brief Get the first element of a deque.
+  /// @param deque The deque to query.
+  /// @return The first element, or NULL if the deque is
+  /// empty.
+  void *GenUtils_DequeBegin(GenUtils_Deque *deque);
+
+  /// @brief Get the last element of a deque.
+  /// @param deque The deque to query.
+  /// @return The last element, or NULL if the deque is
+  /// empty.
+  void *GenUtils_DequeEnd(GenUtils_Deque *deque);
+
+  /// @brief Get an element of a deque by its index.
+  /// @param deque The deque to query.
+  /// @param index The index of the element, 0 is the first
+  /// one.
+  /// @return The element, or NULL if the index is out of
+  /// range.
+  void *GenUtils_DequeGet(
+    GenUtils_Deque *deque, size_t index);
+
+  /// @brief Replace an element of a deque by its index.
+  /// @param deque The deque to modify.
+  /// @param index The index of the element, 0 is the first
+  /// one.
+  /// @param userdata The new data of the element.
+  /// @return true in success, false if the index is out of
+  /// range.
+  bool GenUtils_DequeSet(
+    GenUtils_Deque *deque, size_t index, void *userdata);
+
+  /// @brief Insert data in the tail of a deque.
+  /// @param deque The deque where the data will be
+  /// inserted.
+  /// @param userdata The data to insert.
+  /// @return true in success, false otherwise.
+  bool GenUtils_DequePushBack(
+    GenUtils_Deque *deque, void *userdata);
+
+  /// @brief Insert data in the head of a deque.
+  /// @param deque The deque where the data will be
+  /// inserted.
+  /// @param userdata The data to insert.
+  /// @return true in success, false otherwise.
+  bool GenUtils_DequePushFront(
+    GenUtils_Deque *deque, void *userdata);
+
+  /// @brief Remove the tail of a deque and returns its
+  /// data.
+  /// @param deque The deque where the data will be removed.
+  /// @return The data at the tail of the deque.
+  void *GenUtils_DequePopBack(GenUtils_Deque *deque);
+
+  /// @brief Remove data from the tail of a deque.
+  /// @param deque The deque where the data will removed.
+  /// @return true if the operation was successfully.
+  bool GenUtils_DequePopBackBool(GenUtils_Deque *deque);
+
+  /// @brief Remove the head of a deque and returns its
+  /// data.
+  /// @param deque The deque where the data will be removed.
+  /// @return The data at the head of the deque.
+  void *GenUtils_DequePopFront(GenUtils_Deque *deque);
+
+  /// @brief Remove data from the head of a deque.
+  /// @param deque The deque where the data will be removed.
+  /// @return true if the operation was successfully.
+  bool GenUtils_DequePopFrontBool(GenUtils_Deque *deque);
+
+  /// @brief Clear the content of a deque. Its buffer is
+  /// kept.
+  /// @param deque The deque to clear.
+  void GenUtils_DequeClear(GenUtils_Deque *deque);
+
+  /// @brief Grow the buffer of a deque to hold a number of
+  /// elements.
+  /// @param deque The deque to grow.
+  /// @param capacity The number of elements to hold.
+  /// @return true in success, false otherwise.
+  bool GenUtils_DequeReserve(
+    GenUtils_Deque *deque, size_t capacity);
+
+  /// @brief Iterate through all the elements of a deque.
+  /// @param deque The deque where to be iterated.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function.
+  void GenUtils_DequeIterate(GenUtils_Deque *deque,
+    void *extradata, void (*function)(void *, void *));
+
+  /// @brief Iterate through the contiguous segments of a
+  /// deque. The elements are in at most two segments.
+  /// @param deque The deque where to be iterated.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function. It pass a
+  /// pointer to the first element of the segment, the
+  /// number of elements of the segment and extradata.
+  void GenUtils_DequeIterateSegments(GenUtils_Deque *deque,
+    void *extradata,
+    void (*function)(void **, size_t, void *));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,205 @@
+/// @file Epoch.h
+/// @author DP-Dev
+/// @brief Implementation of epoch-based memory reclamation.
+///
+/// A concurrent container can't release a node when it
+/// removes it, because other threads can still be reading
+/// it. The threads that use the container register in an
+/// epoch domain, and every access to the container happens
+/// between GenUtils_EpochEnter and GenUtils_EpochExit.
+/// Removed objects are retired with GenUtils_EpochRetire
+/// and released in batches two epochs later, when no thread
+/// can hold a pointer to them anymore. Readers only write
+/// their own epoch, so they never wait and never take a
+/// lock.
+///
+/// A thread collects its retired objects after it retires
+/// GENUTILS_EPOCH_BATCH of them, after it exits
+/// GENUTILS_EPOCH_BATCH critical sections with objects
+/// pending, and when it calls GenUtils_EpochCollect or
+/// GenUtils_EpochUnregister. Every collection also releases
+/// the safe objects left by unregistered threads. While
+/// every thread leaves its critical sections, a thread
+/// keeps at most about GENUTILS_EPOCH_BATCH objects that
+/// are retired but not released. A thread that stays in a
+/// critical section stops the epoch, and the retired
+/// objects of all the threads grow until it exits.
+///
+/// When a thread exits, the records it registered are
+/// unregistered, so another thread can take them, and the
+/// objects it retired are released by the next collections
+/// of the other threads.
+#ifndef GENUTILS_EPOCH_H
+#define GENUTILS_EPOCH_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/types.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief Number of objects retired, or of critical
+  /// sections exited with objects pending, before a thread
+  /// tries to advance the epoch.
+#define GENUTILS_EPOCH_BATCH 64
+
+  /// @brief A retired object, embedded in the objects of a
+  /// container.
+  typedef struct GenUtils_EpochEntry
+  {
+    /// @brief The next retired object.
+    struct GenUtils_EpochEntry *next;
+    /// @brief The function that releases the object.
+    void (*release)(struct GenUtils_EpochEntry *, void *);
+    /// @brief Extradata to pass to the function.
+    void *extradata;
+  } GenUtils_EpochEntry;
+
+  /// @brief A thread registered in an epoch domain.
+  typedef struct GenUtils_EpochThread
+  {
+    /// @brief The epoch observed by the thread, shifted one
+    /// bit, with the lowest bit set inside a critical
+    /// section. 0 outside of it.
+    _Atomic uint64_t local;
+    /// @brief true while a thread uses the record.
+    _Atomic bool used;
+    /// @brief The thread that uses the record.
+    _Atomic(const void *) owner;
+    /// @brief The number of nested critical sections.
+    size_t nesting;
+    /// @brief Critical sections exited since the last
+    /// collection.
+    size_t exits;
+    /// @brief The number of objects waiting to be released.
+    size_t retiredCount;
+    /// @brief The objects retired in the last three epochs.
+    GenUtils_EpochEntry *retired[3];
+    /// @brief The epoch of every list of retired objects.
+    uint64_t retiredEpoch[3];
+    /// @brief The domain of the thread.
+    struct GenUtils_Epoch *epoch;
+    /// @brief The next registered thread.
+    struct GenUtils_EpochThread *next;
+    /// @brief The next record of the owner thread.
+    struct GenUtils_EpochThread *ownerNext;
+    /// @brief The link to the record in the records of the
+    /// owner thread, or NULL if it's not there.
+    struct GenUtils_EpochThread **ownerPrevious;
+    /// @brief Padding to keep other threads out of the
+    /// cache line.
+    char padding[GENUTILS_CACHE_LINE];
+  } GenUtils_EpochThread;
+
+  /// @brief An structure to represent an epoch domain.
+  typedef struct GenUtils_Epoch
+  {
+    /// @brief The global epoch.
+    _Atomic uint64_t global;
+    /// @brief Padding to keep the global epoch on its own
+    /// cache line.
+    char padding[GENUTILS_CACHE_LINE];
+    /// @brief The registered threads.
+    _Atomic(GenUtils_EpochThread *) threads;
+    /// @brief Number that tells apart the domains created
+    /// at the same address.
+    uint64_t id;
+    /// @brief Allocator of the domain and its threads, or
+    /// NULL to use malloc. It must be thread-safe.
+    const GenUtils_Allocator *allocator;
+  } GenUtils_Epoch;
+
+  /// @brief Create a new epoch domain.
+  /// @return The new domain or NULL on error.
+  GenUtils_Epoch *GenUtils_EpochCreate();
+
+  /// @brief Create a new epoch domain that takes its
+  /// memory from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It's called by several threads at the same
+  /// time, so it must be thread-safe. It must be valid
+  /// until the domain is destroyed.
+  /// @return The new domain or NULL on error.
+  GenUtils_Epoch *GenUtils_EpochCreateWithAllocator(
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy an epoch domain, releasing all the
+  /// retired objects. No thread can be in a critical
+  /// section.
+  /// @param epoch The domain to destroy.
+  void GenUtils_EpochDestroy(GenUtils_Epoch *epoch);
+
+  /// @brief Check if an epoch domain have been
+  /// initialized.
+  /// @param epoch The domain to query.
+  /// @return true if the domain have been initialized.
+  bool GenUtils_EpochWasInit(GenUtils_Epoch *epoch);
+
+  /// @brief Register the calling thread in an epoch domain.
+  /// @param epoch The domain where the thread will be
+  /// registered.
+  /// @return The record of the thread, or NULL on error.
+  GenUtils_EpochThread *GenUtils_EpochRegister(
+    GenUtils_Epoch *epoch);
+
+  /// @brief Unregister a thread, collecting its retired
+  /// objects first. The objects that are not safe yet are
+  /// released by the next collection of another thread, or
+  /// by the thread that takes its record.
+  /// @param thread The record of the thread, outside of any
+  /// critical section.
+  void GenUtils_EpochUnregister(
+    GenUtils_EpochThread *thread);
+
+  /// @brief Get the record of the calling thread in an
+  /// epoch domain, registering it the first time.
+  /// @param epoch The domain to query.
+  /// @return The record of the thread, or NULL on error.
+  GenUtils_EpochThread *GenUtils_EpochGetThread(
+    GenUtils_Epoch *epoch);
+
+  /// @brief Enter a critical section. The objects read
+  /// inside it are not released until it's exited. Critical
+  /// sections can be nested.
+  /// @param thread The record of the calling thread.
+  void GenUtils_EpochEnter(GenUtils_EpochThread *thread);
+
+  /// @brief Exit a critical section.
+  /// @param thread The record of the calling thread.
+  void GenUtils_EpochExit(GenUtils_EpochThread *thread);
+
+  /// @brief Retire an object that is no longer reachable,
+  /// releasing it when no thread can hold a pointer to it.
+  /// @param thread The record of the calling thread, inside
+  /// a critical section.
+  /// @param entry The entry embedded in the object.
+  /// @param release The function that releases the object.
+  /// It's called with the entry and extradata.
+  /// @param extradata Extradata to pass to the function.
+  void GenUtils_EpochRetire(GenUtils_EpochThread *thread,
+    GenUtils_EpochEntry *entry,
+    void (*release)(GenUtils_EpochEntry *, void *),
+    void *extradata);
+
+  /// @brief Try to advance the epoch twice and release the
+  /// objects that are safe to release, retired by a thread
+  /// or left by the unregistered threads. With no thread in
+  /// a critical section, it releases all of them.
+  /// @param thread The record of the calling thread.
+  void GenUtils_EpochCollect(GenUtils_EpochThread *thread);
+
+  /// @brief Release the objects retired by all the threads.
+  /// No thread can be in a critical section.
+  /// @param epoch The domain to flush.
+  void GenUtils_EpochFlush(GenUtils_Epoch *epoch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
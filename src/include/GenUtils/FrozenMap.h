@@ -0,0 +1,140 @@
+/// @file FrozenMap.h
+/// @author DP-Dev
+/// @brief Implementation of a frozen map.
+///
+/// The frozen map is a read-only ordered map made from a
+/// binary tree. The elements are stored in a single array
+/// in the order of a breadth-first traversal of a complete
+/// tree (Eytzinger layout), so the first levels of every
+/// search share a few cache lines and the children of an
+/// element are always at 2i and 2i + 1. Every element has
+/// the first GENUTILS_FROZEN_MAP_PREFIX_SIZE bytes of its
+/// key packed in big-endian order in a separate array, so
+/// most comparisons are one integer comparison, and the
+/// search loop has no branch that depends on it. The
+/// prefixes of the descendants some levels below are
+/// prefetched while the current level is compared. Nothing
+/// is changed after the creation, so any number of threads
+/// can read the map at the same time. The keys are not
+/// copied.
+#ifndef GENUTILS_FROZEN_MAP_H
+#define GENUTILS_FROZEN_MAP_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/BinaryTree.h>
+#include <GenUtils/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief Number of bytes of the key prefixes.
+#define GENUTILS_FROZEN_MAP_PREFIX_SIZE 8
+
+  /// @brief Number of levels below the current one whose
+  /// prefixes are prefetched.
+#define GENUTILS_FROZEN_MAP_PREFETCH_LEVELS 4
+
+  /// @brief An structure to represent a frozen map.
+  typedef struct GenUtils_FrozenMap
+  {
+    /// @brief The key prefixes in Eytzinger order. The
+    /// first element is at index 1.
+    uint64_t *prefixes;
+    /// @brief The key/value pairs, in the same order as the
+    /// prefixes.
+    GenUtils_BinaryTreeKeyValue *keyValues;
+    /// @brief The number of elements of the map.
+    size_t size;
+    /// @brief The block that holds the arrays.
+    void *block;
+    /// @brief The size of the block.
+    size_t blockSize;
+    /// @brief Allocator of the map, or NULL to use malloc.
+    const GenUtils_Allocator *allocator;
+  } GenUtils_FrozenMap;
+
+  /// @brief Create a frozen map with the content of a
+  /// binary tree.
+  /// @param binaryTree The tree to copy. It's not modified,
+  /// and it can be changed after the call. If it copies
+  /// its keys to an arena, the map uses those keys, so the
+  /// tree can't be balanced, cleared or destroyed while the
+  /// map is used.
+  /// @return The new frozen map or NULL on error.
+  GenUtils_FrozenMap *GenUtils_FrozenMapCreate(
+    GenUtils_BinaryTree *binaryTree);
+
+  /// @brief Create a frozen map with the content of a
+  /// binary tree, that takes its memory from an allocator.
+  /// @param binaryTree The tree to copy. It's not modified,
+  /// and it can be changed after the call. If it copies
+  /// its keys to an arena, the map uses those keys, so the
+  /// tree can't be balanced, cleared or destroyed while the
+  /// map is used.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the map is destroyed.
+  /// @return The new frozen map or NULL on error.
+  GenUtils_FrozenMap *GenUtils_FrozenMapCreateWithAllocator(
+    GenUtils_BinaryTree *binaryTree,
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a frozen map.
+  /// @param frozenMap The frozen map to destroy.
+  void GenUtils_FrozenMapDestroy(
+    GenUtils_FrozenMap *frozenMap);
+
+  /// @brief Check if a frozen map have been initialized.
+  /// @param frozenMap The frozen map to query.
+  /// @return true if the frozen map have been initialized.
+  bool GenUtils_FrozenMapWasInit(
+    GenUtils_FrozenMap *frozenMap);
+
+  /// @brief Get the number of elements in a frozen map.
+  /// @param frozenMap The frozen map to query.
+  /// @return The number of elements in the frozen map.
+  size_t GenUtils_FrozenMapGetSize(
+    GenUtils_FrozenMap *frozenMap);
+
+  /// @brief Check if a frozen map is empty.
+  /// @param frozenMap The frozen map to query.
+  /// @return true if is empty.
+  bool GenUtils_FrozenMapEmpty(
+    GenUtils_FrozenMap *frozenMap);
+
+  /// @brief Checks if a key exists.
+  /// @param frozenMap The frozen map to search in.
+  /// @param key The key to search for.
+  /// @return true if the key exists.
+  bool GenUtils_FrozenMapExist(
+    GenUtils_FrozenMap *frozenMap, const char *key);
+
+  /// @brief Get the value of a key in a frozen map.
+  /// @param frozenMap The frozen map where the key will be
+  /// searched.
+  /// @param key The key associated with the value.
+  /// @return The value associated with the key, or NULL on
+  /// error.
+  void *GenUtils_FrozenMapGet(
+    GenUtils_FrozenMap *frozenMap, const char *key);
+
+  /// @brief Iterate through all the elements of a frozen
+  /// map in order.
+  /// @param frozenMap The frozen map to iterate.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function. It pass a
+  /// pointer to key/value pair and extradata.
+  void GenUtils_FrozenMapInorder(
+    GenUtils_FrozenMap *frozenMap, void *extradata,
+    void (*function)(
+      const GenUtils_BinaryTreeKeyValue *, void *));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+/// @file HashMap.h
+/// @author DP-Dev
+/// @brief Implementation of a hash map.
+///
+/// The map uses open addressing. Every slot has a control
+/// byte, and the bytes are scanned in groups of
+/// GENUTILS_HASH_MAP_GROUP_WIDTH with SSE2 when available,
+/// so a lookup usually reads one group and one slot. The
+/// slots keep the hash of their key, so strcmp is only
+/// called when the hashes are equal. The keys are not
+/// copied, and the functions have the same meaning as the
+/// ones of the binary tree.
+#ifndef GENUTILS_HASH_MAP_H
+#define GENUTILS_HASH_MAP_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/BinaryTree.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief Number of control bytes scanned at once.
+#define GENUTILS_HASH_MAP_GROUP_WIDTH 16
+
+  /// @brief A slot of a hash map.
+  typedef struct GenUtils_HashMapSlot
+  {
+    /// @brief The key/value pair of the slot.
+    GenUtils_BinaryTreeKeyValue keyValue;
+    /// @brief The hash of the key.
+    size_t hash;
+  } GenUtils_HashMapSlot;
+
+  /// @brief An structure to represent a hash map.
+  typedef struct GenUtils_HashMap
+  {
+    /// @brief The slots, followed in the same block by the
+    /// control bytes.
+    GenUtils_HashMapSlot *slots;
+    /// @brief A control byte per slot, and a copy of the
+    /// first group at the end.
+    uint8_t *control;
+    /// @brief The number of elements of the map.
+    size_t size;
+    /// @brief The number of slots, zero or a power of two.
+    size_t capacity;
+    /// @brief Number of empty slots that can be filled
+    /// before the map grows.
+    size_t growthLeft;
+    /// @brief Allocator of the map and its slots, or NULL
+    /// to use malloc.
+    const GenUtils_Allocator *allocator;
+  } GenUtils_HashMap;
+
+  /// @brief Create a new hash map.
+  /// @return The new hash map or NULL on error.
+  GenUtils_HashMap *GenUtils_HashMapCreate();
+
+  /// @brief Create a new hash map that takes its memory
+  /// from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the map is destroyed.
+  /// @return The new hash map or NULL on error.
+  GenUtils_HashMap *GenUtils_HashMapCreateWithAllocator(
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a hash map.
+  /// @param hashMap The hash map to destroy.
+  void GenUtils_HashMapDestroy(GenUtils_HashMap *hashMap);
+
+  /// @brief Check if a hash map have been initialized.
+  /// @param hashMap The hash map to query.
+  /// @return true if the hash map have been initialized.
+  bool GenUtils_HashMapWasInit(GenUtils_HashMap *hashMap);
+
+  /// @brief Get the number of elements in a hash map.
+  /// @param hashMap The hash map to query.
+  /// @return The number of elements in the hash map.
+  size_t GenUtils_HashMapGetSize(GenUtils_HashMap *hashMap);
+
+  /// @brief Check if a hash map is empty.
+  /// @param hashMap The hash map to query.
+  /// @return true if is empty.
+  bool GenUtils_HashMapEmpty(GenUtils_HashMap *hashMap);
+
+  /// @brief Get the number of slots of a hash map.
+  /// @param hashMap The hash map to query.
+  /// @return The number of slots.
+  size_t GenUtils_HashMapGetCapacity(
+    GenUtils_HashMap *hashMap);
+
+  /// @brief Checks if a key exists.
+  /// @param hashMap The hash map to search in.
+  /// @param key The key to search for.
+  /// @return true if the key already exists.
+  bool GenUtils_HashMapExist(
+    GenUtils_HashMap *hashMap, const char *key);
+
+  /// @brief Get the value of a key in a hash map.
+  /// @param hashMap The hash map where the key will be
+  /// searched.
+  /// @param key The key associated with the value.
+  /// @return The value associated with the key, or NULL on
+  /// error.
+  void *GenUtils_HashMapGet(
+    GenUtils_HashMap *hashMap, const char *key);
+
+  /// @brief Set the value of an existing key.
+  /// @param hashMap The hash map to modify.
+  /// @param keyValue The key to modify and the value to
+  /// insert.
+  /// @return true in success, false if the key doesn't
+  /// exist.
+  bool GenUtils_HashMapSet(GenUtils_HashMap *hashMap,
+    GenUtils_BinaryTreeKeyValue keyValue);
+
+  /// @brief Insert a key/value pair in a hash map.
+  /// @param hashMap The hash map where data will be
+  /// inserted.
+  /// @param keyValue Pair key value to insert. NULL in data
+  /// is allowed. The key must be valid while it's in the
+  /// map.
+  /// @return true in success, false on error or if the key
+  /// already exists.
+  bool GenUtils_HashMapInsert(GenUtils_HashMap *hashMap,
+    GenUtils_BinaryTreeKeyValue keyValue);
+
+  /// @brief Remove a pair from a hash map and return its
+  /// value.
+  /// @param hashMap The hash map where the pair will be
+  /// deleted.
+  /// @param key The ID of the element to remove.
+  /// @return The value of the pair.
+  void *GenUtils_HashMapRemove(
+    GenUtils_HashMap *hashMap, const char *key);
+
+  /// @brief Remove a pair from a hash map.
+  /// @param hashMap The hash map where the pair will be
+  /// deleted.
+  /// @param key The ID of the element to remove.
+  /// @return true if the pair was removed.
+  bool GenUtils_HashMapRemoveBool(
+    GenUtils_HashMap *hashMap, const char *key);
+
+  /// @brief Grow a hash map to hold a number of elements
+  /// without rehashing.
+  /// @param hashMap The hash map to grow.
+  /// @param count The number of elements to hold.
+  /// @return true in success, false otherwise.
+  bool GenUtils_HashMapReserve(
+    GenUtils_HashMap *hashMap, size_t count);
+
+  /// @brief Move the elements of a hash map to new slots,
+  /// dropping the removed slots. The map can shrink.
+  /// @param hashMap The hash map to rehash.
+  /// @param count The number of elements the new slots must
+  /// hold, at least the size of the map.
+  /// @return true in success, false otherwise.
+  bool GenUtils_HashMapRehash(
+    GenUtils_HashMap *hashMap, size_t count);
+
+  /// @brief Clear the content of a hash map. Its slots are
+  /// kept.
+  /// @param hashMap The hash map to clear.
+  void GenUtils_HashMapClear(GenUtils_HashMap *hashMap);
+
+  /// @brief Iterate through all the elements of a hash map
+  /// in no specific order.
+  /// @param hashMap The hash map where to be iterated.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function. It pass a
+  /// pointer to key/value pair and extradata
+  void GenUtils_HashMapIterate(GenUtils_HashMap *hashMap,
+    void *extradata,
+    void (*function)(
+      const GenUtils_BinaryTreeKeyValue *, void *));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,147 @@
+/// @file ICDLL.h
+/// @author DP-Dev
+/// @brief Implementation of an intrusive CDLL.
+///
+/// The objects of the list embed a GenUtils_DoubleLink, and
+/// GENUTILS_CONTAINER_OF gets the object back from its
+/// link. The list never allocates memory, so pushing,
+/// inserting and removing can't fail. A link can be in only
+/// one list at a time. A list filled with zeros is a valid
+/// empty list.
+#ifndef GENUTILS_ICDLL_H
+#define GENUTILS_ICDLL_H
+#include <GenUtils/types.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief An structure to represent an intrusive CDLL.
+  typedef struct GenUtils_ICDLL
+  {
+    /// @brief Head of the list, its previous link is the
+    /// tail.
+    GenUtils_DoubleLink *head;
+    /// @brief The number of elements in the list.
+    size_t size;
+  } GenUtils_ICDLL;
+
+  /// @brief Initialize an empty intrusive CDLL.
+  /// @param list The list to initialize.
+  void GenUtils_ICDLLInit(GenUtils_ICDLL *list);
+
+  /// @brief Get the number of elements in a list.
+  /// @param list The list to query.
+  /// @return The number of elements in the list.
+  size_t GenUtils_ICDLLGetSize(GenUtils_ICDLL *list);
+
+  /// @brief Check if a list is empty.
+  /// @param list The list to query.
+  /// @return true if is empty.
+  bool GenUtils_ICDLLEmpty(GenUtils_ICDLL *list);
+
+  /// @brief Check if a list have been initialized.
+  /// @param list The list to query.
+  /// @return true if the list have been initialized.
+  bool GenUtils_ICDLLWasInit(GenUtils_ICDLL *list);
+
+  /// @brief Get the first link in the list.
+  /// @param list The list to query.
+  /// @return The head link or NULL if the list is empty.
+  GenUtils_DoubleLink *GenUtils_ICDLLBegin(
+    GenUtils_ICDLL *list);
+
+  /// @brief Get the last link in the list.
+  /// @param list The list to query.
+  /// @return The tail link or NULL if the list is empty.
+  GenUtils_DoubleLink *GenUtils_ICDLLEnd(
+    GenUtils_ICDLL *list);
+
+  /// @brief Get the link after another one.
+  /// @param list The list of the link.
+  /// @param link The current link.
+  /// @return The next link, or NULL after the tail.
+  GenUtils_DoubleLink *GenUtils_ICDLLNext(
+    GenUtils_ICDLL *list, GenUtils_DoubleLink *link);
+
+  /// @brief Get the link before another one.
+  /// @param list The list of the link.
+  /// @param link The current link.
+  /// @return The previous link, or NULL before the head.
+  GenUtils_DoubleLink *GenUtils_ICDLLPrevious(
+    GenUtils_ICDLL *list, GenUtils_DoubleLink *link);
+
+  /// @brief Insert a link before another one.
+  /// @param list The list where the link will be inserted.
+  /// @param position A link of the list. It's ignored if
+  /// the list is empty.
+  /// @param link The link to insert.
+  void GenUtils_ICDLLInsert(GenUtils_ICDLL *list,
+    GenUtils_DoubleLink *position,
+    GenUtils_DoubleLink *link);
+
+  /// @brief Insert a link after another one.
+  /// @param list The list where the link will be inserted.
+  /// @param position A link of the list. It's ignored if
+  /// the list is empty.
+  /// @param link The link to insert.
+  void GenUtils_ICDLLInsertAfter(GenUtils_ICDLL *list,
+    GenUtils_DoubleLink *position,
+    GenUtils_DoubleLink *link);
+
+  /// @brief Remove a link from a list.
+  /// @param list The list where the link will be removed.
+  /// @param link The link to remove, it must be in the
+  /// list.
+  void GenUtils_ICDLLRemove(
+    GenUtils_ICDLL *list, GenUtils_DoubleLink *link);
+
+  /// @brief Insert a link in the tail of a list.
+  /// @param list The list where the link will be inserted.
+  /// @param link The link to insert.
+  void GenUtils_ICDLLPushBack(
+    GenUtils_ICDLL *list, GenUtils_DoubleLink *link);
+
+  /// @brief Insert a link in the head of a list.
+  /// @param list The list where the link will be inserted.
+  /// @param link The link to insert.
+  void GenUtils_ICDLLPushFront(
+    GenUtils_ICDLL *list, GenUtils_DoubleLink *link);
+
+  /// @brief Remove the tail of a list.
+  /// @param list The list where the link will be removed.
+  /// @return The removed link, or NULL if the list is
+  /// empty.
+  GenUtils_DoubleLink *GenUtils_ICDLLPopBack(
+    GenUtils_ICDLL *list);
+
+  /// @brief Remove the head of a list.
+  /// @param list The list where the link will be removed.
+  /// @return The removed link, or NULL if the list is
+  /// empty.
+  GenUtils_DoubleLink *GenUtils_ICDLLPopFront(
+    GenUtils_ICDLL *list);
+
+  /// @brief Remove all the links of a list. The objects
+  /// are not touched.
+  /// @param list The list to clear.
+  void GenUtils_ICDLLClear(GenUtils_ICDLL *list);
+
+  /// @brief Iterate through all the links of a list. The
+  /// function can release the object of the current link.
+  /// @param list The list where to be iterated.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function.
+  void GenUtils_ICDLLIterate(GenUtils_ICDLL *list,
+    void *extradata,
+    void (*function)(GenUtils_DoubleLink *, void *));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,145 @@
+/// @file ICSLL.h
+/// @author DP-Dev
+/// @brief Implementation of an intrusive CSLL.
+///
+/// The objects of the list embed a GenUtils_SingleLink, and
+/// GENUTILS_CONTAINER_OF gets the object back from its
+/// link. The list never allocates memory, so pushing and
+/// inserting can't fail. A link can be in only one list at
+/// a time. A list filled with zeros is a valid empty list.
+#ifndef GENUTILS_ICSLL_H
+#define GENUTILS_ICSLL_H
+#include <GenUtils/types.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief An structure to represent an intrusive CSLL.
+  typedef struct GenUtils_ICSLL
+  {
+    /// @brief Head of the list.
+    GenUtils_SingleLink *head;
+    /// @brief Tail of the list.
+    GenUtils_SingleLink *tail;
+    /// @brief The number of elements in the list.
+    size_t size;
+  } GenUtils_ICSLL;
+
+  /// @brief Initialize an empty intrusive CSLL.
+  /// @param list The list to initialize.
+  void GenUtils_ICSLLInit(GenUtils_ICSLL *list);
+
+  /// @brief Get the number of elements in a list.
+  /// @param list The list to query.
+  /// @return The number of elements in the list.
+  size_t GenUtils_ICSLLGetSize(GenUtils_ICSLL *list);
+
+  /// @brief Check if a list is empty.
+  /// @param list The list to query.
+  /// @return true if is empty.
+  bool GenUtils_ICSLLEmpty(GenUtils_ICSLL *list);
+
+  /// @brief Check if a list have been initialized.
+  /// @param list The list to query.
+  /// @return true if the list have been initialized.
+  bool GenUtils_ICSLLWasInit(GenUtils_ICSLL *list);
+
+  /// @brief Get the first link in the list.
+  /// @param list The list to query.
+  /// @return The head link or NULL if the list is empty.
+  GenUtils_SingleLink *GenUtils_ICSLLBegin(
+    GenUtils_ICSLL *list);
+
+  /// @brief Get the last link in the list.
+  /// @param list The list to query.
+  /// @return The tail link or NULL if the list is empty.
+  GenUtils_SingleLink *GenUtils_ICSLLEnd(
+    GenUtils_ICSLL *list);
+
+  /// @brief Get the link after another one.
+  /// @param list The list of the link.
+  /// @param link The current link.
+  /// @return The next link, or NULL after the tail.
+  GenUtils_SingleLink *GenUtils_ICSLLNext(
+    GenUtils_ICSLL *list, GenUtils_SingleLink *link);
+
+  /// @brief Insert a link after another one.
+  /// @param list The list where the link will be inserted.
+  /// @param position A link of the list. It's ignored if
+  /// the list is empty.
+  /// @param link The link to insert.
+  void GenUtils_ICSLLInsertAfter(GenUtils_ICSLL *list,
+    GenUtils_SingleLink *position,
+    GenUtils_SingleLink *link);
+
+  /// @brief Remove a link from a list.
+  /// @param list The list where the link will be removed.
+  /// @param link The link to remove.
+  /// @return true if the link was removed, false if it
+  /// isn't in the list.
+  ///
+  /// Warning: This operation is slow in this type of list.
+  /// Use ICDLL list type instead.
+  bool GenUtils_ICSLLRemove(
+    GenUtils_ICSLL *list, GenUtils_SingleLink *link);
+
+  /// @brief Remove the link after another one.
+  /// @param list The list where the link will be removed.
+  /// @param position The link taken as reference.
+  /// @return The removed link, or NULL if the list is
+  /// empty. The link after the tail is the head.
+  GenUtils_SingleLink *GenUtils_ICSLLRemoveAfter(
+    GenUtils_ICSLL *list, GenUtils_SingleLink *position);
+
+  /// @brief Insert a link in the tail of a list.
+  /// @param list The list where the link will be inserted.
+  /// @param link The link to insert.
+  void GenUtils_ICSLLPushBack(
+    GenUtils_ICSLL *list, GenUtils_SingleLink *link);
+
+  /// @brief Insert a link in the head of a list.
+  /// @param list The list where the link will be inserted.
+  /// @param link The link to insert.
+  void GenUtils_ICSLLPushFront(
+    GenUtils_ICSLL *list, GenUtils_SingleLink *link);
+
+  /// @brief Remove the tail of a list.
+  /// @param list The list where the link will be removed.
+  /// @return The removed link, or NULL if the list is
+  /// empty.
+  ///
+  /// Warning: This operation is slow in this type of list.
+  GenUtils_SingleLink *GenUtils_ICSLLPopBack(
+    GenUtils_ICSLL *list);
+
+  /// @brief Remove the head of a list.
+  /// @param list The list where the link will be removed.
+  /// @return The removed link, or NULL if the list is
+  /// empty.
+  GenUtils_SingleLink *GenUtils_ICSLLPopFront(
+    GenUtils_ICSLL *list);
+
+  /// @brief Remove all the links of a list. The objects
+  /// are not touched.
+  /// @param list The list to clear.
+  void GenUtils_ICSLLClear(GenUtils_ICSLL *list);
+
+  /// @brief Iterate through all the links of a list. The
+  /// function can release the object of the current link.
+  /// @param list The list where to be iterated.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function.
+  void GenUtils_ICSLLIterate(GenUtils_ICSLL *list,
+    void *extradata,
+    void (*function)(GenUtils_SingleLink *, void *));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,156 @@
+/// @file MPSCQueue.h
+/// @author DP-Dev
+/// @brief Implementation of a lock-free multiple producer
+/// single consumer queue.
+///
+/// The queue is an intrusive linked list of
+/// GenUtils_SingleNode with a stub node. Any number of
+/// threads can push at the same time, and every push is a
+/// single atomic exchange, so it never waits for other
+/// threads. Only one thread at a time can pop. A pop can
+/// return NULL while a producer is in the middle of a push,
+/// the element is returned by a later pop.
+#ifndef GENUTILS_MPSC_QUEUE_H
+#define GENUTILS_MPSC_QUEUE_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/types.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief An structure to represent a MPSC queue.
+  typedef struct GenUtils_MPSCQueue
+  {
+    /// @brief The last node pushed, updated by producers.
+    _Atomic(GenUtils_SingleNode *) head;
+    /// @brief Padding to move the consumer data to another
+    /// cache line.
+    char padding[GENUTILS_CACHE_LINE];
+    /// @brief The next node to pop, used by the consumer.
+    GenUtils_SingleNode *tail;
+    /// @brief If the tail was made by Push.
+    bool owned;
+    /// @brief Node that keeps the list non-empty.
+    GenUtils_SingleNode stub;
+    /// @brief Allocator of the queue and the nodes made by
+    /// Push, or NULL to use malloc. It must be thread-safe.
+    const GenUtils_Allocator *allocator;
+  } GenUtils_MPSCQueue;
+
+  /// @brief Create a new MPSC queue.
+  /// @return The new queue or NULL on error.
+  GenUtils_MPSCQueue *GenUtils_MPSCQueueCreate();
+
+  /// @brief Create a new MPSC queue that takes its memory
+  /// from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It's called by the producers at the same time,
+  /// so it must be thread-safe. It must be valid until the
+  /// queue is destroyed.
+  /// @return The new queue or NULL on error.
+  GenUtils_MPSCQueue *GenUtils_MPSCQueueCreateWithAllocator(
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a MPSC queue. The nodes made by Push
+  /// that are still in the queue are released with its
+  /// allocator, nodes pushed with PushNode are left to the
+  /// caller. No thread can use the queue at the same time.
+  /// @param queue The queue to destroy.
+  void GenUtils_MPSCQueueDestroy(GenUtils_MPSCQueue *queue);
+
+  /// @brief Check if a queue have been initialized.
+  /// @param queue The queue to query.
+  /// @return true if the queue have been initialized.
+  bool GenUtils_MPSCQueueWasInit(GenUtils_MPSCQueue *queue);
+
+  /// @brief Check if a queue is empty. Only the consumer
+  /// can call it.
+  /// @param queue The queue to query.
+  /// @return true if there is nothing to pop.
+  bool GenUtils_MPSCQueueEmpty(GenUtils_MPSCQueue *queue);
+
+  /// @brief Push a node owned by the caller. It never
+  /// fails and never waits.
+  /// @param queue The queue where the node will be pushed.
+  /// @param node The node to push. It can come from a pool
+  /// or be embedded in another object, and it must be valid
+  /// until it's popped.
+  void GenUtils_MPSCQueuePushNode(
+    GenUtils_MPSCQueue *queue, GenUtils_SingleNode *node);
+
+  /// @brief Push data in a new node taken from the
+  /// allocator of the queue.
+  /// @param queue The queue where the data will be pushed.
+  /// @param userdata The data to push.
+  /// @return true in success, false otherwise.
+  bool GenUtils_MPSCQueuePush(
+    GenUtils_MPSCQueue *queue, void *userdata);
+
+  /// @brief Pop the oldest node of a queue. Only the
+  /// consumer can call it.
+  /// @param queue The queue where the node will be popped.
+  /// @param owned Where to store true if the node was made
+  /// by Push, or NULL if every node was pushed with
+  /// PushNode. A node made by Push must be released with
+  /// the allocator of the queue.
+  /// @return The node, owned again by the caller, or NULL
+  /// if there is nothing to pop.
+  GenUtils_SingleNode *GenUtils_MPSCQueuePopNode(
+    GenUtils_MPSCQueue *queue, bool *owned);
+
+  /// @brief Pop the oldest data of a queue, releasing its
+  /// node if it was made by Push. A node pushed with
+  /// PushNode is popped but not released. Only the consumer
+  /// can call it.
+  /// @param queue The queue where the data will be popped.
+  /// @return The data, or NULL if there is nothing to pop.
+  void *GenUtils_MPSCQueuePop(GenUtils_MPSCQueue *queue);
+
+  /// @brief Pop the oldest data of a queue, releasing its
+  /// node if it was made by Push. A node pushed with
+  /// PushNode is popped but not released. Only the consumer
+  /// can call it.
+  /// @param queue The queue where the data will be popped.
+  /// @return true if there was data to pop.
+  bool GenUtils_MPSCQueuePopBool(GenUtils_MPSCQueue *queue);
+
+  /// @brief Pop a batch of nodes. Only the consumer can
+  /// call it.
+  /// @param queue The queue where the nodes will be popped.
+  /// @param nodes Array where the nodes are stored, oldest
+  /// first.
+  /// @param owned Array where true is stored for every node
+  /// made by Push, or NULL if every node was pushed with
+  /// PushNode. The nodes made by Push must be released with
+  /// the allocator of the queue.
+  /// @param maxCount The size of the arrays.
+  /// @return The number of nodes popped.
+  size_t GenUtils_MPSCQueueDrainNodes(
+    GenUtils_MPSCQueue *queue, GenUtils_SingleNode **nodes,
+    bool *owned, size_t maxCount);
+
+  /// @brief Pop a batch of data, calling a function with
+  /// every element and releasing its node if it was made by
+  /// Push. Nodes pushed with PushNode are popped but not
+  /// released. Only the consumer can call it.
+  /// @param queue The queue where the data will be popped.
+  /// @param maxCount The maximum number of elements to pop,
+  /// 0 to pop until the queue is empty.
+  /// @param extradata Extradata to pass to the function.
+  /// @param function The function called with every
+  /// element.
+  /// @return The number of elements popped.
+  size_t GenUtils_MPSCQueueDrain(GenUtils_MPSCQueue *queue,
+    size_t maxCount, void *extradata,
+    void (*function)(void *, void *));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+/// @file PersistentTree.h
+/// @author DP-Dev
+/// @brief Implementation of a persistent binary tree.
+///
+/// The persistent tree is an AVL tree whose nodes are never
+/// modified once they're linked. Insertions, removals and
+/// sets copy the nodes from the root to the changed node,
+/// and the copies share the other subtrees with the old
+/// version through reference counts, so every change
+/// allocates O(log n) nodes. A snapshot is a new tree that
+/// shares the root of another one, so it's made in O(1),
+/// and both trees can be changed independently after it.
+/// The keys are not copied, and the functions have the same
+/// meaning as the ones of the binary tree.
+#ifndef GENUTILS_PERSISTENT_TREE_H
+#define GENUTILS_PERSISTENT_TREE_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/BinaryTree.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief A node of a persistent tree, defined in
+  /// PersistentTree.c.
+  typedef struct GenUtils_PersistentTreeNode
+    GenUtils_PersistentTreeNode;
+
+  /// @brief An structure to represent a persistent tree.
+  typedef struct GenUtils_PersistentTree
+  {
+    /// @brief Root node of the tree.
+    GenUtils_PersistentTreeNode *root;
+    /// @brief The number of elements of the tree.
+    size_t size;
+    /// @brief Allocator of the tree and its nodes, or NULL
+    /// to use malloc. It's shared with the snapshots.
+    const GenUtils_Allocator *allocator;
+  } GenUtils_PersistentTree;
+
+  /// @brief Create a new persistent tree.
+  /// @return The new tree or NULL on error.
+  GenUtils_PersistentTree *GenUtils_PersistentTreeCreate();
+
+  /// @brief Create a new persistent tree that takes the
+  /// memory of the tree and its nodes from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the tree and all its
+  /// snapshots are destroyed, and thread-safe if they're
+  /// used by different threads.
+  /// @return The new tree or NULL on error.
+  GenUtils_PersistentTree *
+    GenUtils_PersistentTreeCreateWithAllocator(
+      const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a persistent tree. The nodes shared
+  /// with its snapshots are kept until the last of them is
+  /// destroyed.
+  /// @param tree The tree to destroy.
+  void GenUtils_PersistentTreeDestroy(
+    GenUtils_PersistentTree *tree);
+
+  /// @brief Check if a persistent tree have been
+  /// initialized.
+  /// @param tree The tree to query.
+  /// @return true if the tree have been initialized.
+  bool GenUtils_PersistentTreeWasInit(
+    GenUtils_PersistentTree *tree);
+
+  /// @brief Get the number of elements in a persistent
+  /// tree.
+  /// @param tree The tree to query.
+  /// @return The number of elements in the tree.
+  size_t GenUtils_PersistentTreeGetSize(
+    GenUtils_PersistentTree *tree);
+
+  /// @brief Check if a persistent tree is empty.
+  /// @param tree The tree to query.
+  /// @return true if is empty.
+  bool GenUtils_PersistentTreeEmpty(
+    GenUtils_PersistentTree *tree);
+
+  /// @brief Checks if a key exists.
+  /// @param tree The tree to search in.
+  /// @param key The key to search for.
+  /// @return true if the key exists.
+  bool GenUtils_PersistentTreeExist(
+    GenUtils_PersistentTree *tree, const char *key);
+
+  /// @brief Get the value of a key in a persistent tree.
+  /// @param tree The tree where the key will be searched.
+  /// @param key The key associated with the value.
+  /// @return The value associated with the key, or NULL on
+  /// error.
+  void *GenUtils_PersistentTreeGet(
+    GenUtils_PersistentTree *tree, const char *key);
+
+  /// @brief Set the value of a key. The snapshots keep the
+  /// old value.
+  /// @param tree The tree to modify.
+  /// @param keyValue The key to modify and the value to
+  /// set.
+  /// @return true in success, false if the key doesn't
+  /// exist or on error.
+  bool GenUtils_PersistentTreeSet(
+    GenUtils_PersistentTree *tree,
+    GenUtils_BinaryTreeKeyValue keyValue);
+
+  /// @brief Insert a key/value pair in a persistent tree.
+  /// @param tree The tree where data will be inserted.
+  /// @param keyValue Pair key value to insert. NULL in data
+  /// is allowed.
+  /// @return true in success, false if the key already
+  /// exists or on error. The tree isn't changed on error.
+  bool GenUtils_PersistentTreeInsert(
+    GenUtils_PersistentTree *tree,
+    GenUtils_BinaryTreeKeyValue keyValue);
+
+  /// @brief Remove a key from a persistent tree and return
+  /// its value.
+  /// @param tree The tree where the key will be removed.
+  /// @param key The ID of the element to remove.
+  /// @return The value of the key, or NULL if it doesn't
+  /// exist or on error.
+  void *GenUtils_PersistentTreeRemove(
+    GenUtils_PersistentTree *tree, const char *key);
+
+  /// @brief Remove a key from a persistent tree.
+  /// @param tree The tree where the key will be removed.
+  /// @param key The ID of the element to remove.
+  /// @return true if the key was removed. The tree isn't
+  /// changed on error.
+  bool GenUtils_PersistentTreeRemoveBool(
+    GenUtils_PersistentTree *tree, const char *key);
+
+  /// @brief Make a snapshot of a persistent tree in O(1).
+  /// The snapshot is a persistent tree too, and it can be
+  /// read, changed and destroyed from another thread while
+  /// the original tree is changed.
+  /// @param tree The tree to copy.
+  /// @return The snapshot, that uses the same allocator, or
+  /// NULL on error.
+  GenUtils_PersistentTree *GenUtils_PersistentTreeSnapshot(
+    GenUtils_PersistentTree *tree);
+
+  /// @brief Clear the content of a persistent tree. The
+  /// snapshots keep their content.
+  /// @param tree The tree to clear.
+  void GenUtils_PersistentTreeClear(
+    GenUtils_PersistentTree *tree);
+
+  /// @brief Iterate through all the elements of a
+  /// persistent tree in order.
+  /// @param tree The tree to iterate.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function. It pass a
+  /// pointer to key/value pair and extradata.
+  void GenUtils_PersistentTreeInorder(
+    GenUtils_PersistentTree *tree, void *extradata,
+    void (*function)(
+      const GenUtils_BinaryTreeKeyValue *, void *));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,91 @@
+/// @file Pool.h
+/// @author DP-Dev
+/// @brief Implementation of a pool of fixed size objects.
+///
+/// The pool takes objects from big chunks of memory and
+/// keeps the released objects in an intrusive free list, so
+/// the containers can allocate and release nodes without
+/// calling malloc and free every time. All the objects can
+/// be released at once by resetting the pool.
+#ifndef GENUTILS_POOL_H
+#define GENUTILS_POOL_H
+#include <GenUtils/Allocator.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief An structure to represent a pool.
+  typedef struct GenUtils_Pool
+  {
+    /// @brief Size of every object, rounded up to keep the
+    /// objects aligned.
+    size_t objectSize;
+    /// @brief Number of objects of the next chunk.
+    size_t chunkCapacity;
+    /// @brief List of allocated chunks, the newest first.
+    void *chunks;
+    /// @brief List of released objects.
+    void *freeList;
+    /// @brief Next object never used in the newest chunk.
+    char *next;
+    /// @brief End of the newest chunk.
+    char *end;
+    /// @brief Allocator of the pool and its chunks, or NULL
+    /// to use malloc.
+    const GenUtils_Allocator *allocator;
+  } GenUtils_Pool;
+
+  /// @brief Create a new pool.
+  /// @param objectSize The size of the objects of the pool.
+  /// @param capacityHint The number of objects expected.
+  /// Memory for this number of objects is allocated at once
+  /// in a single chunk.
+  /// @return The new pool or NULL on error.
+  GenUtils_Pool *GenUtils_PoolCreate(
+    size_t objectSize, size_t capacityHint);
+
+  /// @brief Create a new pool that takes its memory from an
+  /// allocator.
+  /// @param objectSize The size of the objects of the pool.
+  /// @param capacityHint The number of objects expected.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the pool is destroyed.
+  /// @return The new pool or NULL on error.
+  GenUtils_Pool *GenUtils_PoolCreateWithAllocator(
+    size_t objectSize, size_t capacityHint,
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a pool and all its objects.
+  /// @param pool The pool to destroy.
+  void GenUtils_PoolDestroy(GenUtils_Pool *pool);
+
+  /// @brief Check if a pool have been initialized.
+  /// @param pool The pool to query.
+  /// @return true if the pool have been initialized.
+  bool GenUtils_PoolWasInit(GenUtils_Pool *pool);
+
+  /// @brief Get an object from a pool.
+  /// @param pool The pool where the object will be taken.
+  /// @return A pointer to the object, aligned to the size
+  /// of a pointer, or NULL on error.
+  void *GenUtils_PoolAlloc(GenUtils_Pool *pool);
+
+  /// @brief Return an object to a pool.
+  /// @param pool The pool that owns the object.
+  /// @param object The object to release, NULL is allowed.
+  void GenUtils_PoolFree(GenUtils_Pool *pool, void *object);
+
+  /// @brief Release all the objects of a pool at once. The
+  /// newest chunk is kept to be reused.
+  /// @param pool The pool to reset.
+  void GenUtils_PoolReset(GenUtils_Pool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,143 @@
+/// @file SPSCRing.h
+/// @author DP-Dev
+/// @brief Implementation of a lock-free single producer
+/// single consumer ring buffer.
+///
+/// The ring has a fixed capacity that is a power of two.
+/// One thread pushes and another one pops without locks.
+/// Every side writes only its own index, on its own cache
+/// line, and keeps a copy of the index of the other side
+/// that it only reloads when the ring looks full or empty.
+/// Nothing is allocated after the creation.
+#ifndef GENUTILS_SPSC_RING_H
+#define GENUTILS_SPSC_RING_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/types.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief An structure to represent a SPSC ring.
+  typedef struct GenUtils_SPSCRing
+  {
+    /// @brief Buffer of the elements.
+    void **data;
+    /// @brief The number of elements that fit in the
+    /// buffer, a power of two.
+    size_t capacity;
+    /// @brief Allocator of the ring and its buffer, or NULL
+    /// to use malloc.
+    const GenUtils_Allocator *allocator;
+    /// @brief Padding to move the consumer data to another
+    /// cache line.
+    char consumerPadding[GENUTILS_CACHE_LINE];
+    /// @brief Number of elements popped, written by the
+    /// consumer.
+    _Atomic size_t head;
+    /// @brief Copy of tail used by the consumer.
+    size_t cachedTail;
+    /// @brief Padding to move the producer data to another
+    /// cache line.
+    char producerPadding[GENUTILS_CACHE_LINE];
+    /// @brief Number of elements pushed, written by the
+    /// producer.
+    _Atomic size_t tail;
+    /// @brief Copy of head used by the producer.
+    size_t cachedHead;
+    /// @brief Padding to keep other data out of the
+    /// producer cache line.
+    char endPadding[GENUTILS_CACHE_LINE];
+  } GenUtils_SPSCRing;
+
+  /// @brief Create a new SPSC ring.
+  /// @param capacity The number of elements, rounded up to
+  /// a power of two.
+  /// @return The new ring or NULL on error.
+  GenUtils_SPSCRing *GenUtils_SPSCRingCreate(
+    size_t capacity);
+
+  /// @brief Create a new SPSC ring that takes its memory
+  /// from an allocator.
+  /// @param capacity The number of elements, rounded up to
+  /// a power of two.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the ring is destroyed.
+  /// @return The new ring or NULL on error.
+  GenUtils_SPSCRing *GenUtils_SPSCRingCreateWithAllocator(
+    size_t capacity, const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a SPSC ring. No thread can use the
+  /// ring at the same time.
+  /// @param ring The ring to destroy.
+  void GenUtils_SPSCRingDestroy(GenUtils_SPSCRing *ring);
+
+  /// @brief Check if a ring have been initialized.
+  /// @param ring The ring to query.
+  /// @return true if the ring have been initialized.
+  bool GenUtils_SPSCRingWasInit(GenUtils_SPSCRing *ring);
+
+  /// @brief Get the capacity of a ring.
+  /// @param ring The ring to query.
+  /// @return The number of elements that fit in the ring.
+  size_t GenUtils_SPSCRingGetCapacity(
+    GenUtils_SPSCRing *ring);
+
+  /// @brief Get the number of elements in a ring. It can be
+  /// outdated when it returns if the other side is working.
+  /// @param ring The ring to query.
+  /// @return The number of elements in the ring.
+  size_t GenUtils_SPSCRingGetSize(GenUtils_SPSCRing *ring);
+
+  /// @brief Check if a ring is empty. It can be outdated
+  /// when it returns if the other side is working.
+  /// @param ring The ring to query.
+  /// @return true if is empty.
+  bool GenUtils_SPSCRingEmpty(GenUtils_SPSCRing *ring);
+
+  /// @brief Push an element. Only the producer can call
+  /// it.
+  /// @param ring The ring where the element will be pushed.
+  /// @param userdata The element to push.
+  /// @return true in success, false if the ring is full.
+  bool GenUtils_SPSCRingTryPush(
+    GenUtils_SPSCRing *ring, void *userdata);
+
+  /// @brief Push several elements. Only the producer can
+  /// call it.
+  /// @param ring The ring where the elements will be
+  /// pushed.
+  /// @param elements The elements to push.
+  /// @param count The number of elements to push.
+  /// @return The number of elements pushed, less than count
+  /// if the ring gets full.
+  size_t GenUtils_SPSCRingTryPushN(GenUtils_SPSCRing *ring,
+    void *const *elements, size_t count);
+
+  /// @brief Pop an element. Only the consumer can call it.
+  /// @param ring The ring where the element will be popped.
+  /// @param userdata Where the element is stored.
+  /// @return true in success, false if the ring is empty.
+  bool GenUtils_SPSCRingTryPop(
+    GenUtils_SPSCRing *ring, void **userdata);
+
+  /// @brief Pop several elements. Only the consumer can
+  /// call it.
+  /// @param ring The ring where the elements will be
+  /// popped.
+  /// @param elements Array where the elements are stored,
+  /// oldest first.
+  /// @param count The size of the array.
+  /// @return The number of elements popped.
+  size_t GenUtils_SPSCRingTryPopN(
+    GenUtils_SPSCRing *ring, void **elements, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
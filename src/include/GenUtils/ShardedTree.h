@@ -0,0 +1,182 @@
+/// @file ShardedTree.h
+/// @author DP-Dev
+/// @brief Implementation of a sharded binary tree.
+///
+/// The sharded tree is an ordered map with the same string
+/// keys and the same functions as the binary tree, that
+/// any number of threads can use at the same time. Every
+/// key is hashed to one of several binary trees, and every
+/// tree has its own reader-writer lock on its own cache
+/// line, so threads that use different keys rarely wait
+/// for each other. Ordered iteration merges the trees. The
+/// keys are not copied.
+#ifndef GENUTILS_SHARDED_TREE_H
+#define GENUTILS_SHARDED_TREE_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/BinaryTree.h>
+#include <GenUtils/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief Number of shards used when none is given.
+#define GENUTILS_SHARDED_TREE_DEFAULT_SHARDS 64
+
+  /// @brief A shard of a sharded tree, defined in
+  /// ShardedTree.c so the header doesn't need the POSIX
+  /// lock types.
+  typedef struct GenUtils_ShardedTreeShard
+    GenUtils_ShardedTreeShard;
+
+  /// @brief An structure to represent a sharded tree.
+  typedef struct GenUtils_ShardedTree
+  {
+    /// @brief The shards.
+    GenUtils_ShardedTreeShard *shards;
+    /// @brief The number of shards, a power of two.
+    size_t shardCount;
+    /// @brief Allocator of the sharded tree and its nodes,
+    /// or NULL to use malloc. It must be thread-safe.
+    const GenUtils_Allocator *allocator;
+    /// @brief Copy of the allocator used by the trees of
+    /// the shards, that can't be reset.
+    GenUtils_Allocator shared;
+  } GenUtils_ShardedTree;
+
+  /// @brief Create a new sharded tree.
+  /// @param shardCount The number of shards, rounded up to
+  /// a power of two, or 0 to use
+  /// GENUTILS_SHARDED_TREE_DEFAULT_SHARDS.
+  /// @return The new sharded tree or NULL on error.
+  GenUtils_ShardedTree *GenUtils_ShardedTreeCreate(
+    size_t shardCount);
+
+  /// @brief Create a new sharded tree that takes its
+  /// memory from an allocator.
+  /// @param shardCount The number of shards, rounded up to
+  /// a power of two, or 0 to use
+  /// GENUTILS_SHARDED_TREE_DEFAULT_SHARDS.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It's called by several threads at the same
+  /// time, so it must be thread-safe. It must be valid
+  /// until the sharded tree is destroyed.
+  /// @return The new sharded tree or NULL on error.
+  GenUtils_ShardedTree *
+    GenUtils_ShardedTreeCreateWithAllocator(
+      size_t shardCount,
+      const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a sharded tree. No thread can use the
+  /// sharded tree at the same time.
+  /// @param shardedTree The sharded tree to destroy.
+  void GenUtils_ShardedTreeDestroy(
+    GenUtils_ShardedTree *shardedTree);
+
+  /// @brief Check if a sharded tree have been initialized.
+  /// @param shardedTree The sharded tree to query.
+  /// @return true if the sharded tree have been
+  /// initialized.
+  bool GenUtils_ShardedTreeWasInit(
+    GenUtils_ShardedTree *shardedTree);
+
+  /// @brief Get the number of elements in a sharded tree.
+  /// The shards are counted one by one, so it can be
+  /// outdated when it returns if another thread is working.
+  /// @param shardedTree The sharded tree to query.
+  /// @return The number of elements in the sharded tree.
+  size_t GenUtils_ShardedTreeGetSize(
+    GenUtils_ShardedTree *shardedTree);
+
+  /// @brief Check if a sharded tree is empty. It can be
+  /// outdated when it returns if another thread is working.
+  /// @param shardedTree The sharded tree to query.
+  /// @return true if is empty.
+  bool GenUtils_ShardedTreeEmpty(
+    GenUtils_ShardedTree *shardedTree);
+
+  /// @brief Checks if a key exists.
+  /// @param shardedTree The sharded tree to search in.
+  /// @param key The key to search for.
+  /// @return true if the key exists.
+  bool GenUtils_ShardedTreeExist(
+    GenUtils_ShardedTree *shardedTree, const char *key);
+
+  /// @brief Get the value of a key in a sharded tree.
+  /// @param shardedTree The sharded tree where the key will
+  /// be searched.
+  /// @param key The key associated with the value.
+  /// @return The value associated with the key, or NULL on
+  /// error.
+  void *GenUtils_ShardedTreeGet(
+    GenUtils_ShardedTree *shardedTree, const char *key);
+
+  /// @brief Set the value of a key.
+  /// @param shardedTree The sharded tree to modify.
+  /// @param keyValue The key to modify and the value to
+  /// set.
+  /// @return true in success, false if the key doesn't
+  /// exist.
+  bool GenUtils_ShardedTreeSet(
+    GenUtils_ShardedTree *shardedTree,
+    GenUtils_BinaryTreeKeyValue keyValue);
+
+  /// @brief Insert a key/value pair in a sharded tree.
+  /// @param shardedTree The sharded tree where data will be
+  /// inserted.
+  /// @param keyValue Pair key value to insert. NULL in data
+  /// is allowed.
+  /// @return true in success, false if the key already
+  /// exists or on error.
+  bool GenUtils_ShardedTreeInsert(
+    GenUtils_ShardedTree *shardedTree,
+    GenUtils_BinaryTreeKeyValue keyValue);
+
+  /// @brief Remove a key from a sharded tree and return its
+  /// value.
+  /// @param shardedTree The sharded tree where the key will
+  /// be removed.
+  /// @param key The ID of the element to remove.
+  /// @return The value of the key, or NULL if it doesn't
+  /// exist.
+  void *GenUtils_ShardedTreeRemove(
+    GenUtils_ShardedTree *shardedTree, const char *key);
+
+  /// @brief Remove a key from a sharded tree.
+  /// @param shardedTree The sharded tree where the key will
+  /// be removed.
+  /// @param key The ID of the element to remove.
+  /// @return true if the key was removed.
+  bool GenUtils_ShardedTreeRemoveBool(
+    GenUtils_ShardedTree *shardedTree, const char *key);
+
+  /// @brief Clear the content of a sharded tree. The shards
+  /// are cleared one by one.
+  /// @param shardedTree The sharded tree to clear.
+  void GenUtils_ShardedTreeClear(
+    GenUtils_ShardedTree *shardedTree);
+
+  /// @brief Iterate through all the elements of a sharded
+  /// tree in order. All the shards are locked for reading
+  /// during the iteration, so it sees a consistent state,
+  /// and the function can't modify the sharded tree. The
+  /// shards are merged with a heap of their cursors, so n
+  /// elements in s shards take O(n log s).
+  /// @param shardedTree The sharded tree to iterate.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function. It pass a
+  /// pointer to key/value pair and extradata.
+  void GenUtils_ShardedTreeInorder(
+    GenUtils_ShardedTree *shardedTree, void *extradata,
+    void (*function)(
+      const GenUtils_BinaryTreeKeyValue *, void *));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
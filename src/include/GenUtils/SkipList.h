@@ -0,0 +1,207 @@
+/// @file SkipList.h
+/// @author DP-Dev
+/// @brief Implementation of a concurrent skip list.
+///
+/// The skip list is an ordered map with the same string
+/// keys and the same functions as the binary tree, that
+/// any number of threads can use at the same time without
+/// locks. Insertions and removals link and unlink nodes
+/// with compare-and-swap, marking the next pointers of a
+/// node before removing it. Readers never write and never
+/// retry, they only skip the marked nodes. A removed node
+/// can still be read by other threads, so it's released
+/// through the epoch domain of the skip list, which the
+/// calling threads join on their first access. The keys
+/// are not copied.
+#ifndef GENUTILS_SKIP_LIST_H
+#define GENUTILS_SKIP_LIST_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/BinaryTree.h>
+#include <GenUtils/Epoch.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief Maximum number of levels of a skip list.
+#define GENUTILS_SKIP_LIST_MAX_HEIGHT 32
+
+  /// @brief A node of a skip list, defined in SkipList.c.
+  typedef struct GenUtils_SkipListNode
+    GenUtils_SkipListNode;
+
+  /// @brief An structure to represent a skip list.
+  typedef struct GenUtils_SkipList
+  {
+    /// @brief Node before the first element, with
+    /// GENUTILS_SKIP_LIST_MAX_HEIGHT levels.
+    GenUtils_SkipListNode *head;
+    /// @brief The number of levels in use.
+    _Atomic size_t height;
+    /// @brief The number of elements of the skip list.
+    _Atomic size_t size;
+    /// @brief Epoch domain that releases the removed
+    /// nodes.
+    GenUtils_Epoch *epoch;
+    /// @brief Allocator of the skip list and its nodes, or
+    /// NULL to use malloc. It must be thread-safe.
+    const GenUtils_Allocator *allocator;
+    /// @brief Copy of the allocator used by the epoch
+    /// domain, that can't be reset.
+    GenUtils_Allocator shared;
+  } GenUtils_SkipList;
+
+  /// @brief Create a new skip list.
+  /// @return The new skip list or NULL on error.
+  GenUtils_SkipList *GenUtils_SkipListCreate();
+
+  /// @brief Create a new skip list that takes its memory
+  /// from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It's called by several threads at the same
+  /// time, so it must be thread-safe. It must be valid
+  /// until the skip list is destroyed.
+  /// @return The new skip list or NULL on error.
+  GenUtils_SkipList *GenUtils_SkipListCreateWithAllocator(
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a skip list. No thread can use the skip
+  /// list at the same time.
+  /// @param skipList The skip list to destroy.
+  void GenUtils_SkipListDestroy(
+    GenUtils_SkipList *skipList);
+
+  /// @brief Check if a skip list have been initialized.
+  /// @param skipList The skip list to query.
+  /// @return true if the skip list have been initialized.
+  bool GenUtils_SkipListWasInit(
+    GenUtils_SkipList *skipList);
+
+  /// @brief Get the number of elements in a skip list. It
+  /// can be outdated when it returns if another thread is
+  /// working.
+  /// @param skipList The skip list to query.
+  /// @return The number of elements in the skip list.
+  size_t GenUtils_SkipListGetSize(
+    GenUtils_SkipList *skipList);
+
+  /// @brief Check if a skip list is empty. It can be
+  /// outdated when it returns if another thread is working.
+  /// @param skipList The skip list to query.
+  /// @return true if is empty.
+  bool GenUtils_SkipListEmpty(GenUtils_SkipList *skipList);
+
+  /// @brief Checks if a key exists.
+  /// @param skipList The skip list to search in.
+  /// @param key The key to search for.
+  /// @return true if the key exists.
+  bool GenUtils_SkipListExist(
+    GenUtils_SkipList *skipList, const char *key);
+
+  /// @brief Get the value of a key in a skip list.
+  /// @param skipList The skip list where the key will be
+  /// searched.
+  /// @param key The key associated with the value.
+  /// @return The value associated with the key, or NULL on
+  /// error.
+  void *GenUtils_SkipListGet(
+    GenUtils_SkipList *skipList, const char *key);
+
+  /// @brief Set the value of a key.
+  /// @param skipList The skip list to modify.
+  /// @param keyValue The key to modify and the value to
+  /// set.
+  /// @return true in success, false if the key doesn't
+  /// exist.
+  bool GenUtils_SkipListSet(GenUtils_SkipList *skipList,
+    GenUtils_BinaryTreeKeyValue keyValue);
+
+  /// @brief Insert a key/value pair in a skip list.
+  /// @param skipList The skip list where data will be
+  /// inserted.
+  /// @param keyValue Pair key value to insert. NULL in data
+  /// is allowed. The key must be valid until the skip list
+  /// is cleared or destroyed.
+  /// @return true in success, false if the key already
+  /// exists or on error.
+  bool GenUtils_SkipListInsert(GenUtils_SkipList *skipList,
+    GenUtils_BinaryTreeKeyValue keyValue);
+
+  /// @brief Remove a key from a skip list and return its
+  /// value.
+  /// @param skipList The skip list where the key will be
+  /// removed.
+  /// @param key The ID of the element to remove.
+  /// @return The value of the key, or NULL if it doesn't
+  /// exist.
+  void *GenUtils_SkipListRemove(
+    GenUtils_SkipList *skipList, const char *key);
+
+  /// @brief Remove a key from a skip list.
+  /// @param skipList The skip list where the key will be
+  /// removed.
+  /// @param key The ID of the element to remove.
+  /// @return true if the key was removed by this call.
+  bool GenUtils_SkipListRemoveBool(
+    GenUtils_SkipList *skipList, const char *key);
+
+  /// @brief Clear the content of a skip list. No thread can
+  /// use the skip list at the same time.
+  /// @param skipList The skip list to clear.
+  void GenUtils_SkipListClear(GenUtils_SkipList *skipList);
+
+  /// @brief Release the removed nodes that no thread can
+  /// read anymore, including the ones left by threads that
+  /// stopped using the skip list. A thread that removes
+  /// nodes and then only reads can call it to release them.
+  /// @param skipList The skip list to collect.
+  void GenUtils_SkipListCollect(
+    GenUtils_SkipList *skipList);
+
+  /// @brief Unregister the calling thread from the epoch
+  /// domain of a skip list, when it will not use the skip
+  /// list anymore. Its removed nodes are released by the
+  /// other threads.
+  /// @param skipList The skip list the thread used.
+  void GenUtils_SkipListUnregister(
+    GenUtils_SkipList *skipList);
+
+  /// @brief Iterate through all the elements of a skip list
+  /// in order. Elements inserted or removed by other
+  /// threads during the iteration may be skipped, and no
+  /// removed node is released until it ends.
+  /// @param skipList The skip list to iterate.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function. It pass a
+  /// pointer to a copy of the key/value pair and extradata.
+  void GenUtils_SkipListInorder(GenUtils_SkipList *skipList,
+    void *extradata,
+    void (*function)(
+      const GenUtils_BinaryTreeKeyValue *, void *));
+
+  /// @brief Iterate in order through the elements of a skip
+  /// list whose keys are in a range.
+  /// @param skipList The skip list to iterate.
+  /// @param from The first key of the range, or NULL to
+  /// start at the first element.
+  /// @param to The key after the range, or NULL to end at
+  /// the last element.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function. It pass a
+  /// pointer to a copy of the key/value pair and extradata.
+  void GenUtils_SkipListRange(GenUtils_SkipList *skipList,
+    const char *from, const char *to, void *extradata,
+    void (*function)(
+      const GenUtils_BinaryTreeKeyValue *, void *));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+/// @file SnapshotMap.h
+/// @author DP-Dev
+/// @brief Implementation of a read-copy-update map.
+///
+/// The snapshot map is an ordered map for data that is
+/// read much more often than it changes. The content is an
+/// immutable version, a sorted array made from a binary
+/// tree with GenUtils_BinaryTreeToArray. Readers search the
+/// current version without locks and without writing any
+/// shared data, only their own epoch. A writer builds a
+/// new version and publishes it with an atomic exchange,
+/// and the old version is released through the epoch
+/// domain of the map when no reader can hold it anymore.
+/// The keys are not copied.
+#ifndef GENUTILS_SNAPSHOT_MAP_H
+#define GENUTILS_SNAPSHOT_MAP_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/BinaryTree.h>
+#include <GenUtils/Epoch.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief An immutable version of a snapshot map.
+  typedef struct GenUtils_SnapshotMapVersion
+  {
+    /// @brief Entry used to release the version.
+    GenUtils_EpochEntry entry;
+    /// @brief The elements, sorted by key. It's allocated
+    /// with malloc.
+    GenUtils_BinaryTreeKeyValue *array;
+    /// @brief The number of elements.
+    size_t size;
+  } GenUtils_SnapshotMapVersion;
+
+  /// @brief An structure to represent a snapshot map.
+  typedef struct GenUtils_SnapshotMap
+  {
+    /// @brief The current version.
+    _Atomic(GenUtils_SnapshotMapVersion *) current;
+    /// @brief Epoch domain that releases the old versions.
+    GenUtils_Epoch *epoch;
+    /// @brief Allocator of the map and its versions, or
+    /// NULL to use malloc. It must be thread-safe.
+    const GenUtils_Allocator *allocator;
+    /// @brief Copy of the allocator used by the epoch
+    /// domain, that can't be reset.
+    GenUtils_Allocator shared;
+  } GenUtils_SnapshotMap;
+
+  /// @brief Create a new empty snapshot map.
+  /// @return The new snapshot map or NULL on error.
+  GenUtils_SnapshotMap *GenUtils_SnapshotMapCreate();
+
+  /// @brief Create a new empty snapshot map that takes its
+  /// memory from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It's called by several threads at the same
+  /// time, so it must be thread-safe. It must be valid
+  /// until the snapshot map is destroyed.
+  /// @return The new snapshot map or NULL on error.
+  GenUtils_SnapshotMap *
+    GenUtils_SnapshotMapCreateWithAllocator(
+      const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a snapshot map and all its versions. No
+  /// thread can use the snapshot map at the same time.
+  /// @param snapshotMap The snapshot map to destroy.
+  void GenUtils_SnapshotMapDestroy(
+    GenUtils_SnapshotMap *snapshotMap);
+
+  /// @brief Check if a snapshot map have been initialized.
+  /// @param snapshotMap The snapshot map to query.
+  /// @return true if the snapshot map have been
+  /// initialized.
+  bool GenUtils_SnapshotMapWasInit(
+    GenUtils_SnapshotMap *snapshotMap);
+
+  /// @brief Get the number of elements of the current
+  /// version of a snapshot map.
+  /// @param snapshotMap The snapshot map to query.
+  /// @return The number of elements.
+  size_t GenUtils_SnapshotMapGetSize(
+    GenUtils_SnapshotMap *snapshotMap);
+
+  /// @brief Check if the current version of a snapshot map
+  /// is empty.
+  /// @param snapshotMap The snapshot map to query.
+  /// @return true if is empty.
+  bool GenUtils_SnapshotMapEmpty(
+    GenUtils_SnapshotMap *snapshotMap);
+
+  /// @brief Checks if a key exists in the current version.
+  /// @param snapshotMap The snapshot map to search in.
+  /// @param key The key to search for.
+  /// @return true if the key exists.
+  bool GenUtils_SnapshotMapExist(
+    GenUtils_SnapshotMap *snapshotMap, const char *key);
+
+  /// @brief Get the value of a key in the current version.
+  /// @param snapshotMap The snapshot map where the key will
+  /// be searched.
+  /// @param key The key associated with the value.
+  /// @return The value associated with the key, or NULL on
+  /// error.
+  void *GenUtils_SnapshotMapGet(
+    GenUtils_SnapshotMap *snapshotMap, const char *key);
+
+  /// @brief Publish the content of a binary tree as the new
+  /// version of a snapshot map. The readers that already
+  /// hold the old version keep reading it, and it's
+  /// released by the first Publish or Collect after they
+  /// release it.
+  /// @param snapshotMap The snapshot map to modify.
+  /// @param binaryTree The tree to copy. It's not modified,
+  /// and it can be changed after the call. If it copies
+  /// its keys to an arena, the map uses those keys, so the
+  /// tree can't be balanced, cleared or destroyed while the
+  /// map is used.
+  /// @return true in success.
+  bool GenUtils_SnapshotMapPublish(
+    GenUtils_SnapshotMap *snapshotMap,
+    GenUtils_BinaryTree *binaryTree);
+
+  /// @brief Get the current version of a snapshot map, to
+  /// make several reads on the same version. The version
+  /// is valid until GenUtils_SnapshotMapRelease is called
+  /// by the same thread.
+  /// @param snapshotMap The snapshot map to read.
+  /// @return The current version, or NULL on error.
+  const GenUtils_SnapshotMapVersion *
+    GenUtils_SnapshotMapAcquire(
+      GenUtils_SnapshotMap *snapshotMap);
+
+  /// @brief Release the version got with
+  /// GenUtils_SnapshotMapAcquire.
+  /// @param snapshotMap The snapshot map that was read.
+  void GenUtils_SnapshotMapRelease(
+    GenUtils_SnapshotMap *snapshotMap);
+
+  /// @brief Get the value of a key in a version.
+  /// @param version The version where the key will be
+  /// searched.
+  /// @param key The key associated with the value.
+  /// @return The value associated with the key, or NULL on
+  /// error.
+  void *GenUtils_SnapshotMapVersionGet(
+    const GenUtils_SnapshotMapVersion *version,
+    const char *key);
+
+  /// @brief Iterate through all the elements of the current
+  /// version in order.
+  /// @param snapshotMap The snapshot map to iterate.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function. It pass a
+  /// pointer to key/value pair and extradata.
+  void GenUtils_SnapshotMapInorder(
+    GenUtils_SnapshotMap *snapshotMap, void *extradata,
+    void (*function)(
+      const GenUtils_BinaryTreeKeyValue *, void *));
+
+  /// @brief Release the old versions that no reader can
+  /// hold anymore, including the ones left by threads that
+  /// stopped using the snapshot map.
+  /// @param snapshotMap The snapshot map to collect.
+  void GenUtils_SnapshotMapCollect(
+    GenUtils_SnapshotMap *snapshotMap);
+
+  /// @brief Unregister the calling thread from the epoch
+  /// domain of a snapshot map, when it will not use the
+  /// snapshot map anymore. Its old versions are released by
+  /// the other threads.
+  /// @param snapshotMap The snapshot map the thread used.
+  void GenUtils_SnapshotMapUnregister(
+    GenUtils_SnapshotMap *snapshotMap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,22 +1,55 @@
 /// @file Stack.h
 /// @author DP-Dev
 /// @brief Implementation of a stack.
+///
+/// The stack stores its elements in a contiguous buffer
+/// that grows geometrically. Shallow stacks use a small
+/// buffer inside the stack structure, so they never
+/// allocate memory for their elements.
 #ifndef GENUTILS_STACK_H
 #define GENUTILS_STACK_H true
 #ifdef __cplusplus
 extern "C"
 {
 #endif
+#include <GenUtils/Allocator.h>
 #include <stdbool.h>
 #include <stdlib.h>
 
-  /// @brief Define stack as a synonim of a CDLL.
-  typedef struct GenUtils_CDLL GenUtils_Stack;
+  /// @brief Number of elements stored inside the stack
+  /// structure before allocating a buffer.
+#define GENUTILS_STACK_INLINE_CAPACITY 8
+
+  /// @brief An structure to represent a stack.
+  typedef struct GenUtils_Stack
+  {
+    /// @brief Buffer of the elements, the top is the last
+    /// one.
+    void **data;
+    /// @brief The number of elements in the stack.
+    size_t size;
+    /// @brief The number of elements that fit in the
+    /// buffer.
+    size_t capacity;
+    /// @brief Allocator of the stack and its buffer, or
+    /// NULL to use malloc.
+    const GenUtils_Allocator *allocator;
+    /// @brief Buffer used while the elements fit in it.
+    void *inlineData[GENUTILS_STACK_INLINE_CAPACITY];
+  } GenUtils_Stack;
 
   /// @brief Create a stack.
   /// @return NULL in error or a valid pointer in success.
   GenUtils_Stack *GenUtils_StackCreate();
 
+  /// @brief Create a stack that takes its memory from an
+  /// allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the stack is destroyed.
+  /// @return NULL in error or a valid pointer in success.
+  GenUtils_Stack *GenUtils_StackCreateWithAllocator(
+    const GenUtils_Allocator *allocator);
+
   /// @brief Query if  a stack was initialized.
   /// @param stack The stack to query.
   /// @return true if the stack was initialized.
@@ -47,8 +80,9 @@ extern "C"
   /// returns its value.
   /// @param stack The stack where the element will be
   /// popped.
-  /// @return true in success, false otherwise.
-  bool GenUtils_StackPop(GenUtils_Stack *stack);
+  /// @return The element in the top. NULL if is empty or if
+  /// the element is NULL.
+  void *GenUtils_StackPop(GenUtils_Stack *stack);
 
   /// @brief Pop the element in the top of a stack.
   /// @param stack The stack where the element will be
@@ -63,10 +97,30 @@ extern "C"
   /// sure.
   void *GenUtils_StackTop(GenUtils_Stack *stack);
 
-  /// @brief Clear a stack.
+  /// @brief Clear a stack. Its buffer is kept.
   /// @param stack The stack to clear.
   void GenUtils_StackClear(GenUtils_Stack *stack);
 
+  /// @brief Get the number of elements that fit in a stack
+  /// without growing its buffer.
+  /// @param stack The stack to query.
+  /// @return The capacity of the stack.
+  size_t GenUtils_StackGetCapacity(GenUtils_Stack *stack);
+
+  /// @brief Grow the buffer of a stack to hold a number of
+  /// elements.
+  /// @param stack The stack to grow.
+  /// @param capacity The number of elements to hold.
+  /// @return true in success, false otherwise.
+  bool GenUtils_StackReserve(
+    GenUtils_Stack *stack, size_t capacity);
+
+  /// @brief Shrink the buffer of a stack to fit its
+  /// elements.
+  /// @param stack The stack to shrink.
+  /// @return true in success, false otherwise.
+  bool GenUtils_StackShrink(GenUtils_Stack *stack);
+
 #ifdef __cplusplus
 }
 #endif
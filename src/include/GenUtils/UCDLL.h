@@ -0,0 +1,218 @@
+/// @file UCDLL.h
+/// @author DP-Dev
+/// @brief Implementation of an unrolled CDLL.
+///
+/// The unrolled CDLL is a circular doubly linked list of
+/// blocks, and every block stores up to
+/// GENUTILS_UCDLL_BLOCK_CAPACITY elements. Full blocks are
+/// split on insertion, and a block left less than half full
+/// by a removal is merged with a neighbour or takes
+/// elements from the next block, so every block but the
+/// tail is at least half full and traversals touch one
+/// node for several elements. Positions are invalidated by
+/// insertions in the same block, and by removals in the
+/// same block or in the previous one. A removal can merge
+/// its block into the previous one, whose elements keep
+/// their positions.
+#ifndef GENUTILS_UCDLL_H
+#define GENUTILS_UCDLL_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/types.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief Number of bytes of a block, two cache lines.
+  /// Blocks are aligned to a cache line.
+#define GENUTILS_UCDLL_BLOCK_SIZE (2 * GENUTILS_CACHE_LINE)
+
+  /// @brief Number of elements of a block, so the elements
+  /// with the links and the count fill the block.
+#define GENUTILS_UCDLL_BLOCK_CAPACITY \
+  ((GENUTILS_UCDLL_BLOCK_SIZE - 2 * sizeof(void *) - \
+    sizeof(size_t)) / sizeof(void *))
+
+  /// @brief A block of elements of an unrolled CDLL.
+  typedef struct GenUtils_UCDLLBlock
+  {
+    /// @brief The previous block.
+    struct GenUtils_UCDLLBlock *previous;
+    /// @brief The next block.
+    struct GenUtils_UCDLLBlock *next;
+    /// @brief The number of elements of the block.
+    size_t count;
+    /// @brief The elements stored in the block.
+    void *userdata[GENUTILS_UCDLL_BLOCK_CAPACITY];
+  } GenUtils_UCDLLBlock;
+
+  /// @brief An structure to represent an unrolled CDLL.
+  typedef struct GenUtils_UCDLL
+  {
+    /// @brief The first block of the list.
+    GenUtils_UCDLLBlock *head;
+    /// @brief The number of elements of the list.
+    size_t size;
+    /// @brief Allocator of the list and its blocks, or NULL
+    /// to use malloc.
+    const GenUtils_Allocator *allocator;
+  } GenUtils_UCDLL;
+
+  /// @brief The position of an element in an unrolled CDLL.
+  typedef struct GenUtils_UCDLLPosition
+  {
+    /// @brief The block of the element, NULL if the
+    /// position is not valid.
+    GenUtils_UCDLLBlock *block;
+    /// @brief The index of the element in the block.
+    size_t index;
+  } GenUtils_UCDLLPosition;
+
+  /// @brief Create a new unrolled CDLL.
+  /// @return The new list or NULL on error.
+  GenUtils_UCDLL *GenUtils_UCDLLCreate();
+
+  /// @brief Create a new unrolled CDLL that takes its
+  /// memory from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the list is destroyed.
+  /// @return The new list or NULL on error.
+  GenUtils_UCDLL *GenUtils_UCDLLCreateWithAllocator(
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy an unrolled CDLL.
+  /// @param list The list to destroy.
+  void GenUtils_UCDLLDestroy(GenUtils_UCDLL *list);
+
+  /// @brief Get the number of elements in a list.
+  /// @param list The list to query.
+  /// @return The number of elements in the list.
+  size_t GenUtils_UCDLLGetSize(GenUtils_UCDLL *list);
+
+  /// @brief Check if a list is empty.
+  /// @param list The list to query.
+  /// @return true if is empty.
+  bool GenUtils_UCDLLEmpty(GenUtils_UCDLL *list);
+
+  /// @brief Check if a list have been initialized.
+  /// @param list The list to query.
+  /// @return true if the list have been initialized.
+  bool GenUtils_UCDLLWasInit(GenUtils_UCDLL *list);
+
+  /// @brief Get the position of the first element.
+  /// @param list The list to query.
+  /// @return The position, not valid if the list is empty.
+  GenUtils_UCDLLPosition GenUtils_UCDLLBegin(
+    GenUtils_UCDLL *list);
+
+  /// @brief Get the position of the last element.
+  /// @param list The list to query.
+  /// @return The position, not valid if the list is empty.
+  GenUtils_UCDLLPosition GenUtils_UCDLLEnd(
+    GenUtils_UCDLL *list);
+
+  /// @brief Get the position of the next element.
+  /// @param list The list of the position.
+  /// @param position The current position.
+  /// @return The next position, not valid after the last
+  /// element.
+  GenUtils_UCDLLPosition GenUtils_UCDLLNext(
+    GenUtils_UCDLL *list, GenUtils_UCDLLPosition position);
+
+  /// @brief Get the element in a position.
+  /// @param position The position to query.
+  /// @return The element, or NULL if the position is not
+  /// valid.
+  void *GenUtils_UCDLLGet(GenUtils_UCDLLPosition position);
+
+  /// @brief Search an element by its pointer. The blocks
+  /// are scanned with SIMD compares when available.
+  /// @param list The list where to search.
+  /// @param userdata The element to search for.
+  /// @return The position of the first element equal to
+  /// userdata, not valid if it isn't found.
+  GenUtils_UCDLLPosition GenUtils_UCDLLFind(
+    GenUtils_UCDLL *list, void *userdata);
+
+  /// @brief Insert data before a position.
+  /// @param list The list where to insert.
+  /// @param position The position where the data will be
+  /// inserted. It's ignored if the list is empty.
+  /// @param userdata The data to insert, NULL is allowed.
+  /// @return true in success.
+  bool GenUtils_UCDLLInsert(GenUtils_UCDLL *list,
+    GenUtils_UCDLLPosition position, void *userdata);
+
+  /// @brief Insert data after a position.
+  /// @param list The list where to insert.
+  /// @param position The position after which the data will
+  /// be inserted. It's ignored if the list is empty.
+  /// @param userdata The data to insert, NULL is allowed.
+  /// @return true in success.
+  bool GenUtils_UCDLLInsertAfter(GenUtils_UCDLL *list,
+    GenUtils_UCDLLPosition position, void *userdata);
+
+  /// @brief Remove the element in a position.
+  /// @param list The list where the element will be
+  /// removed.
+  /// @param position The position of the element.
+  /// @return true if the element was removed.
+  bool GenUtils_UCDLLRemove(
+    GenUtils_UCDLL *list, GenUtils_UCDLLPosition position);
+
+  /// @brief Insert data in the tail of a list.
+  /// @param list The list where the data will be inserted.
+  /// @param userdata The data to insert.
+  /// @return true in success, false otherwise.
+  bool GenUtils_UCDLLPushBack(
+    GenUtils_UCDLL *list, void *userdata);
+
+  /// @brief Insert data in the head of a list.
+  /// @param list The list where the data will be inserted.
+  /// @param userdata The data to insert.
+  /// @return true in success, false otherwise.
+  bool GenUtils_UCDLLPushFront(
+    GenUtils_UCDLL *list, void *userdata);
+
+  /// @brief Remove the tail of the list and returns its
+  /// data.
+  /// @param list The list where the data will be removed.
+  /// @return The data at the tail of the list.
+  void *GenUtils_UCDLLPopBack(GenUtils_UCDLL *list);
+
+  /// @brief Remove data from the tail of a list.
+  /// @param list The list where the data will removed.
+  /// @return true if the operation was successfully.
+  bool GenUtils_UCDLLPopBackBool(GenUtils_UCDLL *list);
+
+  /// @brief Remove the head of the list and returns its
+  /// data.
+  /// @param list The list where the data will be removed.
+  /// @return The data at the head of the list.
+  void *GenUtils_UCDLLPopFront(GenUtils_UCDLL *list);
+
+  /// @brief Remove data from the head of a list.
+  /// @param list The list where the data will be removed.
+  /// @return true if the operation was successfully.
+  bool GenUtils_UCDLLPopFrontBool(GenUtils_UCDLL *list);
+
+  /// @brief Clear the content of a list.
+  /// @param list The list to clear.
+  void GenUtils_UCDLLClear(GenUtils_UCDLL *list);
+
+  /// @brief Iterate through all the elements of a list.
+  /// @param list The list where to be iterated.
+  /// @param extradata Extradata to pass to the iterator
+  /// function.
+  /// @param function The iterator function.
+  void GenUtils_UCDLLIterate(GenUtils_UCDLL *list,
+    void *extradata, void (*function)(void *, void *));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -3,10 +3,26 @@
 /// @brief Include all headers.
 #ifndef GENUTILS_H
 #define GENUTILS_H
+#include <GenUtils/Allocator.h>
 #include <GenUtils/BinaryTree.h>
 #include <GenUtils/CDLL.h>
 #include <GenUtils/CSLL.h>
+#include <GenUtils/Deque.h>
+#include <GenUtils/Epoch.h>
+#include <GenUtils/FrozenMap.h>
+#include <GenUtils/HashMap.h>
+#include <GenUtils/MPSCQueue.h>
+#include <GenUtils/ICDLL.h>
+#include <GenUtils/ICSLL.h>
+#include <GenUtils/PersistentTree.h>
+#include <GenUtils/Pool.h>
+#include <GenUtils/ShardedTree.h>
+#include <GenUtils/SkipList.h>
+#include <GenUtils/SnapshotMap.h>
+#include <GenUtils/SPSCRing.h>
 #include <GenUtils/Stack.h>
+#include <GenUtils/UCDLL.h>
+#include <GenUtils/WorkDeque.h>
 #include <GenUtils/types.h>
 
 #endif
@@ -0,0 +1,141 @@
+/// @file WorkDeque.h
+/// @author DP-Dev
+/// @brief Implementation of a work-stealing deque.
+///
+/// The deque belongs to one thread, the owner, that uses it
+/// as a stack with the same functions as GenUtils_Stack.
+/// Other threads, the thieves, take the oldest elements
+/// from the other end with GenUtils_WorkDequeSteal without
+/// locks. The owner only synchronizes with the thieves when
+/// a pop takes the last element. The buffer grows when it
+/// is full, and old buffers are kept until the deque is
+/// destroyed because a thief can still read them.
+#ifndef GENUTILS_WORK_DEQUE_H
+#define GENUTILS_WORK_DEQUE_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/types.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /// @brief Number of elements of the first buffer.
+#define GENUTILS_WORK_DEQUE_INITIAL_CAPACITY 64
+
+  /// @brief A buffer of a work-stealing deque.
+  typedef struct GenUtils_WorkDequeBuffer
+  {
+    /// @brief The number of elements that fit in the
+    /// buffer, a power of two.
+    size_t capacity;
+    /// @brief The buffer replaced by this one, or NULL.
+    struct GenUtils_WorkDequeBuffer *previous;
+    /// @brief Ring buffer of the elements.
+    _Atomic(void *) data[];
+  } GenUtils_WorkDequeBuffer;
+
+  /// @brief An structure to represent a work-stealing
+  /// deque.
+  typedef struct GenUtils_WorkDeque
+  {
+    /// @brief Index of the oldest element, moved by the
+    /// thieves and by the owner when it pops the last one.
+    _Atomic ptrdiff_t top;
+    /// @brief Padding to move the owner data to another
+    /// cache line.
+    char padding[GENUTILS_CACHE_LINE];
+    /// @brief Index after the newest element, moved by the
+    /// owner.
+    _Atomic ptrdiff_t bottom;
+    /// @brief The current buffer.
+    _Atomic(GenUtils_WorkDequeBuffer *) buffer;
+    /// @brief Allocator of the deque and its buffers, or
+    /// NULL to use malloc. Only the owner calls it.
+    const GenUtils_Allocator *allocator;
+  } GenUtils_WorkDeque;
+
+  /// @brief Create a new work-stealing deque.
+  /// @return The new deque or NULL on error.
+  GenUtils_WorkDeque *GenUtils_WorkDequeCreate();
+
+  /// @brief Create a new work-stealing deque that takes its
+  /// memory from an allocator.
+  /// @param allocator The allocator to use, or NULL to use
+  /// malloc. It must be valid until the deque is destroyed.
+  /// @return The new deque or NULL on error.
+  GenUtils_WorkDeque *GenUtils_WorkDequeCreateWithAllocator(
+    const GenUtils_Allocator *allocator);
+
+  /// @brief Destroy a work-stealing deque. No thread can
+  /// use the deque at the same time.
+  /// @param deque The deque to destroy.
+  void GenUtils_WorkDequeDestroy(GenUtils_WorkDeque *deque);
+
+  /// @brief Check if a deque have been initialized.
+  /// @param deque The deque to query.
+  /// @return true if the deque have been initialized.
+  bool GenUtils_WorkDequeWasInit(GenUtils_WorkDeque *deque);
+
+  /// @brief Get the number of elements in a deque. It can
+  /// be outdated when it returns if a thief is working.
+  /// @param deque The deque to query.
+  /// @return The number of elements in the deque.
+  size_t GenUtils_WorkDequeGetSize(
+    GenUtils_WorkDeque *deque);
+
+  /// @brief Check if a deque is empty. It can be outdated
+  /// when it returns if a thief is working.
+  /// @param deque The deque to query.
+  /// @return true if is empty.
+  bool GenUtils_WorkDequeEmpty(GenUtils_WorkDeque *deque);
+
+  /// @brief Push an element in the top of a deque. Only the
+  /// owner can call it.
+  /// @param deque The deque where the data will be pushed.
+  /// @param userdata The data to push.
+  /// @return true in success, false otherwise.
+  bool GenUtils_WorkDequePush(
+    GenUtils_WorkDeque *deque, void *userdata);
+
+  /// @brief Pop the newest element of a deque and returns
+  /// its value. Only the owner can call it.
+  /// @param deque The deque where the element will be
+  /// popped.
+  /// @return The element in the top. NULL if is empty or if
+  /// the element is NULL.
+  void *GenUtils_WorkDequePop(GenUtils_WorkDeque *deque);
+
+  /// @brief Pop the newest element of a deque. Only the
+  /// owner can call it.
+  /// @param deque The deque where the element will be
+  /// popped.
+  /// @return true in success, false otherwise.
+  bool GenUtils_WorkDequePopBool(GenUtils_WorkDeque *deque);
+
+  /// @brief Get the newest element of a deque. Only the
+  /// owner can call it, and a thief can take the element
+  /// right after if it's the only one.
+  /// @param deque The deque to query.
+  /// @return The element in the top. NULL if is empty or if
+  /// the element is NULL.
+  void *GenUtils_WorkDequeTop(GenUtils_WorkDeque *deque);
+
+  /// @brief Take the oldest element of a deque. Any thread
+  /// can call it.
+  /// @param deque The deque where the element will be
+  /// taken.
+  /// @param userdata Where the element is stored.
+  /// @return true in success, false if the deque is empty
+  /// or another thread took the element first.
+  bool GenUtils_WorkDequeSteal(
+    GenUtils_WorkDeque *deque, void **userdata);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -3,12 +3,18 @@
 /// @brief Common types for the library.
 #ifndef GENUTILS_TYPES_H
 #define GENUTILS_TYPES_H
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+  /// @brief Size of a cache line. The containers shared by
+  /// threads keep their hot fields on different lines, and
+  /// the ones read a block at a time align their blocks.
+#define GENUTILS_CACHE_LINE 64
+
   /// @brief A node with just one pointer.
   typedef struct GenUtils_SingleNode
   {
@@ -29,6 +35,31 @@ extern "C"
     struct GenUtils_DoubleNode *second;
   } GenUtils_DoubleNode;
 
+  /// @brief A link with one pointer, embedded in the
+  /// objects of an intrusive list.
+  typedef struct GenUtils_SingleLink
+  {
+    /// @brief The next link.
+    struct GenUtils_SingleLink *next;
+  } GenUtils_SingleLink;
+
+  /// @brief A link with two pointers, embedded in the
+  /// objects of an intrusive list.
+  typedef struct GenUtils_DoubleLink
+  {
+    /// @brief The previous link.
+    struct GenUtils_DoubleLink *previous;
+    /// @brief The next link.
+    struct GenUtils_DoubleLink *next;
+  } GenUtils_DoubleLink;
+
+  /// @brief Get the object that contains a link.
+  /// @param pointer Pointer to the link.
+  /// @param type Type of the object.
+  /// @param member Name of the link in the object.
+#define GENUTILS_CONTAINER_OF(pointer, type, member) \
+  ((type *)((char *)(pointer) - offsetof(type, member)))
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,9 +2,38 @@
 // Author: DP-Dev
 // Implementation of a binary tree.
 #include <GenUtils/BinaryTree.h>
+#include <GenUtils/Pool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+// Number of bytes of the key prefix cached in the nodes.
+#define GENUTILS_BINARY_TREE_PREFIX_SIZE 8
+
+// Node of a binary tree. The links must be the first
+// member, so a pointer to the node is also a pointer to its
+// links. The node is 64 bytes in 64-bit targets, and the
+// prefix is next to the links, so most comparisons don't
+// read more than the node and don't follow the key. The
+// trees that count their nodes allocate room for count.
+typedef struct GenUtils_BinaryTreeInternalNode
+{
+  // Links of the node, first is the left child and second
+  // is the right child. Userdata points to keyValue.
+  GenUtils_DoubleNode links;
+  // The first bytes of the key in big-endian order.
+  uint64_t prefix;
+  // The key/value pair stored in the node.
+  GenUtils_BinaryTreeKeyValue keyValue;
+  // The length of the key.
+  size_t keyLength;
+  // The color of the node, true if is red.
+  bool red;
+  // The number of nodes of the subtree, only in the trees
+  // that count them.
+  size_t count[];
+} GenUtils_BinaryTreeInternalNode;
+
 // Structure to store data to conver a tree to array.
 typedef struct GenUtils_BinaryTreeInternalArrayInfo
 {
@@ -22,35 +51,328 @@ static void GenUtils_BinaryTreeInternalToArray(
   const GenUtils_BinaryTreeKeyValue *, void *);
 
 // Internal prototype for a function that removes all the
-// nodes of a tree in a postorder traversal.
+// nodes of a tree.
 static void GenUtils_BinaryTreeInternalClear(
-  GenUtils_DoubleNode *);
+  GenUtils_BinaryTree *, GenUtils_DoubleNode *);
 
-// Auxiliar internal function for preorder tree traversal.
-static void GenUtils_BinaryTreeInternalPreorder(
-  GenUtils_DoubleNode *, void *,
-  void (*)(const GenUtils_BinaryTreeKeyValue *, void *));
+// Internal function to move a cursor to the first key
+// greater or equal to a key, or greater than it.
+static bool GenUtils_BinaryTreeInternalSeek(
+  GenUtils_BinaryTreeCursor *, GenUtils_BinaryTree *,
+  const char *, bool);
 
-// Auxiliar internal function for inorder tree traversal.
-static void GenUtils_BinaryTreeInternalInorder(
-  GenUtils_DoubleNode *, void *,
+// Internal function to iterate through the keys in a
+// range, or count them if there isn't a function.
+static void GenUtils_BinaryTreeInternalRange(
+  GenUtils_BinaryTree *, const char *, const char *, void *,
   void (*)(const GenUtils_BinaryTreeKeyValue *, void *));
 
-// Auxiliar internal function for postorder tree traversal.
-static void GenUtils_BinaryTreeInternalPostorder(
-  GenUtils_DoubleNode *, void *,
-  void (*)(const GenUtils_BinaryTreeKeyValue *, void *));
+// Internal function to move a cursor to the first node of
+// a subtree in a direction.
+static bool GenUtils_BinaryTreeInternalCursorEdge(
+  GenUtils_BinaryTreeCursor *, GenUtils_DoubleNode *, int);
+
+// Internal function to move a cursor to the next node in a
+// direction.
+static bool GenUtils_BinaryTreeInternalCursorStep(
+  GenUtils_BinaryTreeCursor *, int);
+
+// Internal function to search the node of a key.
+static GenUtils_BinaryTreeInternalNode *
+  GenUtils_BinaryTreeInternalFind(
+    GenUtils_BinaryTree *, const char *);
+
+// Internal function to remove a key, storing its value.
+static bool GenUtils_BinaryTreeInternalRemove(
+  GenUtils_BinaryTree *, const char *, void **);
+
+// Internal function to release a binary tree and all its
+// nodes without resetting its allocator.
+static void GenUtils_BinaryTreeInternalRelease(
+  GenUtils_BinaryTree *);
+
+// Internal function to build a perfectly balanced subtree
+// from a sorted array.
+static bool GenUtils_BinaryTreeInternalBuild(
+  GenUtils_BinaryTree *, GenUtils_DoubleNode **,
+  GenUtils_BinaryTreeKeyValue *, size_t, size_t, size_t);
+
+// Internal function to create the key arena of a tree.
+static bool GenUtils_BinaryTreeInternalCreateKeyArena(
+  GenUtils_BinaryTree *, size_t);
+
+// Internal function to copy the keys of a tree in order to
+// a block, making the nodes point to the copies.
+static void GenUtils_BinaryTreeInternalCopyKeys(
+  GenUtils_BinaryTree *, char *, size_t *);
+
+// Internal function to copy a key to the key arena of a
+// tree.
+static const char *GenUtils_BinaryTreeInternalAddKey(
+  GenUtils_BinaryTree *, const char *, size_t);
+
+// Internal function to add a block to the key arena of a
+// tree.
+static bool GenUtils_BinaryTreeInternalAddKeyBlock(
+  GenUtils_BinaryTree *, size_t);
+
+// Internal function to release a chain of key blocks.
+static void GenUtils_BinaryTreeInternalFreeKeyBlocks(
+  GenUtils_BinaryTree *, GenUtils_BinaryTreeKeyBlock *);
+
+// Get a pointer to the child link of a node. Direction 0 is
+// the left child and 1 is the right child.
+static inline GenUtils_DoubleNode **
+  GenUtils_BinaryTreeInternalLink(
+    GenUtils_BinaryTreeInternalNode *node, int direction)
+{
+  return direction ? &node->links.second
+                   : &node->links.first;
+}
+
+// Pack the first bytes of a key in big-endian order, so
+// the prefixes compare like the keys, and get its length.
+static inline uint64_t GenUtils_BinaryTreeInternalPrefix(
+  const char *key, size_t *keyLength)
+{
+  // The prefix of the key.
+  uint64_t prefix = 0;
+  // The number of bytes read from the key.
+  size_t length = 0;
+  // Short keys are padded with zeros.
+  for (size_t i = 0; i < GENUTILS_BINARY_TREE_PREFIX_SIZE;
+       i++)
+  {
+    prefix <<= 8;
+    if (key[length] != '\0')
+    {
+      prefix |= (unsigned char)key[length];
+      length++;
+    }
+  }
+  if (length == GENUTILS_BINARY_TREE_PREFIX_SIZE)
+  {
+    length += strlen(key + length);
+  }
+  *keyLength = length;
+  return prefix;
+}
+
+// Store a key/value pair in a node with its prefix.
+static inline void GenUtils_BinaryTreeInternalSetKey(
+  GenUtils_BinaryTreeInternalNode *node,
+  GenUtils_BinaryTreeKeyValue keyValue)
+{
+  node->keyValue = keyValue;
+  node->prefix = GenUtils_BinaryTreeInternalPrefix(
+    keyValue.key, &node->keyLength);
+  node->links.userdata = &node->keyValue;
+}
+
+// Compare a key with the key of a node, like strcmp. The
+// keys are only read when the prefixes are equal, and then
+// both have more than GENUTILS_BINARY_TREE_PREFIX_SIZE
+// bytes or they're the same key.
+static inline int GenUtils_BinaryTreeInternalCompare(
+  uint64_t prefix, const char *key, size_t keyLength,
+  const GenUtils_BinaryTreeInternalNode *node)
+{
+  // The length of the shorter key.
+  size_t length =
+    keyLength < node->keyLength ? keyLength
+                                : node->keyLength;
+  // Result of the comparison of the suffixes.
+  int comparison = 0;
+  if (prefix != node->prefix)
+  {
+    return prefix < node->prefix ? -1 : 1;
+  }
+  if (length > GENUTILS_BINARY_TREE_PREFIX_SIZE)
+  {
+    comparison = memcmp(
+      key + GENUTILS_BINARY_TREE_PREFIX_SIZE,
+      node->keyValue.key + GENUTILS_BINARY_TREE_PREFIX_SIZE,
+      length - GENUTILS_BINARY_TREE_PREFIX_SIZE);
+    if (comparison != 0)
+    {
+      return comparison;
+    }
+  }
+  return (keyLength > node->keyLength) -
+    (keyLength < node->keyLength);
+}
+
+// Get the child of a node in a direction.
+static inline GenUtils_BinaryTreeInternalNode *
+  GenUtils_BinaryTreeInternalChild(
+    GenUtils_BinaryTreeInternalNode *node, int direction)
+{
+  return (GenUtils_BinaryTreeInternalNode *)(*(
+    GenUtils_BinaryTreeInternalLink(node, direction)));
+}
+
+// Check if a node is red. NULL nodes are black.
+static inline bool GenUtils_BinaryTreeInternalIsRed(
+  GenUtils_BinaryTreeInternalNode *node)
+{
+  return node != NULL && node->red;
+}
+
+// Get the number of nodes of a subtree in a tree that
+// counts them.
+static inline size_t GenUtils_BinaryTreeInternalCount(
+  GenUtils_BinaryTreeInternalNode *node)
+{
+  return node != NULL ? node->count[0] : 0;
+}
+
+// Get the size of the nodes of a tree.
+static inline size_t GenUtils_BinaryTreeInternalNodeSize(
+  GenUtils_BinaryTree *binaryTree)
+{
+  return sizeof(GenUtils_BinaryTreeInternalNode) +
+    (binaryTree->counted ? sizeof(size_t) : 0);
+}
+
+// Rotate a subtree in a direction and return its new root.
+// The child in the opposite direction becomes the root.
+static GenUtils_BinaryTreeInternalNode *
+  GenUtils_BinaryTreeInternalRotate(
+    GenUtils_BinaryTree *binaryTree,
+    GenUtils_BinaryTreeInternalNode *root, int direction)
+{
+  // The node that will be the new root.
+  GenUtils_BinaryTreeInternalNode *save =
+    GenUtils_BinaryTreeInternalChild(root, !direction);
+  *GenUtils_BinaryTreeInternalLink(root, !direction) =
+    *GenUtils_BinaryTreeInternalLink(save, direction);
+  *GenUtils_BinaryTreeInternalLink(save, direction) =
+    &root->links;
+  // The new root have all the nodes of the subtree, and
+  // the old root lost the ones of the other side.
+  if (binaryTree->counted)
+  {
+    save->count[0] = root->count[0];
+    root->count[0] = 1 +
+      GenUtils_BinaryTreeInternalCount(
+        GenUtils_BinaryTreeInternalChild(root, 0)) +
+      GenUtils_BinaryTreeInternalCount(
+        GenUtils_BinaryTreeInternalChild(root, 1));
+  }
+  return save;
+}
+
+// Replace the link to a subtree in its parent, or the root
+// of the tree if it doesn't have a parent.
+static inline void GenUtils_BinaryTreeInternalReplace(
+  GenUtils_BinaryTree *binaryTree,
+  GenUtils_BinaryTreeInternalNode *parent, int direction,
+  GenUtils_BinaryTreeInternalNode *node)
+{
+  if (parent == NULL)
+  {
+    binaryTree->root = &node->links;
+  }
+  else
+  {
+    *GenUtils_BinaryTreeInternalLink(parent, direction) =
+      &node->links;
+  }
+}
+
+// Get memory for a new node, from the pool of the tree if
+// it have one.
+static inline GenUtils_BinaryTreeInternalNode *
+  GenUtils_BinaryTreeInternalNewNode(
+    GenUtils_BinaryTree *binaryTree)
+{
+  if (binaryTree->pool != NULL)
+  {
+    return GenUtils_PoolAlloc(binaryTree->pool);
+  }
+  return GenUtils_AllocatorAlloc(binaryTree->allocator,
+    GenUtils_BinaryTreeInternalNodeSize(binaryTree));
+}
+
+// Release the memory of a node.
+static inline void GenUtils_BinaryTreeInternalDeleteNode(
+  GenUtils_BinaryTree *binaryTree,
+  GenUtils_BinaryTreeInternalNode *node)
+{
+  if (binaryTree->pool != NULL)
+  {
+    GenUtils_PoolFree(binaryTree->pool, node);
+  }
+  else
+  {
+    GenUtils_AllocatorFree(binaryTree->allocator, node,
+      GenUtils_BinaryTreeInternalNodeSize(binaryTree));
+  }
+}
 
 // Create a binary tree.
 GenUtils_BinaryTree *GenUtils_BinaryTreeCreate()
+{
+  return GenUtils_BinaryTreeCreateWithAllocator(NULL);
+}
+
+// Create a binary tree that uses an allocator.
+GenUtils_BinaryTree *
+  GenUtils_BinaryTreeCreateWithAllocator(
+    const GenUtils_Allocator *allocator)
 {
   // Binary tree to create.
-  GenUtils_BinaryTree *binaryTree =
-    malloc(sizeof(GenUtils_BinaryTree));
+  GenUtils_BinaryTree *binaryTree = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_BinaryTree));
   if (binaryTree != NULL)
   {
     binaryTree->root = NULL;
     binaryTree->size = 0;
+    binaryTree->pool = NULL;
+    binaryTree->keyArena = NULL;
+    binaryTree->counted = false;
+    binaryTree->allocator = allocator;
+  }
+  return binaryTree;
+}
+
+// Create a binary tree with some options.
+GenUtils_BinaryTree *GenUtils_BinaryTreeCreateWithOptions(
+  const GenUtils_BinaryTreeOptions *options)
+{
+  // Binary tree to create.
+  GenUtils_BinaryTree *binaryTree = NULL;
+  if (options == NULL)
+  {
+    return GenUtils_BinaryTreeCreateWithAllocator(NULL);
+  }
+  binaryTree = GenUtils_BinaryTreeCreateWithAllocator(
+    options->allocator);
+  if (binaryTree == NULL)
+  {
+    return NULL;
+  }
+  // The size of the nodes depends on the counts, so they
+  // are set before creating the pool.
+  binaryTree->counted = options->counted;
+  if (options->pool)
+  {
+    binaryTree->pool = GenUtils_PoolCreateWithAllocator(
+      GenUtils_BinaryTreeInternalNodeSize(binaryTree),
+      options->poolHint, options->allocator);
+    if (binaryTree->pool == NULL)
+    {
+      GenUtils_AllocatorFree(options->allocator, binaryTree,
+        sizeof(GenUtils_BinaryTree));
+      return NULL;
+    }
+  }
+  if (options->keyArena &&
+      !GenUtils_BinaryTreeInternalCreateKeyArena(
+        binaryTree, options->keyArenaHint))
+  {
+    GenUtils_BinaryTreeInternalRelease(binaryTree);
+    return NULL;
   }
   return binaryTree;
 }
@@ -59,10 +381,18 @@ GenUtils_BinaryTree *GenUtils_BinaryTreeCreate()
 void GenUtils_BinaryTreeDestroy(
   GenUtils_BinaryTree *binaryTree)
 {
-  // Deletes all its nodes.
-  GenUtils_BinaryTreeClear(binaryTree);
-  // Free the used memory.
-  free(binaryTree);
+  // Check the tree.
+  if (!GenUtils_BinaryTreeWasInit(binaryTree))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the tree and
+  // all its nodes at once.
+  if (GenUtils_AllocatorReset(binaryTree->allocator))
+  {
+    return;
+  }
+  GenUtils_BinaryTreeInternalRelease(binaryTree);
 }
 
 // Check if a binary tree was initialized.
@@ -103,109 +433,39 @@ bool GenUtils_BinaryTreeEmpty(
 bool GenUtils_BinaryTreeExist(
   GenUtils_BinaryTree *binaryTree, const char *key)
 {
-  // Current node being processed.
-  GenUtils_DoubleNode *currentNode =
-    GenUtils_BinaryTreeRoot(binaryTree);
-  // Current key/value pair.
-  GenUtils_BinaryTreeKeyValue *keyValue = NULL;
-  // Key's comparison result.
-  int comparison = 0;
-  // Search the key/value pair
-  while (currentNode != NULL)
-  {
-    keyValue = currentNode->userdata;
-    comparison = strcmp(keyValue->key, key);
-    if (comparison < 0)
-    {
-      // If the current key is greater than the searched
-      // key, look in the left subtree.
-      currentNode = currentNode->first;
-    }
-    else if (comparison > 0)
-    {
-      // If is lesser, look in the right subtree.
-      currentNode = currentNode->second;
-    }
-    else
-    {
-      // If is found, return true.
-      return true;
-    }
-  }
-  return false;
+  return GenUtils_BinaryTreeInternalFind(binaryTree, key) !=
+         NULL;
 }
 
 // Get the value of a key if exists.
 void *GenUtils_BinaryTreeGet(
   GenUtils_BinaryTree *binaryTree, const char *key)
 {
-  // Current node being processed.
-  GenUtils_DoubleNode *currentNode =
-    GenUtils_BinaryTreeRoot(binaryTree);
-  // Current key/value pair.
-  GenUtils_BinaryTreeKeyValue *keyValue = NULL;
-  // Key's comparison result.
-  int comparison = 0;
-  // Search the key/value pair
-  while (currentNode != NULL)
+  // The node of the key.
+  GenUtils_BinaryTreeInternalNode *node =
+    GenUtils_BinaryTreeInternalFind(binaryTree, key);
+  if (node == NULL)
   {
-    keyValue = currentNode->userdata;
-    comparison = strcmp(keyValue->key, key);
-    if (comparison < 0)
-    {
-      // If the current key is greater than the searched
-      // key, look in the left subtree.
-      currentNode = currentNode->first;
-    }
-    else if (comparison > 0)
-    {
-      // If is lesser, look in the right subtree.
-      currentNode = currentNode->second;
-    }
-    else
-    {
-      // If is found, return its value.
-      return currentNode->userdata;
-    }
+    return NULL;
   }
-  return NULL;
+  return node->keyValue.value;
 }
 
 // Set the value of a key if exists.
 bool GenUtils_BinaryTreeSet(GenUtils_BinaryTree *binaryTree,
   GenUtils_BinaryTreeKeyValue keyValue)
 {
-  // Current node being processed.
-  GenUtils_DoubleNode *currentNode =
-    GenUtils_BinaryTreeRoot(binaryTree);
-  // Current key/value pair.
-  GenUtils_BinaryTreeKeyValue *currentKeyValue = NULL;
-  // Key's comparison result.
-  int comparison = 0;
-  // Search the key/value pair
-  while (currentNode != NULL)
+  // The node of the key.
+  GenUtils_BinaryTreeInternalNode *node =
+    GenUtils_BinaryTreeInternalFind(
+      binaryTree, keyValue.key);
+  if (node == NULL)
   {
-    currentKeyValue = currentNode->userdata;
-    comparison = strcmp(keyValue.key, currentKeyValue->key);
-    if (comparison < 0)
-    {
-      // If the current key is greater than the searched
-      // key, look in the left subtree.
-      currentNode = currentNode->first;
-    }
-    else if (comparison > 0)
-    {
-      // If is lesser, look in the right subtree.
-      currentNode = currentNode->second;
-    }
-    else
-    {
-      // If is found, set the new value.
-      currentKeyValue->value = keyValue.value;
-      return true;
-    }
+    return false;
   }
-  return false;
+  // If is found, set the new value.
+  node->keyValue.value = keyValue.value;
+  return true;
 }
 
 // Get the root node of a binary tree.
@@ -224,429 +484,788 @@ bool GenUtils_BinaryTreeInsert(
   GenUtils_BinaryTree *binaryTree,
   GenUtils_BinaryTreeKeyValue keyValue)
 {
+  // Nodes from the root to the insertion point.
+  GenUtils_BinaryTreeInternalNode
+    *path[GENUTILS_BINARY_TREE_MAX_HEIGHT];
+  // Direction taken in every node of the path.
+  int directions[GENUTILS_BINARY_TREE_MAX_HEIGHT];
+  // Number of nodes in the path.
+  size_t depth = 0;
   // The node being processed.
-  GenUtils_DoubleNode *currentNode =
-    GenUtils_BinaryTreeRoot(binaryTree);
-  // Store the current key/value pair.
-  GenUtils_BinaryTreeKeyValue *currentKeyValue = NULL;
+  GenUtils_BinaryTreeInternalNode *currentNode = NULL;
+  // The new node.
+  GenUtils_BinaryTreeInternalNode *newNode = NULL;
+  // Parent, grandparent and uncle of the node being fixed.
+  GenUtils_BinaryTreeInternalNode *parent = NULL;
+  GenUtils_BinaryTreeInternalNode *grandparent = NULL;
+  GenUtils_BinaryTreeInternalNode *uncle = NULL;
+  // Direction of the parent from the grandparent.
+  int direction = 0;
   // Result of string comparison.
   int comparison = 0;
-  // Look in the tree to insert a leaf if possible.
+  // Prefix and length of the key.
+  uint64_t prefix = 0;
+  size_t keyLength = 0;
+  // Check the arguments.
+  if (!GenUtils_BinaryTreeWasInit(binaryTree) ||
+      keyValue.key == NULL)
+  {
+    return false;
+  }
+  prefix = GenUtils_BinaryTreeInternalPrefix(
+    keyValue.key, &keyLength);
+  // Look in the tree for the insertion point.
+  currentNode =
+    (GenUtils_BinaryTreeInternalNode *)binaryTree->root;
   while (currentNode != NULL)
   {
-    // Set the current key/value pair.
-    currentKeyValue = currentNode->userdata;
-    // Make a string comparison.
-    comparison = strcmp(currentKeyValue->key, keyValue.key);
+    comparison = GenUtils_BinaryTreeInternalCompare(
+      prefix, keyValue.key, keyLength, currentNode);
     if (comparison == 0)
     {
       // If the key is found, return false.
       return false;
     }
-    else if (comparison < 0)
+    path[depth] = currentNode;
+    directions[depth] = comparison > 0;
+    currentNode = GenUtils_BinaryTreeInternalChild(
+      currentNode, directions[depth]);
+    depth++;
+  }
+  // Create the new node, it's red by default.
+  newNode = GenUtils_BinaryTreeInternalNewNode(binaryTree);
+  if (newNode == NULL)
+  {
+    return false;
+  }
+  newNode->keyValue = keyValue;
+  if (binaryTree->keyArena != NULL)
+  {
+    newNode->keyValue.key =
+      GenUtils_BinaryTreeInternalAddKey(
+        binaryTree, keyValue.key, keyLength);
+    if (newNode->keyValue.key == NULL)
     {
-      // If there isn't a left child, insert a new node.
-      if (currentNode->first == NULL)
-      {
-        currentNode->first =
-          malloc(sizeof(GenUtils_DoubleNode));
-        // Returns if it can't allocate memory.
-        if (currentNode->first == NULL)
-        {
-          return false;
-        }
-        // Initialize the node.
-        currentNode->first->first = NULL;
-        currentNode->first->second = NULL;
-        binaryTree->size++;
-        return true;
-      }
-      else
-      {
-        // If the right node is used, follows it.
-        currentNode = currentNode->first;
-      }
+      GenUtils_BinaryTreeInternalDeleteNode(
+        binaryTree, newNode);
+      return false;
     }
-    else
+  }
+  newNode->links.userdata = &newNode->keyValue;
+  newNode->prefix = prefix;
+  newNode->keyLength = keyLength;
+  // Every node of the path have a new node in its subtree.
+  if (binaryTree->counted)
+  {
+    newNode->count[0] = 1;
+    for (size_t i = 0; i < depth; i++)
     {
-      // If there isn't a right child, insert a new node.
-      if (currentNode->second == NULL)
-      {
-        currentNode->second =
-          malloc(sizeof(GenUtils_DoubleNode));
-        // Returns if it can't allocate memory.
-        if (currentNode->second == NULL)
-        {
-          return false;
-        }
-        // Initialize the node.
-        currentNode->second->first = NULL;
-        currentNode->second->second = NULL;
-        binaryTree->size++;
-        return true;
-      }
-      else
-      {
-        // If the left node is used, follows it.
-        currentNode = currentNode->second;
-      }
+      path[i]->count[0]++;
     }
   }
-  return false;
+  newNode->links.first = NULL;
+  newNode->links.second = NULL;
+  newNode->red = true;
+  GenUtils_BinaryTreeInternalReplace(binaryTree,
+    depth > 0 ? path[depth - 1] : NULL,
+    depth > 0 ? directions[depth - 1] : 0, newNode);
+  binaryTree->size++;
+  // Fix red-red violations going up. The root is black, so
+  // a red parent always have a parent.
+  while (depth >= 2 &&
+         GenUtils_BinaryTreeInternalIsRed(path[depth - 1]))
+  {
+    parent = path[depth - 1];
+    grandparent = path[depth - 2];
+    direction = directions[depth - 2];
+    uncle = GenUtils_BinaryTreeInternalChild(
+      grandparent, !direction);
+    if (GenUtils_BinaryTreeInternalIsRed(uncle))
+    {
+      // A red uncle only needs a color flip, then continue
+      // with the grandparent.
+      parent->red = false;
+      uncle->red = false;
+      grandparent->red = true;
+      depth -= 2;
+      continue;
+    }
+    // If the node is an inner child, move it outside.
+    if (directions[depth - 1] != direction)
+    {
+      parent = GenUtils_BinaryTreeInternalRotate(
+        binaryTree, parent, direction);
+      *GenUtils_BinaryTreeInternalLink(
+        grandparent, direction) = &parent->links;
+    }
+    // Rotate the grandparent to the other side.
+    parent->red = false;
+    grandparent->red = true;
+    GenUtils_BinaryTreeInternalReplace(binaryTree,
+      depth > 2 ? path[depth - 3] : NULL,
+      depth > 2 ? directions[depth - 3] : 0,
+      GenUtils_BinaryTreeInternalRotate(
+        binaryTree, grandparent, !direction));
+    break;
+  }
+  // The root is always black.
+  ((GenUtils_BinaryTreeInternalNode *)binaryTree->root)
+    ->red = false;
+  return true;
 }
 
 // Remove a node from a binary tree.
 void *GenUtils_BinaryTreeRemove(
   GenUtils_BinaryTree *binaryTree, const char *key)
 {
-  // Current node being processed.
-  GenUtils_DoubleNode *currentNode =
-    GenUtils_BinaryTreeRoot(binaryTree);
-  // Previous node.
-  GenUtils_DoubleNode *previousNode = NULL;
-  // The node that will replace the node.
-  GenUtils_DoubleNode *replaceNode = NULL;
-  // The node previous to replace node.
-  GenUtils_DoubleNode *previousReplaceNode = NULL;
-  // Pair of current key/value node.
-  GenUtils_BinaryTreeKeyValue *keyValue = NULL;
-  // String comparison result.
-  int comparison = 0;
   // The value to return.
   void *value = NULL;
-  // Search the key.
-  while (currentNode != NULL)
+  GenUtils_BinaryTreeInternalRemove(
+    binaryTree, key, &value);
+  return value;
+}
+
+// Remove a node from a binary tree.
+bool GenUtils_BinaryTreeRemoveBool(
+  GenUtils_BinaryTree *binaryTree, const char *key)
+{
+  return GenUtils_BinaryTreeInternalRemove(
+    binaryTree, key, NULL);
+}
+
+// Make and return a sorted array from a binary tree.
+GenUtils_BinaryTreeKeyValue *GenUtils_BinaryTreeToArray(
+  GenUtils_BinaryTree *tree)
+{
+  // Information of the array to create.
+  GenUtils_BinaryTreeInternalArrayInfo arrayInfo = {0};
+  // Create the array.
+  arrayInfo.array =
+    malloc(sizeof(GenUtils_BinaryTreeKeyValue) *
+           GenUtils_BinaryTreeGetSize(tree));
+  // If can't create the array, return NULL.
+  if (arrayInfo.array == NULL)
   {
-    // Get the current key/value pair of the current node.
-    keyValue = currentNode->userdata;
-    // Compare the keys.
-    comparison = strcmp(key, keyValue->key);
-    // Cases for key comparison.
-    if (comparison < 0)
-    {
-      previousNode = currentNode;
-      currentNode = currentNode->first;
-    }
-    else if (comparison > 0)
-    {
-      previousNode = currentNode;
-      currentNode = currentNode->second;
-    }
-    else
-    {
-      // If the key is found, break the loop.
-      break;
-    }
+    return NULL;
   }
-  // If the key is not found, return false.
-  if (currentNode == NULL)
+  // Make the inorder traversal with internal function.
+  GenUtils_BinaryTreeInorder(
+    tree, &arrayInfo, GenUtils_BinaryTreeInternalToArray);
+  // Return the array.
+  return arrayInfo.array;
+}
+
+// Make a binary tree from an array.
+GenUtils_BinaryTree *GenUtils_BinaryTreeFromArray(
+  GenUtils_BinaryTreeKeyValue *array, size_t size)
+{
+  // The options of the tree.
+  GenUtils_BinaryTreeOptions options = {0};
+  options.pool = true;
+  return GenUtils_BinaryTreeFromArrayWithOptions(
+    array, size, &options);
+}
+
+// Make a binary tree with some options from an array.
+GenUtils_BinaryTree *
+  GenUtils_BinaryTreeFromArrayWithOptions(
+    GenUtils_BinaryTreeKeyValue *array, size_t size,
+    const GenUtils_BinaryTreeOptions *options)
+{
+  // Make a binary tree.
+  GenUtils_BinaryTree *binaryTree = NULL;
+  // The options of the tree, with room for all the nodes
+  // and keys.
+  GenUtils_BinaryTreeOptions sized = {0};
+  // The number of bytes of the keys.
+  size_t keysSize = 0;
+  // Depth of the red nodes, the last level if incomplete.
+  size_t redDepth = 0;
+  // Check the array, its keys must be strictly sorted.
+  if (size > 0 && array == NULL)
   {
-    return false;
+    return NULL;
   }
-  // If the node have almost one child.
-  if (currentNode->first == NULL ||
-      currentNode->second == NULL)
+  for (size_t i = 0; i < size; i++)
   {
-    // Set the replace node to left if exists.
-    if (currentNode->first != NULL)
-    {
-      replaceNode = currentNode->first;
-    }
-    else
+    if (array[i].key == NULL ||
+        (i > 0 &&
+          strcmp(array[i - 1].key, array[i].key) >= 0))
     {
-      // Set the replace node to right, even if it's NULL.
-      replaceNode = currentNode->second;
+      return NULL;
     }
-    // If the node to delete is the root node, set a new
-    // root node.
-    if (previousNode == NULL)
+  }
+  if (options != NULL)
+  {
+    sized = *options;
+  }
+  // The first chunk of the pool and the first block of the
+  // arena have room for all the nodes and keys, so both
+  // are allocated in a single block.
+  if (sized.poolHint < size)
+  {
+    sized.poolHint = size;
+  }
+  if (sized.keyArena)
+  {
+    for (size_t i = 0; i < size; i++)
     {
-      binaryTree->root = replaceNode;
+      keysSize += strlen(array[i].key) + 1;
     }
-    else if (currentNode == previousNode->first)
+    if (sized.keyArenaHint < keysSize)
     {
-      // Set the pointer to the current node as the replace
-      // node.
-      previousNode->first = replaceNode;
+      sized.keyArenaHint = keysSize;
     }
-    else
-    {
-      // Same as before, but with the right node.
-      previousNode->second = replaceNode;
-    }
-    // Free the node.
-    free(currentNode);
+  }
+  binaryTree = GenUtils_BinaryTreeCreateWithOptions(&sized);
+  if (binaryTree == NULL)
+  {
+    return NULL;
+  }
+  // Levels above floor(log2(size + 1)) are complete, the
+  // nodes below them are red.
+  for (size_t n = size + 1; n > 1; n /= 2)
+  {
+    redDepth++;
+  }
+  binaryTree->size = size;
+  if (!GenUtils_BinaryTreeInternalBuild(binaryTree,
+        &binaryTree->root, array, size, 0, redDepth))
+  {
+    GenUtils_BinaryTreeInternalRelease(binaryTree);
+    return NULL;
+  }
+  // The keys are copied in order, after the nodes point to
+  // the keys of the array.
+  if (binaryTree->keyArena != NULL &&
+      binaryTree->keyArena->block != NULL)
+  {
+    GenUtils_BinaryTreeInternalCopyKeys(binaryTree,
+      binaryTree->keyArena->block->data,
+      &binaryTree->keyArena->used);
+    binaryTree->keyArena->size =
+      binaryTree->keyArena->used;
+  }
+  return binaryTree;
+}
+
+// Make a balanced binary tree.
+GenUtils_BinaryTree *GenUtils_BinaryTreeBalance(
+  GenUtils_BinaryTree *binaryTree)
+{
+  // Sorted array of key/value pairs.
+  GenUtils_BinaryTreeKeyValue *array = NULL;
+  // The balanced tree.
+  GenUtils_BinaryTree *balancedTree = NULL;
+  // The options of the tree.
+  GenUtils_BinaryTreeOptions options = {0};
+  // Make the sorted array.
+  array = GenUtils_BinaryTreeToArray(binaryTree);
+  if (array == NULL)
+  {
+    return NULL;
+  }
+  // The new tree has the options of the old one. It copies
+  // the keys to its own arena, without the removed ones.
+  options.allocator = binaryTree->allocator;
+  options.pool = binaryTree->pool != NULL;
+  options.keyArena = binaryTree->keyArena != NULL;
+  options.counted = binaryTree->counted;
+  balancedTree = GenUtils_BinaryTreeFromArrayWithOptions(
+    array, binaryTree->size, &options);
+  // Return the new tree. The old tree is released node by
+  // node, since resetting its allocator would release the
+  // new tree too.
+  free(array);
+  if (balancedTree != NULL)
+  {
+    GenUtils_BinaryTreeInternalRelease(binaryTree);
+  }
+  return balancedTree;
+}
+
+// Removes all the nodes of a binary tree.
+void GenUtils_BinaryTreeClear(
+  GenUtils_BinaryTree *binaryTree)
+{
+  // Check the tree.
+  if (!GenUtils_BinaryTreeWasInit(binaryTree))
+  {
+    return;
+  }
+  // Clear the tree, the nodes in a pool are released at
+  // once.
+  if (binaryTree->pool != NULL)
+  {
+    GenUtils_PoolReset(binaryTree->pool);
   }
   else
   {
-    // If the node have two childs.
-    replaceNode = currentNode->first;
-    while (replaceNode->second != NULL)
-    {
-      previousReplaceNode = replaceNode;
-      replaceNode = replaceNode->second;
-    }
-    // Case depending on the previous node.
-    if (previousNode == NULL)
-    {
-      // If the node to replace is the rootv set it as the
-      // root.
-      binaryTree->root = replaceNode;
-    }
-    else if (previousNode->first == currentNode)
+    GenUtils_BinaryTreeInternalClear(
+      binaryTree, binaryTree->root);
+  }
+  // Reset all the values. The keys in the arena are
+  // released at once, keeping only the last block.
+  binaryTree->root = NULL;
+  binaryTree->size = 0;
+  if (binaryTree->keyArena != NULL)
+  {
+    if (binaryTree->keyArena->block != NULL)
     {
-      previousNode->first = replaceNode;
+      GenUtils_BinaryTreeInternalFreeKeyBlocks(binaryTree,
+        binaryTree->keyArena->block->previous);
+      binaryTree->keyArena->block->previous = NULL;
     }
-    else
+    binaryTree->keyArena->used = 0;
+    binaryTree->keyArena->size = 0;
+    binaryTree->keyArena->garbage = 0;
+  }
+}
+
+// Preorder traversal.
+void GenUtils_BinaryTreePreorder(
+  GenUtils_BinaryTree *binaryTree, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  // Nodes waiting to be visited. Every level of the tree
+  // adds at most one right child and the left child of the
+  // visited node.
+  GenUtils_DoubleNode
+    *stack[GENUTILS_BINARY_TREE_MAX_HEIGHT + 1];
+  // Number of nodes in the stack.
+  size_t size = 0;
+  // The node being visited.
+  GenUtils_DoubleNode *node =
+    GenUtils_BinaryTreeRoot(binaryTree);
+  if (node == NULL || function == NULL)
+  {
+    return;
+  }
+  stack[size++] = node;
+  while (size > 0)
+  {
+    node = stack[--size];
+    function(node->userdata, extradata);
+    if (node->second != NULL)
     {
-      previousNode->second = replaceNode;
+      stack[size++] = node->second;
     }
-    // Set the new links of the replacing node.
-    if (previousReplaceNode == NULL)
+    if (node->first != NULL)
     {
-      previousReplaceNode = currentNode->first;
+      stack[size++] = node->first;
     }
-    previousReplaceNode->second = replaceNode->first;
-    replaceNode->first = currentNode->first;
-    replaceNode->second = currentNode->second;
-    free(currentNode);
   }
-  // Reduce the size of the tree.
-  binaryTree->size--;
-  return keyValue->value;
 }
 
-// Remove a node from a binary tree.
-bool GenUtils_BinaryTreeRemoveBool(
-  GenUtils_BinaryTree *binaryTree, const char *key)
+// Inorder traversal.
+void GenUtils_BinaryTreeInorder(
+  GenUtils_BinaryTree *binaryTree, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
 {
-  // Current node being processed.
-  GenUtils_DoubleNode *currentNode =
+  // Cursor of the tree.
+  GenUtils_BinaryTreeCursor cursor;
+  // Whether the cursor is at a node.
+  bool valid = false;
+  if (function == NULL)
+  {
+    return;
+  }
+  valid =
+    GenUtils_BinaryTreeCursorFirst(&cursor, binaryTree);
+  while (valid)
+  {
+    function(
+      cursor.path[cursor.depth - 1]->userdata, extradata);
+    valid = GenUtils_BinaryTreeCursorNext(&cursor);
+  }
+}
+
+// Postorder traversal.
+void GenUtils_BinaryTreePostorder(
+  GenUtils_BinaryTree *binaryTree, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  // Nodes from the root to the current node.
+  GenUtils_DoubleNode
+    *stack[GENUTILS_BINARY_TREE_MAX_HEIGHT];
+  // Number of nodes in the stack.
+  size_t size = 0;
+  // The node being processed.
+  GenUtils_DoubleNode *node =
     GenUtils_BinaryTreeRoot(binaryTree);
-  // Previous node.
-  GenUtils_DoubleNode *previousNode = NULL;
-  // The node that will replace the node.
-  GenUtils_DoubleNode *replaceNode = NULL;
-  // The node previous to replace node.
-  GenUtils_DoubleNode *previousReplaceNode = NULL;
-  // Pair of current key/value node.
-  GenUtils_BinaryTreeKeyValue *keyValue = NULL;
-  // String comparison result.
-  int comparison = 0;
-  // Search the key.
-  while (currentNode != NULL)
+  // The last visited node.
+  GenUtils_DoubleNode *last = NULL;
+  if (function == NULL)
   {
-    // Get the current key/value pair of the current node.
-    keyValue = currentNode->userdata;
-    // Compare the keys.
-    comparison = strcmp(key, keyValue->key);
-    // Cases for key comparison.
-    if (comparison < 0)
+    return;
+  }
+  while (node != NULL || size > 0)
+  {
+    // Go down to the leftmost node of the subtree.
+    while (node != NULL)
     {
-      previousNode = currentNode;
-      currentNode = currentNode->first;
+      stack[size++] = node;
+      node = node->first;
     }
-    else if (comparison > 0)
+    node = stack[size - 1];
+    if (node->second != NULL && node->second != last)
     {
-      previousNode = currentNode;
-      currentNode = currentNode->second;
+      // Visit the right subtree before the node.
+      node = node->second;
     }
     else
     {
-      // If the key is found, break the loop.
-      break;
+      function(node->userdata, extradata);
+      last = node;
+      size--;
+      node = NULL;
     }
   }
-  // If the key is not found, return false.
-  if (currentNode == NULL)
+}
+
+// Move a cursor to the first key of a tree.
+bool GenUtils_BinaryTreeCursorFirst(
+  GenUtils_BinaryTreeCursor *cursor,
+  GenUtils_BinaryTree *binaryTree)
+{
+  if (cursor == NULL)
   {
     return false;
   }
-  // If the node have almost one child.
-  if (currentNode->first == NULL ||
-      currentNode->second == NULL)
+  cursor->binaryTree = binaryTree;
+  cursor->depth = 0;
+  return GenUtils_BinaryTreeInternalCursorEdge(
+    cursor, GenUtils_BinaryTreeRoot(binaryTree), 0);
+}
+
+// Move a cursor to the last key of a tree.
+bool GenUtils_BinaryTreeCursorLast(
+  GenUtils_BinaryTreeCursor *cursor,
+  GenUtils_BinaryTree *binaryTree)
+{
+  if (cursor == NULL)
   {
-    // Set the replace node to left if exists.
-    if (currentNode->first != NULL)
-    {
-      replaceNode = currentNode->first;
-    }
-    else
-    {
-      // Set the replace node to right, even if it's NULL.
-      replaceNode = currentNode->second;
-    }
-    // If the node to delete is the root node, set a new
-    // root node.
-    if (previousNode == NULL)
-    {
-      binaryTree->root = replaceNode;
-    }
-    else if (currentNode == previousNode->first)
-    {
-      // Set the pointer to the current node as the replace
-      // node.
-      previousNode->first = replaceNode;
-    }
-    else
+    return false;
+  }
+  cursor->binaryTree = binaryTree;
+  cursor->depth = 0;
+  return GenUtils_BinaryTreeInternalCursorEdge(
+    cursor, GenUtils_BinaryTreeRoot(binaryTree), 1);
+}
+
+// Move a cursor to the first key greater or equal to a key.
+bool GenUtils_BinaryTreeCursorSeek(
+  GenUtils_BinaryTreeCursor *cursor,
+  GenUtils_BinaryTree *binaryTree, const char *key)
+{
+  return GenUtils_BinaryTreeInternalSeek(
+    cursor, binaryTree, key, false);
+}
+
+// Get the first pair whose key is greater or equal to a
+// key.
+const GenUtils_BinaryTreeKeyValue *
+  GenUtils_BinaryTreeLowerBound(
+    GenUtils_BinaryTree *binaryTree, const char *key)
+{
+  // Cursor of the tree.
+  GenUtils_BinaryTreeCursor cursor;
+  GenUtils_BinaryTreeInternalSeek(
+    &cursor, binaryTree, key, false);
+  return GenUtils_BinaryTreeCursorGet(&cursor);
+}
+
+// Get the first pair whose key is greater than a key.
+const GenUtils_BinaryTreeKeyValue *
+  GenUtils_BinaryTreeUpperBound(
+    GenUtils_BinaryTree *binaryTree, const char *key)
+{
+  // Cursor of the tree.
+  GenUtils_BinaryTreeCursor cursor;
+  GenUtils_BinaryTreeInternalSeek(
+    &cursor, binaryTree, key, true);
+  return GenUtils_BinaryTreeCursorGet(&cursor);
+}
+
+// Iterate in order through the keys in a range.
+void GenUtils_BinaryTreeRange(
+  GenUtils_BinaryTree *binaryTree, const char *from,
+  const char *to, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  if (function == NULL)
+  {
+    return;
+  }
+  GenUtils_BinaryTreeInternalRange(
+    binaryTree, from, to, extradata, function);
+}
+
+// Iterate in order through the keys that start with a
+// prefix.
+void GenUtils_BinaryTreePrefixRange(
+  GenUtils_BinaryTree *binaryTree, const char *prefix,
+  void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  // Cursor of the tree.
+  GenUtils_BinaryTreeCursor cursor;
+  // The length of the prefix.
+  size_t prefixLength = 0;
+  // The node at the cursor.
+  GenUtils_BinaryTreeInternalNode *node = NULL;
+  if (prefix == NULL || function == NULL)
+  {
+    return;
+  }
+  prefixLength = strlen(prefix);
+  // The keys with the prefix are together, starting at the
+  // first key that isn't lesser than the prefix.
+  GenUtils_BinaryTreeInternalSeek(
+    &cursor, binaryTree, prefix, false);
+  while (cursor.depth > 0)
+  {
+    node = (GenUtils_BinaryTreeInternalNode *)
+      cursor.path[cursor.depth - 1];
+    if (node->keyLength < prefixLength ||
+        memcmp(node->keyValue.key, prefix, prefixLength) !=
+          0)
     {
-      // Same as before, but with the right node.
-      previousNode->second = replaceNode;
+      break;
     }
-    // Free the data and the node.
-    free(currentNode->userdata);
-    free(currentNode);
+    function(&node->keyValue, extradata);
+    GenUtils_BinaryTreeCursorNext(&cursor);
   }
-  else
+}
+
+// Count the keys in a range.
+size_t GenUtils_BinaryTreeRangeCount(
+  GenUtils_BinaryTree *binaryTree, const char *from,
+  const char *to)
+{
+  // The number of keys.
+  size_t count = 0;
+  // The ranks of the ends of the range.
+  size_t first = 0;
+  size_t last = 0;
+  if (!GenUtils_BinaryTreeWasInit(binaryTree))
+  {
+    return 0;
+  }
+  // The trees that count their nodes don't need to visit
+  // the range.
+  if (binaryTree->counted)
+  {
+    first = from != NULL
+      ? GenUtils_BinaryTreeRank(binaryTree, from) : 0;
+    last = to != NULL
+      ? GenUtils_BinaryTreeRank(binaryTree, to)
+      : binaryTree->size;
+    return last > first ? last - first : 0;
+  }
+  GenUtils_BinaryTreeInternalRange(
+    binaryTree, from, to, &count, NULL);
+  return count;
+}
+
+// Get the pair at a position of the order of the keys.
+const GenUtils_BinaryTreeKeyValue *
+  GenUtils_BinaryTreeSelect(
+    GenUtils_BinaryTree *binaryTree, size_t index)
+{
+  // The node being processed.
+  GenUtils_BinaryTreeInternalNode *currentNode = NULL;
+  // The number of nodes of the left subtree.
+  size_t leftCount = 0;
+  // Cursor of the trees that don't count their nodes.
+  GenUtils_BinaryTreeCursor cursor;
+  if (index >= GenUtils_BinaryTreeGetSize(binaryTree))
+  {
+    return NULL;
+  }
+  if (!binaryTree->counted)
   {
-    // If the node have two childs.
-    replaceNode = currentNode->first;
-    while (replaceNode->second != NULL)
+    GenUtils_BinaryTreeCursorFirst(&cursor, binaryTree);
+    for (size_t i = 0; i < index; i++)
     {
-      previousReplaceNode = replaceNode;
-      replaceNode = replaceNode->second;
+      GenUtils_BinaryTreeCursorNext(&cursor);
     }
-    // Case depending on the previous node.
-    if (previousNode == NULL)
+    return GenUtils_BinaryTreeCursorGet(&cursor);
+  }
+  currentNode =
+    (GenUtils_BinaryTreeInternalNode *)binaryTree->root;
+  for (;;)
+  {
+    leftCount = GenUtils_BinaryTreeInternalCount(
+      GenUtils_BinaryTreeInternalChild(currentNode, 0));
+    if (index == leftCount)
     {
-      // If the node to replace is the rootv set it as the
-      // root.
-      binaryTree->root = replaceNode;
+      return &currentNode->keyValue;
     }
-    else if (previousNode->first == currentNode)
+    if (index < leftCount)
     {
-      previousNode->first = replaceNode;
+      currentNode =
+        GenUtils_BinaryTreeInternalChild(currentNode, 0);
     }
     else
     {
-      previousNode->second = replaceNode;
+      index -= leftCount + 1;
+      currentNode =
+        GenUtils_BinaryTreeInternalChild(currentNode, 1);
     }
-    // Set the new links of the replacing node.
-    if (previousReplaceNode == NULL)
-    {
-      previousReplaceNode = currentNode->first;
-    }
-    previousReplaceNode->second = replaceNode->first;
-    replaceNode->first = currentNode->first;
-    replaceNode->second = currentNode->second;
-    free(currentNode->userdata);
-    free(currentNode);
   }
-  // Reduce the size of the tree.
-  binaryTree->size--;
-  return true;
 }
 
-// Make and return a sorted array from a binary tree.
-GenUtils_BinaryTreeKeyValue *GenUtils_BinaryTreeToArray(
-  GenUtils_BinaryTree *tree)
+// Get the number of keys lesser than a key.
+size_t GenUtils_BinaryTreeRank(
+  GenUtils_BinaryTree *binaryTree, const char *key)
 {
-  // Information of the array to create.
-  GenUtils_BinaryTreeInternalArrayInfo arrayInfo = {0};
-  // Create the array.
-  arrayInfo.array =
-    malloc(sizeof(GenUtils_BinaryTreeKeyValue) *
-           GenUtils_BinaryTreeGetSize(tree));
-  // If can't create the array, return NULL.
-  if (arrayInfo.array == NULL)
+  // The node being compared.
+  GenUtils_BinaryTreeInternalNode *currentNode = NULL;
+  // The number of lesser keys found.
+  size_t rank = 0;
+  // Key's comparison result.
+  int comparison = 0;
+  // Prefix and length of the key.
+  uint64_t prefix = 0;
+  size_t keyLength = 0;
+  if (!GenUtils_BinaryTreeWasInit(binaryTree) ||
+      key == NULL)
   {
-    return NULL;
+    return 0;
   }
-  // Make the inorder traversal with internal function.
-  GenUtils_BinaryTreeInorder(
-    tree, &arrayInfo, GenUtils_BinaryTreeInternalToArray);
-  // Return the array.
-  return arrayInfo.array;
-}
-
-// Make a binary tree from an array.
-GenUtils_BinaryTree *GenUtils_BinaryTreeFromArray(
-  GenUtils_BinaryTreeKeyValue *array, size_t size)
-{
-  // Make a binary tree.
-  GenUtils_BinaryTree *binaryTree =
-    GenUtils_BinaryTreeCreate();
-  // Insert every element in the binary tree.
-  for (size_t i = 0; i < size; i++)
+  if (!binaryTree->counted)
+  {
+    GenUtils_BinaryTreeInternalRange(
+      binaryTree, NULL, key, &rank, NULL);
+    return rank;
+  }
+  prefix =
+    GenUtils_BinaryTreeInternalPrefix(key, &keyLength);
+  currentNode =
+    (GenUtils_BinaryTreeInternalNode *)binaryTree->root;
+  while (currentNode != NULL)
   {
-    if (!GenUtils_BinaryTreeInsert(binaryTree, array[i]))
+    comparison = GenUtils_BinaryTreeInternalCompare(
+      prefix, key, keyLength, currentNode);
+    if (comparison >= 0)
     {
-      GenUtils_BinaryTreeDestroy(binaryTree);
-      return NULL;
+      // The left subtree is lesser than the key, and the
+      // node too if it isn't equal.
+      rank += GenUtils_BinaryTreeInternalCount(
+        GenUtils_BinaryTreeInternalChild(currentNode, 0));
+      if (comparison == 0)
+      {
+        break;
+      }
+      rank++;
     }
+    currentNode = GenUtils_BinaryTreeInternalChild(
+      currentNode, comparison > 0);
   }
-  return binaryTree;
+  return rank;
 }
 
-// Make a balanced binary tree.
-GenUtils_BinaryTree *GenUtils_BinaryTreeBalance(
-  GenUtils_BinaryTree *binaryTree)
+// Move a cursor to the first key greater or equal to a
+// key, or only greater if after is true.
+static bool GenUtils_BinaryTreeInternalSeek(
+  GenUtils_BinaryTreeCursor *cursor,
+  GenUtils_BinaryTree *binaryTree, const char *key,
+  bool after)
 {
-  // Sorted array of key/value pairs.
-  GenUtils_BinaryTreeKeyValue *array = NULL;
-  // The balanced tree.
-  GenUtils_BinaryTree *balancedTree = NULL;
-  // Make the sorted array.
-  array = GenUtils_BinaryTreeToArray(binaryTree);
-  // If the array was created, make the binary tree.
-  if (array != NULL)
+  // The node being compared.
+  GenUtils_BinaryTreeInternalNode *currentNode =
+    (GenUtils_BinaryTreeInternalNode *)
+      GenUtils_BinaryTreeRoot(binaryTree);
+  // Depth of the last node greater than the key.
+  size_t found = 0;
+  // Key's comparison result.
+  int comparison = 0;
+  // Prefix and length of the key.
+  uint64_t prefix = 0;
+  size_t keyLength = 0;
+  if (cursor == NULL)
   {
-    balancedTree =
-      GenUtils_BinaryTreeFromArray(array, binaryTree->size);
+    return false;
   }
-  else
+  cursor->binaryTree = binaryTree;
+  cursor->depth = 0;
+  if (key == NULL)
   {
-    return NULL;
+    return false;
   }
-  // Return the new tree.
-  free(array);
-  GenUtils_BinaryTreeDestroy(binaryTree);
-  return balancedTree;
+  prefix =
+    GenUtils_BinaryTreeInternalPrefix(key, &keyLength);
+  while (currentNode != NULL)
+  {
+    cursor->path[cursor->depth++] = &currentNode->links;
+    comparison = GenUtils_BinaryTreeInternalCompare(
+      prefix, key, keyLength, currentNode);
+    if (comparison == 0 && !after)
+    {
+      return true;
+    }
+    if (comparison < 0)
+    {
+      found = cursor->depth;
+    }
+    currentNode = GenUtils_BinaryTreeInternalChild(
+      currentNode, comparison >= 0);
+  }
+  // The path to the greater node is a prefix of the path.
+  cursor->depth = found;
+  return found > 0;
 }
 
-// Removes all the nodes of a binary tree.
-void GenUtils_BinaryTreeClear(
-  GenUtils_BinaryTree *binaryTree)
+// Move a cursor to the next key.
+bool GenUtils_BinaryTreeCursorNext(
+  GenUtils_BinaryTreeCursor *cursor)
 {
-  // Clear the tree.
-  GenUtils_BinaryTreeInternalClear(
-    GenUtils_BinaryTreeRoot(binaryTree));
-  // Reset all the values.
-  binaryTree->root = NULL;
-  binaryTree->size = 0;
+  return GenUtils_BinaryTreeInternalCursorStep(cursor, 1);
 }
 
-// Preorder traversal.
-void GenUtils_BinaryTreePreorder(
-  GenUtils_BinaryTree *binaryTree, void *extradata,
-  void (*function)(
-    const GenUtils_BinaryTreeKeyValue *, void *))
+// Move a cursor to the previous key.
+bool GenUtils_BinaryTreeCursorPrev(
+  GenUtils_BinaryTreeCursor *cursor)
 {
-  GenUtils_BinaryTreeInternalPreorder(
-    GenUtils_BinaryTreeRoot(binaryTree), extradata,
-    function);
+  return GenUtils_BinaryTreeInternalCursorStep(cursor, 0);
 }
 
-// Inorder traversal.
-void GenUtils_BinaryTreeInorder(
-  GenUtils_BinaryTree *binaryTree, void *extradata,
-  void (*function)(
-    const GenUtils_BinaryTreeKeyValue *, void *))
+// Get the key/value pair at a cursor.
+const GenUtils_BinaryTreeKeyValue *
+  GenUtils_BinaryTreeCursorGet(
+    const GenUtils_BinaryTreeCursor *cursor)
 {
-  GenUtils_BinaryTreeInternalInorder(
-    GenUtils_BinaryTreeRoot(binaryTree), extradata,
-    function);
+  if (cursor == NULL || cursor->depth == 0)
+  {
+    return NULL;
+  }
+  return cursor->path[cursor->depth - 1]->userdata;
 }
 
-// Postorder traversal.
-void GenUtils_BinaryTreePostorder(
-  GenUtils_BinaryTree *binaryTree, void *extradata,
-  void (*function)(
-    const GenUtils_BinaryTreeKeyValue *, void *))
+// Release a binary tree and all its nodes.
+static void GenUtils_BinaryTreeInternalRelease(
+  GenUtils_BinaryTree *binaryTree)
 {
-  GenUtils_BinaryTreeInternalPostorder(
-    GenUtils_BinaryTreeRoot(binaryTree), extradata,
-    function);
+  // Deletes all its nodes.
+  GenUtils_BinaryTreeClear(binaryTree);
+  // Free the used memory.
+  GenUtils_PoolDestroy(binaryTree->pool);
+  if (binaryTree->keyArena != NULL)
+  {
+    GenUtils_BinaryTreeInternalFreeKeyBlocks(
+      binaryTree, binaryTree->keyArena->block);
+    GenUtils_AllocatorFree(binaryTree->allocator,
+      binaryTree->keyArena,
+      sizeof(GenUtils_BinaryTreeKeyArena));
+  }
+  GenUtils_AllocatorFree(binaryTree->allocator, binaryTree,
+    sizeof(GenUtils_BinaryTree));
 }
 
 // Internal function, do an inorder traversal to make an
@@ -662,67 +1281,543 @@ static void GenUtils_BinaryTreeInternalToArray(
   arrayInfo->i++;
 }
 
-// Removes all the nodes of a binary tree.
+// Removes all the nodes of a binary tree. Left children
+// are rotated up until the root doesn't have one, then the
+// root is deleted, so no stack is needed.
 static void GenUtils_BinaryTreeInternalClear(
+  GenUtils_BinaryTree *binaryTree,
   GenUtils_DoubleNode *root)
 {
-  // Base case.
-  if (root != NULL)
+  // The left child being rotated, or the next root.
+  GenUtils_DoubleNode *next = NULL;
+  while (root != NULL)
   {
-    GenUtils_BinaryTreeInternalClear(root->first);
-    GenUtils_BinaryTreeInternalClear(root->second);
-    free(root->userdata);
-    free(root);
+    if (root->first != NULL)
+    {
+      next = root->first;
+      root->first = next->second;
+      next->second = root;
+    }
+    else
+    {
+      next = root->second;
+      GenUtils_BinaryTreeInternalDeleteNode(binaryTree,
+        (GenUtils_BinaryTreeInternalNode *)root);
+    }
+    root = next;
   }
 }
 
-// Auxiliar function for preorder tree traversal.
-static void GenUtils_BinaryTreeInternalPreorder(
-  GenUtils_DoubleNode *root, void *extradata,
+// Iterate through the keys in a range. Without a function,
+// the keys are counted in the size_t pointed by extradata.
+static void GenUtils_BinaryTreeInternalRange(
+  GenUtils_BinaryTree *binaryTree, const char *from,
+  const char *to, void *extradata,
   void (*function)(
     const GenUtils_BinaryTreeKeyValue *, void *))
 {
-  // Base case.
-  if (root != NULL && function != NULL)
+  // Cursor of the tree.
+  GenUtils_BinaryTreeCursor cursor;
+  // Prefix and length of the end of the range.
+  uint64_t prefix = 0;
+  size_t keyLength = 0;
+  // The node at the cursor.
+  GenUtils_BinaryTreeInternalNode *node = NULL;
+  if (from == NULL)
+  {
+    GenUtils_BinaryTreeCursorFirst(&cursor, binaryTree);
+  }
+  else
+  {
+    GenUtils_BinaryTreeInternalSeek(
+      &cursor, binaryTree, from, false);
+  }
+  if (to != NULL)
   {
-    function(root->userdata, extradata);
-    GenUtils_BinaryTreeInternalPreorder(
-      root->first, function, extradata);
-    GenUtils_BinaryTreeInternalPreorder(
-      root->second, function, extradata);
+    prefix =
+      GenUtils_BinaryTreeInternalPrefix(to, &keyLength);
+  }
+  while (cursor.depth > 0)
+  {
+    node = (GenUtils_BinaryTreeInternalNode *)
+      cursor.path[cursor.depth - 1];
+    if (to != NULL && GenUtils_BinaryTreeInternalCompare(
+                        prefix, to, keyLength, node) <= 0)
+    {
+      break;
+    }
+    if (function != NULL)
+    {
+      function(&node->keyValue, extradata);
+    }
+    else
+    {
+      (*(size_t *)extradata)++;
+    }
+    GenUtils_BinaryTreeCursorNext(&cursor);
   }
 }
 
-// Auxiliar function for inorder tree traversal.
-static void GenUtils_BinaryTreeInternalInorder(
-  GenUtils_DoubleNode *root, void *extradata,
-  void (*function)(
-    const GenUtils_BinaryTreeKeyValue *, void *))
+// Move a cursor to the first node of a subtree in a
+// direction, 0 to the leftmost and 1 to the rightmost.
+static bool GenUtils_BinaryTreeInternalCursorEdge(
+  GenUtils_BinaryTreeCursor *cursor,
+  GenUtils_DoubleNode *root, int direction)
 {
-  // Base case.
-  if (root != NULL && function != NULL)
+  while (root != NULL)
   {
-    GenUtils_BinaryTreeInternalPreorder(
-      root->first, function, extradata);
-    function(root->userdata, extradata);
-    GenUtils_BinaryTreeInternalPreorder(
-      root->second, function, extradata);
+    cursor->path[cursor->depth++] = root;
+    root = direction ? root->second : root->first;
   }
+  return cursor->depth > 0;
 }
 
-// Auxiliar function for postorder tree traversal.
-static void GenUtils_BinaryTreeInternalPostorder(
-  GenUtils_DoubleNode *root, void *extradata,
-  void (*function)(
-    const GenUtils_BinaryTreeKeyValue *, void *))
+// Move a cursor to the next node in a direction, 1 to the
+// next and 0 to the previous one.
+static bool GenUtils_BinaryTreeInternalCursorStep(
+  GenUtils_BinaryTreeCursor *cursor, int direction)
+{
+  // The current node.
+  GenUtils_DoubleNode *node = NULL;
+  // The child in the direction.
+  GenUtils_DoubleNode *child = NULL;
+  if (cursor == NULL || cursor->depth == 0)
+  {
+    return false;
+  }
+  node = cursor->path[cursor->depth - 1];
+  child = direction ? node->second : node->first;
+  if (child != NULL)
+  {
+    // The next node is the nearest of the subtree.
+    return GenUtils_BinaryTreeInternalCursorEdge(
+      cursor, child, !direction);
+  }
+  // The next node is the first ancestor reached from the
+  // other direction.
+  do
+  {
+    child = cursor->path[--cursor->depth];
+    node = cursor->depth > 0
+      ? cursor->path[cursor->depth - 1] : NULL;
+  } while (node != NULL &&
+           child == (direction ? node->second
+                               : node->first));
+  return cursor->depth > 0;
+}
+
+// Search the node of a key.
+static GenUtils_BinaryTreeInternalNode *
+  GenUtils_BinaryTreeInternalFind(
+    GenUtils_BinaryTree *binaryTree, const char *key)
+{
+  // Current node being processed.
+  GenUtils_BinaryTreeInternalNode *currentNode =
+    (GenUtils_BinaryTreeInternalNode *)
+      GenUtils_BinaryTreeRoot(binaryTree);
+  // Key's comparison result.
+  int comparison = 0;
+  // Prefix and length of the key.
+  uint64_t prefix = 0;
+  size_t keyLength = 0;
+  if (key == NULL)
+  {
+    return NULL;
+  }
+  prefix =
+    GenUtils_BinaryTreeInternalPrefix(key, &keyLength);
+  // Search the key, lesser keys are in the left subtree.
+  while (currentNode != NULL)
+  {
+    comparison = GenUtils_BinaryTreeInternalCompare(
+      prefix, key, keyLength, currentNode);
+    if (comparison == 0)
+    {
+      return currentNode;
+    }
+    currentNode = GenUtils_BinaryTreeInternalChild(
+      currentNode, comparison > 0);
+  }
+  return NULL;
+}
+
+// Remove a key from a binary tree and rebalance it.
+static bool GenUtils_BinaryTreeInternalRemove(
+  GenUtils_BinaryTree *binaryTree, const char *key,
+  void **value)
 {
+  // Nodes from the root to the removed node. It have room
+  // for an extra node added by the rotations.
+  GenUtils_BinaryTreeInternalNode
+    *path[GENUTILS_BINARY_TREE_MAX_HEIGHT + 1];
+  // Direction taken in every node of the path.
+  int directions[GENUTILS_BINARY_TREE_MAX_HEIGHT + 1];
+  // Number of nodes in the path.
+  size_t depth = 0;
+  // The node that have the key.
+  GenUtils_BinaryTreeInternalNode *currentNode = NULL;
+  // The node that will be unlinked from the tree.
+  GenUtils_BinaryTreeInternalNode *removeNode = NULL;
+  // The only child of the unlinked node.
+  GenUtils_BinaryTreeInternalNode *child = NULL;
+  // Parent and sibling of the node being fixed.
+  GenUtils_BinaryTreeInternalNode *parent = NULL;
+  GenUtils_BinaryTreeInternalNode *sibling = NULL;
+  // Direction of the node being fixed from its parent.
+  int direction = 0;
+  // String comparison result.
+  int comparison = 0;
+  // Prefix and length of the key.
+  uint64_t prefix = 0;
+  size_t keyLength = 0;
+  // Check the arguments.
+  if (!GenUtils_BinaryTreeWasInit(binaryTree) ||
+      key == NULL)
+  {
+    return false;
+  }
+  prefix =
+    GenUtils_BinaryTreeInternalPrefix(key, &keyLength);
+  // Search the key.
+  currentNode =
+    (GenUtils_BinaryTreeInternalNode *)binaryTree->root;
+  while (currentNode != NULL)
+  {
+    comparison = GenUtils_BinaryTreeInternalCompare(
+      prefix, key, keyLength, currentNode);
+    if (comparison == 0)
+    {
+      break;
+    }
+    path[depth] = currentNode;
+    directions[depth] = comparison > 0;
+    currentNode = GenUtils_BinaryTreeInternalChild(
+      currentNode, directions[depth]);
+    depth++;
+  }
+  // If the key is not found, return false.
+  if (currentNode == NULL)
+  {
+    return false;
+  }
+  if (value != NULL)
+  {
+    *value = currentNode->keyValue.value;
+  }
+  // The copy of the key is kept until the arena is
+  // compacted.
+  if (binaryTree->keyArena != NULL)
+  {
+    binaryTree->keyArena->garbage +=
+      currentNode->keyLength + 1;
+  }
+  // If the node have two childs, its successor is unlinked
+  // instead and its key/value pair is moved to this node.
+  removeNode = currentNode;
+  if (currentNode->links.first != NULL &&
+      currentNode->links.second != NULL)
+  {
+    path[depth] = currentNode;
+    directions[depth] = 1;
+    depth++;
+    removeNode =
+      GenUtils_BinaryTreeInternalChild(currentNode, 1);
+    while (removeNode->links.first != NULL)
+    {
+      path[depth] = removeNode;
+      directions[depth] = 0;
+      depth++;
+      removeNode =
+        GenUtils_BinaryTreeInternalChild(removeNode, 0);
+    }
+    currentNode->keyValue = removeNode->keyValue;
+    currentNode->prefix = removeNode->prefix;
+    currentNode->keyLength = removeNode->keyLength;
+  }
+  // Unlink the node, replacing it with its only child.
+  child = GenUtils_BinaryTreeInternalChild(removeNode,
+    removeNode->links.first == NULL);
+  if (depth == 0)
+  {
+    binaryTree->root = (GenUtils_DoubleNode *)child;
+  }
+  else
+  {
+    *GenUtils_BinaryTreeInternalLink(path[depth - 1],
+      directions[depth - 1]) = (GenUtils_DoubleNode *)child;
+  }
+  binaryTree->size--;
+  // Every node of the path lost a node of its subtree.
+  if (binaryTree->counted)
+  {
+    for (size_t i = 0; i < depth; i++)
+    {
+      path[i]->count[0]--;
+    }
+  }
+  // Removing a red node or a node with a red child that
+  // takes its color doesn't change the black height.
+  if (removeNode->red)
+  {
+    GenUtils_BinaryTreeInternalDeleteNode(
+      binaryTree, removeNode);
+    return true;
+  }
+  GenUtils_BinaryTreeInternalDeleteNode(
+    binaryTree, removeNode);
+  if (GenUtils_BinaryTreeInternalIsRed(child))
+  {
+    child->red = false;
+    return true;
+  }
+  // Fix the missing black node going up.
+  while (depth > 0)
+  {
+    parent = path[depth - 1];
+    direction = directions[depth - 1];
+    sibling =
+      GenUtils_BinaryTreeInternalChild(parent, !direction);
+    // With a red sibling, rotate to get a black one.
+    if (sibling->red)
+    {
+      sibling->red = false;
+      parent->red = true;
+      GenUtils_BinaryTreeInternalReplace(binaryTree,
+        depth > 1 ? path[depth - 2] : NULL,
+        depth > 1 ? directions[depth - 2] : 0,
+        GenUtils_BinaryTreeInternalRotate(
+          binaryTree, parent, direction));
+      path[depth - 1] = sibling;
+      directions[depth - 1] = direction;
+      path[depth] = parent;
+      directions[depth] = direction;
+      depth++;
+      sibling = GenUtils_BinaryTreeInternalChild(
+        parent, !direction);
+    }
+    // With two black nephews, recolor and go up.
+    if (!GenUtils_BinaryTreeInternalIsRed(
+          GenUtils_BinaryTreeInternalChild(sibling, 0)) &&
+        !GenUtils_BinaryTreeInternalIsRed(
+          GenUtils_BinaryTreeInternalChild(sibling, 1)))
+    {
+      sibling->red = true;
+      depth--;
+      if (parent->red)
+      {
+        parent->red = false;
+        break;
+      }
+      continue;
+    }
+    // If only the inner nephew is red, move it outside.
+    if (!GenUtils_BinaryTreeInternalIsRed(
+          GenUtils_BinaryTreeInternalChild(
+            sibling, !direction)))
+    {
+      GenUtils_BinaryTreeInternalChild(sibling, direction)
+        ->red = false;
+      sibling->red = true;
+      sibling = GenUtils_BinaryTreeInternalRotate(
+        binaryTree, sibling, !direction);
+      *GenUtils_BinaryTreeInternalLink(parent, !direction) =
+        &sibling->links;
+    }
+    // The outer nephew is red, rotate the parent.
+    sibling->red = parent->red;
+    parent->red = false;
+    GenUtils_BinaryTreeInternalChild(sibling, !direction)
+      ->red = false;
+    GenUtils_BinaryTreeInternalReplace(binaryTree,
+      depth > 1 ? path[depth - 2] : NULL,
+      depth > 1 ? directions[depth - 2] : 0,
+      GenUtils_BinaryTreeInternalRotate(
+        binaryTree, parent, direction));
+    break;
+  }
+  return true;
+}
+
+// Build a perfectly balanced subtree from a sorted array,
+// storing its root in a link. The nodes are taken in
+// preorder, so in a tree with a pool every subtree is
+// stored in contiguous memory. On error, the nodes built
+// are linked, so they can be released with the tree.
+static bool GenUtils_BinaryTreeInternalBuild(
+  GenUtils_BinaryTree *binaryTree,
+  GenUtils_DoubleNode **link,
+  GenUtils_BinaryTreeKeyValue *array, size_t size,
+  size_t depth, size_t redDepth)
+{
+  // Index of the median element.
+  size_t middle = size / 2;
+  // The root of the subtree.
+  GenUtils_BinaryTreeInternalNode *root = NULL;
+  *link = NULL;
   // Base case.
-  if (root != NULL && function != NULL)
+  if (size == 0)
   {
-    GenUtils_BinaryTreeInternalPreorder(
-      root->first, function, extradata);
-    GenUtils_BinaryTreeInternalPreorder(
-      root->second, function, extradata);
-    function(root->userdata, extradata);
+    return true;
+  }
+  root = GenUtils_BinaryTreeInternalNewNode(binaryTree);
+  if (root == NULL)
+  {
+    return false;
+  }
+  GenUtils_BinaryTreeInternalSetKey(root, array[middle]);
+  root->red = depth == redDepth;
+  if (binaryTree->counted)
+  {
+    root->count[0] = size;
+  }
+  root->links.first = NULL;
+  root->links.second = NULL;
+  *link = &root->links;
+  return GenUtils_BinaryTreeInternalBuild(binaryTree,
+           &root->links.first, array, middle, depth + 1,
+           redDepth) &&
+         GenUtils_BinaryTreeInternalBuild(binaryTree,
+           &root->links.second, array + middle + 1,
+           size - middle - 1, depth + 1, redDepth);
+}
+
+// Create the key arena of a tree.
+static bool GenUtils_BinaryTreeInternalCreateKeyArena(
+  GenUtils_BinaryTree *binaryTree, size_t capacity)
+{
+  // The arena to create.
+  GenUtils_BinaryTreeKeyArena *keyArena =
+    GenUtils_AllocatorAlloc(binaryTree->allocator,
+      sizeof(GenUtils_BinaryTreeKeyArena));
+  if (keyArena == NULL)
+  {
+    return false;
+  }
+  keyArena->block = NULL;
+  keyArena->used = 0;
+  keyArena->size = 0;
+  keyArena->garbage = 0;
+  binaryTree->keyArena = keyArena;
+  if (capacity != 0 &&
+      !GenUtils_BinaryTreeInternalAddKeyBlock(
+        binaryTree, capacity))
+  {
+    GenUtils_AllocatorFree(binaryTree->allocator, keyArena,
+      sizeof(GenUtils_BinaryTreeKeyArena));
+    binaryTree->keyArena = NULL;
+    return false;
+  }
+  return true;
+}
+
+// Add a block to the key arena of a tree, keeping the full
+// ones so their keys don't move.
+static bool GenUtils_BinaryTreeInternalAddKeyBlock(
+  GenUtils_BinaryTree *binaryTree, size_t capacity)
+{
+  // The arena of the tree.
+  GenUtils_BinaryTreeKeyArena *keyArena =
+    binaryTree->keyArena;
+  // The new block.
+  GenUtils_BinaryTreeKeyBlock *block = NULL;
+  if (capacity >
+      SIZE_MAX - sizeof(GenUtils_BinaryTreeKeyBlock))
+  {
+    return false;
+  }
+  block = GenUtils_AllocatorAlloc(binaryTree->allocator,
+    sizeof(GenUtils_BinaryTreeKeyBlock) + capacity);
+  if (block == NULL)
+  {
+    return false;
+  }
+  block->previous = keyArena->block;
+  block->capacity = capacity;
+  keyArena->block = block;
+  keyArena->used = 0;
+  return true;
+}
+
+// Release a chain of key blocks.
+static void GenUtils_BinaryTreeInternalFreeKeyBlocks(
+  GenUtils_BinaryTree *binaryTree,
+  GenUtils_BinaryTreeKeyBlock *block)
+{
+  // The block filled before the current one.
+  GenUtils_BinaryTreeKeyBlock *previous = NULL;
+  while (block != NULL)
+  {
+    previous = block->previous;
+    GenUtils_AllocatorFree(binaryTree->allocator, block,
+      sizeof(GenUtils_BinaryTreeKeyBlock) +
+        block->capacity);
+    block = previous;
+  }
+}
+
+// Copy the keys of a tree in order to a block.
+static void GenUtils_BinaryTreeInternalCopyKeys(
+  GenUtils_BinaryTree *binaryTree, char *data, size_t *size)
+{
+  // Cursor of the tree.
+  GenUtils_BinaryTreeCursor cursor;
+  // Whether the cursor is at a node.
+  bool valid = false;
+  // The current node.
+  GenUtils_BinaryTreeInternalNode *node = NULL;
+  valid =
+    GenUtils_BinaryTreeCursorFirst(&cursor, binaryTree);
+  while (valid)
+  {
+    node = (GenUtils_BinaryTreeInternalNode *)
+      cursor.path[cursor.depth - 1];
+    memcpy(data + *size, node->keyValue.key,
+      node->keyLength + 1);
+    node->keyValue.key = data + *size;
+    *size += node->keyLength + 1;
+    valid = GenUtils_BinaryTreeCursorNext(&cursor);
+  }
+}
+
+// Copy a key to the key arena of a tree. When the block is
+// full, a new one with room for twice its size is added.
+static const char *GenUtils_BinaryTreeInternalAddKey(
+  GenUtils_BinaryTree *binaryTree, const char *key,
+  size_t keyLength)
+{
+  // The arena of the tree.
+  GenUtils_BinaryTreeKeyArena *keyArena =
+    binaryTree->keyArena;
+  // The size of the new block.
+  size_t capacity = 0;
+  // The copy of the key.
+  char *copy = NULL;
+  if (keyArena->block == NULL ||
+      keyLength + 1 >
+        keyArena->block->capacity - keyArena->used)
+  {
+    if (keyLength >= SIZE_MAX / 2)
+    {
+      return NULL;
+    }
+    if (keyArena->block != NULL &&
+        keyArena->block->capacity < SIZE_MAX / 2)
+    {
+      capacity = 2 * keyArena->block->capacity;
+    }
+    if (capacity < keyLength + 1)
+    {
+      capacity = keyLength + 1;
+    }
+    if (!GenUtils_BinaryTreeInternalAddKeyBlock(
+          binaryTree, capacity))
+    {
+      return NULL;
+    }
   }
+  copy = keyArena->block->data + keyArena->used;
+  memcpy(copy, key, keyLength + 1);
+  keyArena->used += keyLength + 1;
+  keyArena->size += keyLength + 1;
+  return copy;
 }
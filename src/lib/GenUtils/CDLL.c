@@ -2,12 +2,114 @@
 // Author: DP-Dev
 // Implementation of a CDLL.
 #include <GenUtils/CDLL.h>
+#include <GenUtils/Pool.h>
+#include <assert.h>
+
+// Get memory for a new node, from the pool of the list if
+// it have one.
+static inline GenUtils_DoubleNode *
+  GenUtils_CDLLInternalNewNode(GenUtils_CDLL *list)
+{
+  if (list->pool != NULL)
+  {
+    return GenUtils_PoolAlloc(list->pool);
+  }
+  return GenUtils_AllocatorAlloc(
+    list->allocator, sizeof(GenUtils_DoubleNode));
+}
+
+// Release the memory of a node.
+static inline void GenUtils_CDLLInternalDeleteNode(
+  GenUtils_CDLL *list, GenUtils_DoubleNode *node)
+{
+  if (list->pool != NULL)
+  {
+    GenUtils_PoolFree(list->pool, node);
+  }
+  else
+  {
+    GenUtils_AllocatorFree(
+      list->allocator, node, sizeof(GenUtils_DoubleNode));
+  }
+}
+
+// Check if the nodes of a list can be moved to another
+// one. The nodes must be released the same way by both
+// lists, so they share their pool or, without a pool, their
+// allocator. A pool owned by a list is never shared.
+static inline bool GenUtils_CDLLInternalCanMove(
+  GenUtils_CDLL *destination, GenUtils_CDLL *source)
+{
+  return GenUtils_CDLLWasInit(destination) &&
+    GenUtils_CDLLWasInit(source) && destination != source &&
+    destination->pool == source->pool &&
+    (destination->pool != NULL ||
+      destination->allocator == source->allocator);
+}
+
+#ifndef NDEBUG
+// Count the nodes of a range, to check in debug builds the
+// count given to Splice.
+static size_t GenUtils_CDLLInternalCountRange(
+  GenUtils_DoubleNode *first, GenUtils_DoubleNode *last)
+{
+  // The number of nodes.
+  size_t count = 1;
+  while (first != last)
+  {
+    first = first->second;
+    count++;
+  }
+  return count;
+}
+#endif
+
+// Walk the nodes of a list once, calling the destructor
+// with their data and releasing them unless they are in a
+// pool owned by the list. The list is left empty.
+static void GenUtils_CDLLInternalClear(GenUtils_CDLL *list,
+  void (*destructor)(void *), bool release)
+{
+  // The current node.
+  GenUtils_DoubleNode *currentNode = list->head;
+  // The node after the current one.
+  GenUtils_DoubleNode *nextNode = NULL;
+  // Skip the walk if there is nothing to do per node.
+  release =
+    release && (list->pool == NULL || list->sharedPool);
+  if (destructor != NULL || release)
+  {
+    for (size_t i = 0; i < list->size; i++)
+    {
+      nextNode = currentNode->second;
+      if (destructor != NULL)
+      {
+        destructor(currentNode->userdata);
+      }
+      if (release)
+      {
+        GenUtils_CDLLInternalDeleteNode(list, currentNode);
+      }
+      currentNode = nextNode;
+    }
+  }
+  list->head = NULL;
+  list->size = 0;
+}
 
 // Creates a CDLL struture.
 GenUtils_CDLL *GenUtils_CDLLCreate()
+{
+  return GenUtils_CDLLCreateWithAllocator(NULL);
+}
+
+// Creates a CDLL that uses an allocator.
+GenUtils_CDLL *GenUtils_CDLLCreateWithAllocator(
+  const GenUtils_Allocator *allocator)
 {
   // Allocate memory for the new list.
-  GenUtils_CDLL *list = malloc(sizeof(GenUtils_CDLL));
+  GenUtils_CDLL *list = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_CDLL));
   // Return if was unable to allocate memory.
   if (list == NULL)
   {
@@ -16,15 +118,87 @@ GenUtils_CDLL *GenUtils_CDLLCreate()
   // Initialize the structure.
   list->head = NULL;
   list->size = 0;
+  list->pool = NULL;
+  list->sharedPool = false;
+  list->allocator = allocator;
   // Return the list.
   return list;
 }
 
+// Creates a CDLL that takes its nodes from a pool.
+GenUtils_CDLL *GenUtils_CDLLCreateWithPool(
+  size_t capacityHint)
+{
+  // Create the list.
+  GenUtils_CDLL *list = GenUtils_CDLLCreate();
+  if (list == NULL)
+  {
+    return NULL;
+  }
+  // Create its pool.
+  list->pool = GenUtils_PoolCreate(
+    sizeof(GenUtils_DoubleNode), capacityHint);
+  if (list->pool == NULL)
+  {
+    GenUtils_AllocatorFree(
+      list->allocator, list, sizeof(GenUtils_CDLL));
+    return NULL;
+  }
+  return list;
+}
+
+// Creates a CDLL that takes its nodes from a pool of the
+// caller.
+GenUtils_CDLL *GenUtils_CDLLCreateWithSharedPool(
+  GenUtils_Pool *pool)
+{
+  // The list to create.
+  GenUtils_CDLL *list = NULL;
+  if (!GenUtils_PoolWasInit(pool) ||
+      pool->objectSize < sizeof(GenUtils_DoubleNode))
+  {
+    return NULL;
+  }
+  list = GenUtils_CDLLCreate();
+  if (list != NULL)
+  {
+    list->pool = pool;
+    list->sharedPool = true;
+  }
+  return list;
+}
+
 // Destroy a CDLL.
 void GenUtils_CDLLDestroy(GenUtils_CDLL *list)
 {
-  GenUtils_CDLLClear(list);
-  free(list);
+  GenUtils_CDLLDestroyWith(list, NULL);
+}
+
+// Destroy a CDLL and the data of its elements.
+void GenUtils_CDLLDestroyWith(
+  GenUtils_CDLL *list, void (*destructor)(void *))
+{
+  if (!GenUtils_CDLLWasInit(list))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the list and
+  // all its nodes at once.
+  if (GenUtils_AllocatorCanReset(list->allocator))
+  {
+    GenUtils_CDLLInternalClear(list, destructor, false);
+    GenUtils_AllocatorReset(list->allocator);
+    return;
+  }
+  // The nodes of a pool owned by the list are released
+  // with the pool.
+  GenUtils_CDLLInternalClear(list, destructor, true);
+  if (!list->sharedPool)
+  {
+    GenUtils_PoolDestroy(list->pool);
+  }
+  GenUtils_AllocatorFree(
+    list->allocator, list, sizeof(GenUtils_CDLL));
 }
 
 // Get the size of a list.
@@ -83,6 +257,25 @@ GenUtils_DoubleNode *GenUtils_CDLLEnd(GenUtils_CDLL *list)
   return list->head->first;
 }
 
+// Search a node by its data.
+GenUtils_DoubleNode *GenUtils_CDLLFind(
+  GenUtils_CDLL *list, void *userdata)
+{
+  // The current node.
+  GenUtils_DoubleNode *currentNode =
+    GenUtils_CDLLBegin(list);
+  // Go through the list once.
+  for (size_t i = 0; i < GenUtils_CDLLGetSize(list); i++)
+  {
+    if (currentNode->userdata == userdata)
+    {
+      return currentNode;
+    }
+    currentNode = currentNode->second;
+  }
+  return NULL;
+}
+
 // Insert data in a node.
 bool GenUtils_CDLLInsert(GenUtils_CDLL *list,
   GenUtils_DoubleNode *node, void *userdata)
@@ -102,7 +295,7 @@ bool GenUtils_CDLLInsert(GenUtils_CDLL *list,
   // If the list is new, create the first node.
   if (list->size == 0)
   {
-    tempNode = malloc(sizeof(GenUtils_DoubleNode));
+    tempNode = GenUtils_CDLLInternalNewNode(list);
     if (tempNode == NULL)
     {
       return false;
@@ -116,7 +309,7 @@ bool GenUtils_CDLLInsert(GenUtils_CDLL *list,
   // Do additional logic in other case.
   else
   {
-    tempNode = malloc(sizeof(GenUtils_DoubleNode));
+    tempNode = GenUtils_CDLLInternalNewNode(list);
     if (tempNode == NULL)
     {
       return false;
@@ -155,7 +348,7 @@ bool GenUtils_CDLLInsertAfter(GenUtils_CDLL *list,
   // If the list is new, create the first node.
   if (list->size == 0)
   {
-    tempNode = malloc(sizeof(GenUtils_DoubleNode));
+    tempNode = GenUtils_CDLLInternalNewNode(list);
     if (tempNode == NULL)
     {
       return false;
@@ -169,7 +362,7 @@ bool GenUtils_CDLLInsertAfter(GenUtils_CDLL *list,
   // Do additional logic in other case.
   else
   {
-    tempNode = malloc(sizeof(GenUtils_DoubleNode));
+    tempNode = GenUtils_CDLLInternalNewNode(list);
     if (tempNode == NULL)
     {
       return false;
@@ -197,7 +390,7 @@ bool GenUtils_CDLLRemove(
   // If the list have only one element, reset all.
   else if (list->size == 1)
   {
-    free(list->head);
+    GenUtils_CDLLInternalDeleteNode(list, list->head);
     list->head = NULL;
     list->size = 0;
   }
@@ -210,7 +403,7 @@ bool GenUtils_CDLLRemove(
     }
     node->first->second = node->second;
     node->second->first = node->first;
-    free(node);
+    GenUtils_CDLLInternalDeleteNode(list, node);
     list->size--;
   }
   return true;
@@ -247,8 +440,8 @@ bool GenUtils_CDLLPushFront(
 // Remove and return data from the tail of the list.
 void *GenUtils_CDLLPopBack(GenUtils_CDLL *list)
 {
-  // Get the first node.
-  GenUtils_SingleNode *node = GenUtils_CDLLEnd(list);
+  // Get the last node.
+  GenUtils_DoubleNode *node = GenUtils_CDLLEnd(list);
   // Data of the node.
   void *data = (node == NULL ? NULL : node->userdata);
   GenUtils_CDLLRemove(list, node);
@@ -261,8 +454,19 @@ bool GenUtils_CDLLPopBackBool(GenUtils_CDLL *list)
   return GenUtils_CDLLRemove(list, GenUtils_CDLLEnd(list));
 }
 
+// Remove and return data from the head of the list.
+void *GenUtils_CDLLPopFront(GenUtils_CDLL *list)
+{
+  // Get the first node.
+  GenUtils_DoubleNode *node = GenUtils_CDLLBegin(list);
+  // Data of the node.
+  void *data = (node == NULL ? NULL : node->userdata);
+  GenUtils_CDLLRemove(list, node);
+  return data;
+}
+
 // Remove data from the beginning of the list.
-bool GenUtils_CDLLPopFront(GenUtils_CDLL *list)
+bool GenUtils_CDLLPopFrontBool(GenUtils_CDLL *list)
 {
   return GenUtils_CDLLRemove(
     list, GenUtils_CDLLBegin(list));
@@ -271,10 +475,117 @@ bool GenUtils_CDLLPopFront(GenUtils_CDLL *list)
 // Remove all the elements of a list.
 void GenUtils_CDLLClear(GenUtils_CDLL *list)
 {
-  while (GenUtils_CDLLGetSize(list) > 0)
+  GenUtils_CDLLClearWith(list, NULL);
+}
+
+// Remove all the elements of a list and their data.
+void GenUtils_CDLLClearWith(
+  GenUtils_CDLL *list, void (*destructor)(void *))
+{
+  if (!GenUtils_CDLLWasInit(list))
+  {
+    return;
+  }
+  GenUtils_CDLLInternalClear(list, destructor, true);
+  // Release all the nodes at once if they are in a pool
+  // owned by the list.
+  if (list->pool != NULL && !list->sharedPool)
+  {
+    GenUtils_PoolReset(list->pool);
+  }
+}
+
+// Move all the nodes of a list to another one.
+bool GenUtils_CDLLConcat(
+  GenUtils_CDLL *destination, GenUtils_CDLL *source)
+{
+  if (!GenUtils_CDLLInternalCanMove(destination, source))
+  {
+    return false;
+  }
+  if (source->size == 0)
+  {
+    return true;
+  }
+  return GenUtils_CDLLSplice(destination, NULL, source,
+    source->head, source->head->first, source->size);
+}
+
+// Move a range of nodes to another list.
+bool GenUtils_CDLLSplice(GenUtils_CDLL *destination,
+  GenUtils_DoubleNode *position, GenUtils_CDLL *source,
+  GenUtils_DoubleNode *first, GenUtils_DoubleNode *last,
+  size_t count)
+{
+  // The node where the range is inserted.
+  GenUtils_DoubleNode *next = NULL;
+  if (!GenUtils_CDLLInternalCanMove(destination, source) ||
+      first == NULL || last == NULL || count == 0 ||
+      count > source->size)
+  {
+    return false;
+  }
+  assert(GenUtils_CDLLInternalCountRange(first, last) ==
+         count);
+  // Unlink the range from the source.
+  if (count == source->size)
+  {
+    source->head = NULL;
+  }
+  else
+  {
+    first->first->second = last->second;
+    last->second->first = first->first;
+    if (first == source->head)
+    {
+      source->head = last->second;
+    }
+  }
+  source->size -= count;
+  // Link the range in the destination.
+  if (destination->size == 0)
+  {
+    first->first = last;
+    last->second = first;
+    destination->head = first;
+  }
+  else
+  {
+    next = position != NULL ? position : destination->head;
+    first->first = next->first;
+    next->first->second = first;
+    last->second = next;
+    next->first = last;
+    if (position == destination->head)
+    {
+      destination->head = first;
+    }
+  }
+  destination->size += count;
+  return true;
+}
+
+// Split a list at a node.
+bool GenUtils_CDLLSplit(GenUtils_CDLL *list,
+  GenUtils_DoubleNode *node, GenUtils_CDLL *destination)
+{
+  // The current node.
+  GenUtils_DoubleNode *currentNode = node;
+  // The number of nodes to move.
+  size_t count = 1;
+  if (!GenUtils_CDLLInternalCanMove(destination, list) ||
+      node == NULL || list->size == 0)
   {
-    GenUtils_CDLLPopFront(list);
+    return false;
+  }
+  // Count the nodes from node to the tail.
+  while (currentNode != list->head->first)
+  {
+    currentNode = currentNode->second;
+    count++;
   }
+  return GenUtils_CDLLSplice(destination, NULL, list, node,
+    list->head->first, count);
 }
 
 // Iterate a list wth a function.
@@ -2,12 +2,115 @@
 // Author: DP-Dev
 // Implementation of a CSLL.
 #include <GenUtils/CSLL.h>
+#include <GenUtils/Pool.h>
+#include <assert.h>
+
+// Get memory for a new node, from the pool of the list if
+// it have one.
+static inline GenUtils_SingleNode *
+  GenUtils_CSLLInternalNewNode(GenUtils_CSLL *list)
+{
+  if (list->pool != NULL)
+  {
+    return GenUtils_PoolAlloc(list->pool);
+  }
+  return GenUtils_AllocatorAlloc(
+    list->allocator, sizeof(GenUtils_SingleNode));
+}
+
+// Release the memory of a node.
+static inline void GenUtils_CSLLInternalDeleteNode(
+  GenUtils_CSLL *list, GenUtils_SingleNode *node)
+{
+  if (list->pool != NULL)
+  {
+    GenUtils_PoolFree(list->pool, node);
+  }
+  else
+  {
+    GenUtils_AllocatorFree(
+      list->allocator, node, sizeof(GenUtils_SingleNode));
+  }
+}
+
+// Check if the nodes of a list can be moved to another
+// one. The nodes must be released the same way by both
+// lists, so they share their pool or, without a pool, their
+// allocator. A pool owned by a list is never shared.
+static inline bool GenUtils_CSLLInternalCanMove(
+  GenUtils_CSLL *destination, GenUtils_CSLL *source)
+{
+  return GenUtils_CSLLWasInit(destination) &&
+    GenUtils_CSLLWasInit(source) && destination != source &&
+    destination->pool == source->pool &&
+    (destination->pool != NULL ||
+      destination->allocator == source->allocator);
+}
+
+#ifndef NDEBUG
+// Count the nodes of a range after a node, to check in
+// debug builds the count given to SpliceAfter.
+static size_t GenUtils_CSLLInternalCountRange(
+  GenUtils_SingleNode *previous, GenUtils_SingleNode *last)
+{
+  // The number of nodes.
+  size_t count = 0;
+  do
+  {
+    previous = previous->nextNode;
+    count++;
+  } while (previous != last);
+  return count;
+}
+#endif
+
+// Walk the nodes of a list once, calling the destructor
+// with their data and releasing them unless they are in a
+// pool owned by the list. The list is left empty.
+static void GenUtils_CSLLInternalClear(GenUtils_CSLL *list,
+  void (*destructor)(void *), bool release)
+{
+  // The current node.
+  GenUtils_SingleNode *currentNode = list->head;
+  // The node after the current one.
+  GenUtils_SingleNode *nextNode = NULL;
+  // Skip the walk if there is nothing to do per node.
+  release =
+    release && (list->pool == NULL || list->sharedPool);
+  if (destructor != NULL || release)
+  {
+    for (size_t i = 0; i < list->size; i++)
+    {
+      nextNode = currentNode->nextNode;
+      if (destructor != NULL)
+      {
+        destructor(currentNode->userdata);
+      }
+      if (release)
+      {
+        GenUtils_CSLLInternalDeleteNode(list, currentNode);
+      }
+      currentNode = nextNode;
+    }
+  }
+  list->head = NULL;
+  list->tail = NULL;
+  list->size = 0;
+}
 
 // Creates a CSLL struture.
 GenUtils_CSLL *GenUtils_CSLLCreate()
+{
+  return GenUtils_CSLLCreateWithAllocator(NULL);
+}
+
+// Creates a CSLL that uses an allocator.
+GenUtils_CSLL *GenUtils_CSLLCreateWithAllocator(
+  const GenUtils_Allocator *allocator)
 {
   // Allocate memory for the new list.
-  GenUtils_CSLL *list = malloc(sizeof(GenUtils_CSLL));
+  GenUtils_CSLL *list = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_CSLL));
   // Return if was unable to allocate memory.
   if (list == NULL)
   {
@@ -17,15 +120,87 @@ GenUtils_CSLL *GenUtils_CSLLCreate()
   list->head = NULL;
   list->tail = NULL;
   list->size = 0;
+  list->pool = NULL;
+  list->sharedPool = false;
+  list->allocator = allocator;
   // Return the list.
   return list;
 }
 
+// Creates a CSLL that takes its nodes from a pool.
+GenUtils_CSLL *GenUtils_CSLLCreateWithPool(
+  size_t capacityHint)
+{
+  // Create the list.
+  GenUtils_CSLL *list = GenUtils_CSLLCreate();
+  if (list == NULL)
+  {
+    return NULL;
+  }
+  // Create its pool.
+  list->pool = GenUtils_PoolCreate(
+    sizeof(GenUtils_SingleNode), capacityHint);
+  if (list->pool == NULL)
+  {
+    GenUtils_AllocatorFree(
+      list->allocator, list, sizeof(GenUtils_CSLL));
+    return NULL;
+  }
+  return list;
+}
+
+// Creates a CSLL that takes its nodes from a pool of the
+// caller.
+GenUtils_CSLL *GenUtils_CSLLCreateWithSharedPool(
+  GenUtils_Pool *pool)
+{
+  // The list to create.
+  GenUtils_CSLL *list = NULL;
+  if (!GenUtils_PoolWasInit(pool) ||
+      pool->objectSize < sizeof(GenUtils_SingleNode))
+  {
+    return NULL;
+  }
+  list = GenUtils_CSLLCreate();
+  if (list != NULL)
+  {
+    list->pool = pool;
+    list->sharedPool = true;
+  }
+  return list;
+}
+
 // Destroy a CSLL.
 void GenUtils_CSLLDestroy(GenUtils_CSLL *list)
 {
-  GenUtils_CSLLClear(list);
-  free(list);
+  GenUtils_CSLLDestroyWith(list, NULL);
+}
+
+// Destroy a CSLL and the data of its elements.
+void GenUtils_CSLLDestroyWith(
+  GenUtils_CSLL *list, void (*destructor)(void *))
+{
+  if (!GenUtils_CSLLWasInit(list))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the list and
+  // all its nodes at once.
+  if (GenUtils_AllocatorCanReset(list->allocator))
+  {
+    GenUtils_CSLLInternalClear(list, destructor, false);
+    GenUtils_AllocatorReset(list->allocator);
+    return;
+  }
+  // The nodes of a pool owned by the list are released
+  // with the pool.
+  GenUtils_CSLLInternalClear(list, destructor, true);
+  if (!list->sharedPool)
+  {
+    GenUtils_PoolDestroy(list->pool);
+  }
+  GenUtils_AllocatorFree(
+    list->allocator, list, sizeof(GenUtils_CSLL));
 }
 
 // Get the size of a list.
@@ -102,7 +277,7 @@ bool GenUtils_CSLLInsert(GenUtils_CSLL *list,
   // If the list is new, just append.
   if (list->size == 0)
   {
-    tempNode = malloc(sizeof(GenUtils_SingleNode));
+    tempNode = GenUtils_CSLLInternalNewNode(list);
     if (tempNode == NULL)
     {
       return false;
@@ -116,7 +291,7 @@ bool GenUtils_CSLLInsert(GenUtils_CSLL *list,
   // Do additional logic in other case.
   else
   {
-    tempNode = malloc(sizeof(GenUtils_SingleNode));
+    tempNode = GenUtils_CSLLInternalNewNode(list);
     if (tempNode == NULL)
     {
       return false;
@@ -153,7 +328,7 @@ bool GenUtils_CSLLInsertAfter(GenUtils_CSLL *list,
   // If the list is new, just append.
   if (list->size == 0)
   {
-    tempNode = malloc(sizeof(GenUtils_SingleNode));
+    tempNode = GenUtils_CSLLInternalNewNode(list);
     if (tempNode == NULL)
     {
       return false;
@@ -167,7 +342,7 @@ bool GenUtils_CSLLInsertAfter(GenUtils_CSLL *list,
   // Do additional logic in other case.
   else
   {
-    tempNode = malloc(sizeof(GenUtils_SingleNode));
+    tempNode = GenUtils_CSLLInternalNewNode(list);
     if (tempNode == NULL)
     {
       return false;
@@ -199,7 +374,7 @@ bool GenUtils_CSLLRemove(
   // If the list have only one element, reset all.
   else if (list->size == 1)
   {
-    free(list->head);
+    GenUtils_CSLLInternalDeleteNode(list, list->head);
     list->head = NULL;
     list->tail = NULL;
     list->size = 0;
@@ -221,7 +396,7 @@ bool GenUtils_CSLLRemove(
       list->tail = currentNode;
     }
     currentNode->nextNode = node->nextNode;
-    free(node);
+    GenUtils_CSLLInternalDeleteNode(list, node);
     list->size--;
   }
   return true;
@@ -242,7 +417,7 @@ bool GenUtils_CSLLRemoveAfter(
   // If the list have only one element, reset all.
   else if (list->size == 1)
   {
-    free(list->head);
+    GenUtils_CSLLInternalDeleteNode(list, list->head);
     list->head = NULL;
     list->tail = NULL;
     list->size = 0;
@@ -262,7 +437,7 @@ bool GenUtils_CSLLRemoveAfter(
       list->head = list->head->nextNode;
     }
     currentNode->nextNode = node->nextNode;
-    free(node);
+    GenUtils_CSLLInternalDeleteNode(list, node);
     list->size--;
   }
   return true;
@@ -322,10 +497,127 @@ bool GenUtils_CSLLPopFrontBool(GenUtils_CSLL *list)
 // Remove all the elements of a list.
 void GenUtils_CSLLClear(GenUtils_CSLL *list)
 {
-  while (GenUtils_CSLLGetSize(list) > 0)
+  GenUtils_CSLLClearWith(list, NULL);
+}
+
+// Remove all the elements of a list and their data.
+void GenUtils_CSLLClearWith(
+  GenUtils_CSLL *list, void (*destructor)(void *))
+{
+  if (!GenUtils_CSLLWasInit(list))
+  {
+    return;
+  }
+  GenUtils_CSLLInternalClear(list, destructor, true);
+  // Release all the nodes at once if they are in a pool
+  // owned by the list.
+  if (list->pool != NULL && !list->sharedPool)
+  {
+    GenUtils_PoolReset(list->pool);
+  }
+}
+
+// Move all the nodes of a list to another one.
+bool GenUtils_CSLLConcat(
+  GenUtils_CSLL *destination, GenUtils_CSLL *source)
+{
+  if (!GenUtils_CSLLInternalCanMove(destination, source))
+  {
+    return false;
+  }
+  if (source->size == 0)
+  {
+    return true;
+  }
+  return GenUtils_CSLLSpliceAfter(destination, NULL, source,
+    source->tail, source->tail, source->size);
+}
+
+// Move a range of nodes to another list.
+bool GenUtils_CSLLSpliceAfter(GenUtils_CSLL *destination,
+  GenUtils_SingleNode *position, GenUtils_CSLL *source,
+  GenUtils_SingleNode *previous, GenUtils_SingleNode *last,
+  size_t count)
+{
+  // The first node of the range.
+  GenUtils_SingleNode *first = NULL;
+  if (!GenUtils_CSLLInternalCanMove(destination, source) ||
+      previous == NULL || last == NULL || count == 0 ||
+      count > source->size)
+  {
+    return false;
+  }
+  assert(GenUtils_CSLLInternalCountRange(previous, last) ==
+         count);
+  first = previous->nextNode;
+  // Unlink the range from the source.
+  if (count == source->size)
   {
-    GenUtils_CSLLPopFront(list);
+    source->head = NULL;
+    source->tail = NULL;
+  }
+  else
+  {
+    previous->nextNode = last->nextNode;
+    if (first == source->head)
+    {
+      source->head = last->nextNode;
+    }
+    if (last == source->tail)
+    {
+      source->tail = previous;
+    }
+  }
+  source->size -= count;
+  // Link the range in the destination.
+  if (destination->size == 0)
+  {
+    last->nextNode = first;
+    destination->head = first;
+    destination->tail = last;
+  }
+  else
+  {
+    if (position == NULL)
+    {
+      position = destination->tail;
+    }
+    last->nextNode = position->nextNode;
+    position->nextNode = first;
+    if (position == destination->tail)
+    {
+      destination->tail = last;
+    }
+  }
+  destination->size += count;
+  return true;
+}
+
+// Split a list after a node.
+bool GenUtils_CSLLSplitAfter(GenUtils_CSLL *list,
+  GenUtils_SingleNode *node, GenUtils_CSLL *destination)
+{
+  // The current node.
+  GenUtils_SingleNode *currentNode = node;
+  // The number of nodes to move.
+  size_t count = 0;
+  if (!GenUtils_CSLLInternalCanMove(destination, list) ||
+      node == NULL || list->size == 0)
+  {
+    return false;
+  }
+  // Count the nodes after node up to the tail.
+  while (currentNode != list->tail)
+  {
+    currentNode = currentNode->nextNode;
+    count++;
+  }
+  if (count == 0)
+  {
+    return true;
   }
+  return GenUtils_CSLLSpliceAfter(
+    destination, NULL, list, node, list->tail, count);
 }
 
 // Iterate a list wth a function.
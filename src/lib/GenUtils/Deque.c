@@ -0,0 +1,350 @@
+// File: Deque.c
+// Author: DP-Dev
+// Implementation of a double-ended queue.
+#include <GenUtils/Deque.h>
+#include <stdint.h>
+#include <string.h>
+
+// Capacity of the first buffer of a deque.
+#define GENUTILS_DEQUE_MIN_CAPACITY 8
+
+// Get the position in the buffer of an index.
+static inline size_t GenUtils_DequeInternalPosition(
+  GenUtils_Deque *deque, size_t index)
+{
+  return (deque->head + index) & (deque->capacity - 1);
+}
+
+// Move the elements of a deque to a new buffer. The
+// elements start at the beginning of the new buffer.
+static bool GenUtils_DequeInternalResize(
+  GenUtils_Deque *deque, size_t capacity)
+{
+  // The new buffer.
+  void **data = NULL;
+  // Number of elements before the end of the old buffer.
+  size_t firstSize = 0;
+  if (capacity > SIZE_MAX / sizeof(void *))
+  {
+    return false;
+  }
+  data = GenUtils_AllocatorAlloc(
+    deque->allocator, capacity * sizeof(void *));
+  if (data == NULL)
+  {
+    return false;
+  }
+  // Copy the two segments of the ring.
+  if (deque->size > 0)
+  {
+    firstSize = deque->capacity - deque->head;
+    if (firstSize > deque->size)
+    {
+      firstSize = deque->size;
+    }
+    memcpy(data, deque->data + deque->head,
+      firstSize * sizeof(void *));
+    memcpy(data + firstSize, deque->data,
+      (deque->size - firstSize) * sizeof(void *));
+  }
+  GenUtils_AllocatorFree(deque->allocator, deque->data,
+    deque->capacity * sizeof(void *));
+  deque->data = data;
+  deque->head = 0;
+  deque->capacity = capacity;
+  return true;
+}
+
+// Make room for one more element.
+static inline bool GenUtils_DequeInternalGrow(
+  GenUtils_Deque *deque)
+{
+  if (deque->size < deque->capacity)
+  {
+    return true;
+  }
+  if (deque->capacity == 0)
+  {
+    return GenUtils_DequeInternalResize(
+      deque, GENUTILS_DEQUE_MIN_CAPACITY);
+  }
+  return GenUtils_DequeInternalResize(
+    deque, deque->capacity * 2);
+}
+
+// Create a deque.
+GenUtils_Deque *GenUtils_DequeCreate()
+{
+  return GenUtils_DequeCreateWithAllocator(NULL);
+}
+
+// Create a deque that uses an allocator.
+GenUtils_Deque *GenUtils_DequeCreateWithAllocator(
+  const GenUtils_Allocator *allocator)
+{
+  // The deque to create.
+  GenUtils_Deque *deque = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_Deque));
+  if (deque == NULL)
+  {
+    return NULL;
+  }
+  // The buffer is allocated with the first element.
+  deque->data = NULL;
+  deque->head = 0;
+  deque->size = 0;
+  deque->capacity = 0;
+  deque->allocator = allocator;
+  return deque;
+}
+
+// Destroy a deque.
+void GenUtils_DequeDestroy(GenUtils_Deque *deque)
+{
+  if (!GenUtils_DequeWasInit(deque))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the deque and
+  // its buffer at once.
+  if (GenUtils_AllocatorReset(deque->allocator))
+  {
+    return;
+  }
+  GenUtils_AllocatorFree(deque->allocator, deque->data,
+    deque->capacity * sizeof(void *));
+  GenUtils_AllocatorFree(
+    deque->allocator, deque, sizeof(GenUtils_Deque));
+}
+
+// Get the size of a deque.
+size_t GenUtils_DequeGetSize(GenUtils_Deque *deque)
+{
+  if (GenUtils_DequeWasInit(deque))
+  {
+    return deque->size;
+  }
+  return 0;
+}
+
+// Query if a deque is empty.
+bool GenUtils_DequeEmpty(GenUtils_Deque *deque)
+{
+  if (GenUtils_DequeWasInit(deque) && deque->size == 0)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Check if a deque was initialized.
+bool GenUtils_DequeWasInit(GenUtils_Deque *deque)
+{
+  if (deque != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the first element.
+void *GenUtils_DequeBegin(GenUtils_Deque *deque)
+{
+  return GenUtils_DequeGet(deque, 0);
+}
+
+// Get the last element.
+void *GenUtils_DequeEnd(GenUtils_Deque *deque)
+{
+  if (GenUtils_DequeEmpty(deque))
+  {
+    return NULL;
+  }
+  return GenUtils_DequeGet(deque, deque->size - 1);
+}
+
+// Get an element by its index.
+void *GenUtils_DequeGet(GenUtils_Deque *deque, size_t index)
+{
+  if (!GenUtils_DequeWasInit(deque) || index >= deque->size)
+  {
+    return NULL;
+  }
+  return deque
+    ->data[GenUtils_DequeInternalPosition(deque, index)];
+}
+
+// Replace an element by its index.
+bool GenUtils_DequeSet(
+  GenUtils_Deque *deque, size_t index, void *userdata)
+{
+  if (!GenUtils_DequeWasInit(deque) || index >= deque->size)
+  {
+    return false;
+  }
+  deque->data[GenUtils_DequeInternalPosition(
+    deque, index)] = userdata;
+  return true;
+}
+
+// Add data at the tail of the deque.
+bool GenUtils_DequePushBack(
+  GenUtils_Deque *deque, void *userdata)
+{
+  if (!GenUtils_DequeWasInit(deque) ||
+      !GenUtils_DequeInternalGrow(deque))
+  {
+    return false;
+  }
+  deque->data[GenUtils_DequeInternalPosition(
+    deque, deque->size)] = userdata;
+  deque->size++;
+  return true;
+}
+
+// Add data at the head of the deque.
+bool GenUtils_DequePushFront(
+  GenUtils_Deque *deque, void *userdata)
+{
+  if (!GenUtils_DequeWasInit(deque) ||
+      !GenUtils_DequeInternalGrow(deque))
+  {
+    return false;
+  }
+  deque->head = (deque->head - 1) & (deque->capacity - 1);
+  deque->data[deque->head] = userdata;
+  deque->size++;
+  return true;
+}
+
+// Remove and return data from the tail of the deque.
+void *GenUtils_DequePopBack(GenUtils_Deque *deque)
+{
+  if (!GenUtils_DequeWasInit(deque) || deque->size == 0)
+  {
+    return NULL;
+  }
+  deque->size--;
+  return deque->data[GenUtils_DequeInternalPosition(
+    deque, deque->size)];
+}
+
+// Remove data from the tail of the deque.
+bool GenUtils_DequePopBackBool(GenUtils_Deque *deque)
+{
+  if (!GenUtils_DequeWasInit(deque) || deque->size == 0)
+  {
+    return false;
+  }
+  deque->size--;
+  return true;
+}
+
+// Remove and return data from the head of the deque.
+void *GenUtils_DequePopFront(GenUtils_Deque *deque)
+{
+  // The data of the head.
+  void *data = NULL;
+  if (!GenUtils_DequeWasInit(deque) || deque->size == 0)
+  {
+    return NULL;
+  }
+  data = deque->data[deque->head];
+  deque->head = (deque->head + 1) & (deque->capacity - 1);
+  deque->size--;
+  return data;
+}
+
+// Remove data from the head of the deque.
+bool GenUtils_DequePopFrontBool(GenUtils_Deque *deque)
+{
+  if (!GenUtils_DequeWasInit(deque) || deque->size == 0)
+  {
+    return false;
+  }
+  deque->head = (deque->head + 1) & (deque->capacity - 1);
+  deque->size--;
+  return true;
+}
+
+// Remove all the elements of a deque.
+void GenUtils_DequeClear(GenUtils_Deque *deque)
+{
+  if (GenUtils_DequeWasInit(deque))
+  {
+    deque->head = 0;
+    deque->size = 0;
+  }
+}
+
+// Grow the buffer of a deque.
+bool GenUtils_DequeReserve(
+  GenUtils_Deque *deque, size_t capacity)
+{
+  // The new capacity, a power of two.
+  size_t newCapacity = GENUTILS_DEQUE_MIN_CAPACITY;
+  if (!GenUtils_DequeWasInit(deque))
+  {
+    return false;
+  }
+  if (capacity <= deque->capacity)
+  {
+    return true;
+  }
+  while (newCapacity < capacity)
+  {
+    if (newCapacity > SIZE_MAX / 2)
+    {
+      return false;
+    }
+    newCapacity *= 2;
+  }
+  return GenUtils_DequeInternalResize(deque, newCapacity);
+}
+
+// Iterate a deque with a function.
+void GenUtils_DequeIterate(GenUtils_Deque *deque,
+  void *extradata, void (*function)(void *, void *))
+{
+  // Position of the current element.
+  size_t position = 0;
+  // Verify the function.
+  if (function == NULL || GenUtils_DequeGetSize(deque) == 0)
+  {
+    return;
+  }
+  // Calls the function, going through the buffer in order.
+  position = deque->head;
+  for (size_t i = 0; i < deque->size; i++)
+  {
+    function(deque->data[position], extradata);
+    position++;
+    if (position == deque->capacity)
+    {
+      position = 0;
+    }
+  }
+}
+
+// Iterate the contiguous segments of a deque.
+void GenUtils_DequeIterateSegments(GenUtils_Deque *deque,
+  void *extradata,
+  void (*function)(void **, size_t, void *))
+{
+  // Number of elements before the end of the buffer.
+  size_t firstSize = 0;
+  // Verify the deque and the function.
+  if (function == NULL || GenUtils_DequeGetSize(deque) == 0)
+  {
+    return;
+  }
+  firstSize = deque->capacity - deque->head;
+  if (firstSize >= deque->size)
+  {
+    function(deque->data + deque->head, deque->size,
+      extradata);
+    return;
+  }
+  function(deque->data + deque->head, firstSize, extradata);
+  function(deque->data, deque->size - firstSize, extradata);
+}
@@ -0,0 +1,542 @@
+// File: Epoch.c
+// Author: DP-Dev
+// Implementation of epoch-based memory reclamation.
+#include <GenUtils/Epoch.h>
+#include <pthread.h>
+
+// Number of domains whose records a thread keeps at hand.
+#define GENUTILS_EPOCH_CACHE_SIZE 4
+
+// An entry of the cache of records of a thread.
+typedef struct GenUtils_EpochInternalCacheEntry
+{
+  // The domain.
+  GenUtils_Epoch *epoch;
+  // The id of the domain.
+  uint64_t id;
+  // The record of the thread in the domain.
+  GenUtils_EpochThread *thread;
+} GenUtils_EpochInternalCacheEntry;
+
+// The next id of a domain.
+static _Atomic uint64_t GenUtils_EpochInternalNextId = 1;
+// Its address identifies the calling thread. The records
+// of a thread lose it when the thread exits, so a thread
+// created later at the same address doesn't take them.
+static _Thread_local char GenUtils_EpochInternalToken;
+// The last domains used by the calling thread.
+static _Thread_local GenUtils_EpochInternalCacheEntry
+  GenUtils_EpochInternalCache[GENUTILS_EPOCH_CACHE_SIZE];
+// The entry of the cache replaced on the next miss.
+static _Thread_local size_t GenUtils_EpochInternalCacheNext;
+// The records owned by the calling thread.
+static _Thread_local GenUtils_EpochThread
+  *GenUtils_EpochInternalOwned = NULL;
+// Lock of the lists of records owned by the threads.
+static pthread_mutex_t GenUtils_EpochInternalOwnedLock =
+  PTHREAD_MUTEX_INITIALIZER;
+// Key whose destructor unregisters the records of a thread
+// that exits.
+static pthread_key_t GenUtils_EpochInternalKey;
+// Creates the key once.
+static pthread_once_t GenUtils_EpochInternalKeyOnce =
+  PTHREAD_ONCE_INIT;
+// true if the key was created.
+static bool GenUtils_EpochInternalKeyCreated = false;
+
+// Remove a record from the records of its owner thread.
+// The lock of the lists must be held.
+static void GenUtils_EpochInternalUnlink(
+  GenUtils_EpochThread *thread)
+{
+  if (thread->ownerPrevious == NULL)
+  {
+    return;
+  }
+  *thread->ownerPrevious = thread->ownerNext;
+  if (thread->ownerNext != NULL)
+  {
+    thread->ownerNext->ownerPrevious =
+      thread->ownerPrevious;
+  }
+  thread->ownerNext = NULL;
+  thread->ownerPrevious = NULL;
+}
+
+// Unregister the records of a thread that exits, without
+// collecting, since the objects can belong to allocators
+// that are not valid anymore.
+static void GenUtils_EpochInternalExit(void *owned)
+{
+  // The records of the thread.
+  GenUtils_EpochThread **records = owned;
+  // The record being unregistered.
+  GenUtils_EpochThread *thread = NULL;
+  pthread_mutex_lock(&GenUtils_EpochInternalOwnedLock);
+  while ((thread = *records) != NULL)
+  {
+    GenUtils_EpochInternalUnlink(thread);
+    // The thread can't hold a pointer anymore, even if it
+    // exited inside a critical section.
+    thread->nesting = 0;
+    atomic_store_explicit(
+      &thread->local, 0, memory_order_release);
+    atomic_store_explicit(
+      &thread->owner, NULL, memory_order_relaxed);
+    atomic_store_explicit(
+      &thread->used, false, memory_order_release);
+  }
+  pthread_mutex_unlock(&GenUtils_EpochInternalOwnedLock);
+}
+
+// Create the key of the records of the threads.
+static void GenUtils_EpochInternalCreateKey(void)
+{
+  GenUtils_EpochInternalKeyCreated =
+    pthread_key_create(&GenUtils_EpochInternalKey,
+      GenUtils_EpochInternalExit) == 0;
+}
+
+// Add a record to the records of the calling thread, that
+// are unregistered when it exits.
+static void GenUtils_EpochInternalLink(
+  GenUtils_EpochThread *thread)
+{
+  pthread_once(&GenUtils_EpochInternalKeyOnce,
+    GenUtils_EpochInternalCreateKey);
+  // Without the key the list would outlive the thread.
+  if (!GenUtils_EpochInternalKeyCreated ||
+      pthread_setspecific(GenUtils_EpochInternalKey,
+        &GenUtils_EpochInternalOwned) != 0)
+  {
+    return;
+  }
+  pthread_mutex_lock(&GenUtils_EpochInternalOwnedLock);
+  thread->ownerNext = GenUtils_EpochInternalOwned;
+  if (thread->ownerNext != NULL)
+  {
+    thread->ownerNext->ownerPrevious = &thread->ownerNext;
+  }
+  thread->ownerPrevious = &GenUtils_EpochInternalOwned;
+  GenUtils_EpochInternalOwned = thread;
+  pthread_mutex_unlock(&GenUtils_EpochInternalOwnedLock);
+}
+
+// Release a list of retired objects.
+static void GenUtils_EpochInternalRelease(
+  GenUtils_EpochThread *thread, size_t index)
+{
+  // The object being released.
+  GenUtils_EpochEntry *entry = thread->retired[index];
+  // The object after it.
+  GenUtils_EpochEntry *next = NULL;
+  thread->retired[index] = NULL;
+  while (entry != NULL)
+  {
+    next = entry->next;
+    entry->release(entry, entry->extradata);
+    thread->retiredCount--;
+    entry = next;
+  }
+}
+
+// Release the lists of retired objects of a thread that
+// are two epochs old.
+static void GenUtils_EpochInternalReleaseSafe(
+  GenUtils_EpochThread *thread, uint64_t global)
+{
+  for (size_t i = 0; i < 3; i++)
+  {
+    if (thread->retired[i] != NULL &&
+        thread->retiredEpoch[i] + 2 <= global)
+    {
+      GenUtils_EpochInternalRelease(thread, i);
+    }
+  }
+}
+
+// Try to advance the epoch once.
+static void GenUtils_EpochInternalAdvance(
+  GenUtils_Epoch *epoch)
+{
+  // The current epoch.
+  uint64_t global = atomic_load_explicit(
+    &epoch->global, memory_order_relaxed);
+  // Epoch of a thread.
+  uint64_t local = 0;
+  // A registered thread.
+  GenUtils_EpochThread *other = NULL;
+  atomic_thread_fence(memory_order_seq_cst);
+  // The epoch advances when every thread in a critical
+  // section has observed it.
+  for (other = atomic_load_explicit(
+         &epoch->threads, memory_order_acquire);
+       other != NULL; other = other->next)
+  {
+    local = atomic_load_explicit(
+      &other->local, memory_order_acquire);
+    if ((local & 1) != 0 && (local >> 1) != global)
+    {
+      return;
+    }
+  }
+  atomic_compare_exchange_strong_explicit(&epoch->global,
+    &global, global + 1, memory_order_acq_rel,
+    memory_order_relaxed);
+}
+
+// Create an epoch domain.
+GenUtils_Epoch *GenUtils_EpochCreate()
+{
+  return GenUtils_EpochCreateWithAllocator(NULL);
+}
+
+// Create an epoch domain that uses an allocator.
+GenUtils_Epoch *GenUtils_EpochCreateWithAllocator(
+  const GenUtils_Allocator *allocator)
+{
+  // The domain to create.
+  GenUtils_Epoch *epoch = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_Epoch));
+  if (epoch == NULL)
+  {
+    return NULL;
+  }
+  atomic_init(&epoch->global, 0);
+  atomic_init(&epoch->threads, NULL);
+  epoch->id = atomic_fetch_add_explicit(
+    &GenUtils_EpochInternalNextId, 1, memory_order_relaxed);
+  epoch->allocator = allocator;
+  return epoch;
+}
+
+// Destroy an epoch domain.
+void GenUtils_EpochDestroy(GenUtils_Epoch *epoch)
+{
+  // The record being released.
+  GenUtils_EpochThread *thread = NULL;
+  // The record after it.
+  GenUtils_EpochThread *next = NULL;
+  if (!GenUtils_EpochWasInit(epoch))
+  {
+    return;
+  }
+  // The retired objects can belong to other allocators.
+  GenUtils_EpochFlush(epoch);
+  for (size_t i = 0; i < GENUTILS_EPOCH_CACHE_SIZE; i++)
+  {
+    if (GenUtils_EpochInternalCache[i].epoch == epoch)
+    {
+      GenUtils_EpochInternalCache[i].epoch = NULL;
+    }
+  }
+  // The threads that are still running keep no link to the
+  // records.
+  pthread_mutex_lock(&GenUtils_EpochInternalOwnedLock);
+  for (thread = atomic_load_explicit(
+         &epoch->threads, memory_order_acquire);
+       thread != NULL; thread = thread->next)
+  {
+    GenUtils_EpochInternalUnlink(thread);
+  }
+  pthread_mutex_unlock(&GenUtils_EpochInternalOwnedLock);
+  // An allocator that can be reset releases the domain and
+  // its records at once.
+  if (GenUtils_AllocatorReset(epoch->allocator))
+  {
+    return;
+  }
+  thread = atomic_load_explicit(
+    &epoch->threads, memory_order_acquire);
+  while (thread != NULL)
+  {
+    next = thread->next;
+    GenUtils_AllocatorFree(epoch->allocator, thread,
+      sizeof(GenUtils_EpochThread));
+    thread = next;
+  }
+  GenUtils_AllocatorFree(
+    epoch->allocator, epoch, sizeof(GenUtils_Epoch));
+}
+
+// Check if an epoch domain was initialized.
+bool GenUtils_EpochWasInit(GenUtils_Epoch *epoch)
+{
+  if (epoch != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Register the calling thread.
+GenUtils_EpochThread *GenUtils_EpochRegister(
+  GenUtils_Epoch *epoch)
+{
+  // The record of the thread.
+  GenUtils_EpochThread *thread = NULL;
+  // Expected value of the used flag.
+  bool used = false;
+  if (!GenUtils_EpochWasInit(epoch))
+  {
+    return NULL;
+  }
+  // Take the record of an unregistered thread.
+  for (thread = atomic_load_explicit(
+         &epoch->threads, memory_order_acquire);
+       thread != NULL; thread = thread->next)
+  {
+    used = false;
+    if (!atomic_load_explicit(
+          &thread->used, memory_order_relaxed) &&
+        atomic_compare_exchange_strong_explicit(
+          &thread->used, &used, true, memory_order_acquire,
+          memory_order_relaxed))
+    {
+      atomic_store_explicit(&thread->owner,
+        &GenUtils_EpochInternalToken, memory_order_relaxed);
+      GenUtils_EpochInternalLink(thread);
+      return thread;
+    }
+  }
+  // Add a new record.
+  thread = GenUtils_AllocatorAlloc(
+    epoch->allocator, sizeof(GenUtils_EpochThread));
+  if (thread == NULL)
+  {
+    return NULL;
+  }
+  atomic_init(&thread->local, 0);
+  atomic_init(&thread->used, true);
+  atomic_init(&thread->owner, &GenUtils_EpochInternalToken);
+  thread->nesting = 0;
+  thread->exits = 0;
+  thread->retiredCount = 0;
+  for (size_t i = 0; i < 3; i++)
+  {
+    thread->retired[i] = NULL;
+    thread->retiredEpoch[i] = 0;
+  }
+  thread->epoch = epoch;
+  thread->ownerNext = NULL;
+  thread->ownerPrevious = NULL;
+  GenUtils_EpochInternalLink(thread);
+  thread->next = atomic_load_explicit(
+    &epoch->threads, memory_order_relaxed);
+  while (!atomic_compare_exchange_weak_explicit(
+    &epoch->threads, &thread->next, thread,
+    memory_order_release, memory_order_relaxed))
+  {
+  }
+  return thread;
+}
+
+// Unregister a thread.
+void GenUtils_EpochUnregister(GenUtils_EpochThread *thread)
+{
+  if (thread == NULL || thread->nesting != 0)
+  {
+    return;
+  }
+  // Leave as few objects as possible to the other threads.
+  GenUtils_EpochCollect(thread);
+  for (size_t i = 0; i < GENUTILS_EPOCH_CACHE_SIZE; i++)
+  {
+    if (GenUtils_EpochInternalCache[i].thread == thread)
+    {
+      GenUtils_EpochInternalCache[i].epoch = NULL;
+    }
+  }
+  pthread_mutex_lock(&GenUtils_EpochInternalOwnedLock);
+  GenUtils_EpochInternalUnlink(thread);
+  pthread_mutex_unlock(&GenUtils_EpochInternalOwnedLock);
+  atomic_store_explicit(
+    &thread->owner, NULL, memory_order_relaxed);
+  atomic_store_explicit(
+    &thread->used, false, memory_order_release);
+}
+
+// Get the record of the calling thread.
+GenUtils_EpochThread *GenUtils_EpochGetThread(
+  GenUtils_Epoch *epoch)
+{
+  // The record of the thread.
+  GenUtils_EpochThread *thread = NULL;
+  // The entry of the cache to fill.
+  GenUtils_EpochInternalCacheEntry *entry = NULL;
+  if (!GenUtils_EpochWasInit(epoch))
+  {
+    return NULL;
+  }
+  // A thread that alternates between a few domains finds
+  // them all in the cache, without searching the records.
+  for (size_t i = 0; i < GENUTILS_EPOCH_CACHE_SIZE; i++)
+  {
+    entry = &GenUtils_EpochInternalCache[i];
+    if (entry->epoch == epoch && entry->id == epoch->id)
+    {
+      return entry->thread;
+    }
+  }
+  // Search the record taken by this thread before.
+  for (thread = atomic_load_explicit(
+         &epoch->threads, memory_order_acquire);
+       thread != NULL; thread = thread->next)
+  {
+    if (atomic_load_explicit(
+          &thread->owner, memory_order_relaxed) ==
+        &GenUtils_EpochInternalToken)
+    {
+      break;
+    }
+  }
+  if (thread == NULL)
+  {
+    thread = GenUtils_EpochRegister(epoch);
+    if (thread == NULL)
+    {
+      return NULL;
+    }
+  }
+  entry = &GenUtils_EpochInternalCache
+    [GenUtils_EpochInternalCacheNext];
+  GenUtils_EpochInternalCacheNext =
+    (GenUtils_EpochInternalCacheNext + 1) %
+    GENUTILS_EPOCH_CACHE_SIZE;
+  entry->epoch = epoch;
+  entry->id = epoch->id;
+  entry->thread = thread;
+  return thread;
+}
+
+// Enter a critical section.
+void GenUtils_EpochEnter(GenUtils_EpochThread *thread)
+{
+  if (thread == NULL || thread->nesting++ != 0)
+  {
+    return;
+  }
+  // Publish the epoch before reading any object.
+  atomic_store_explicit(&thread->local,
+    (atomic_load_explicit(
+       &thread->epoch->global, memory_order_relaxed)
+      << 1) |
+      1,
+    memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+}
+
+// Exit a critical section.
+void GenUtils_EpochExit(GenUtils_EpochThread *thread)
+{
+  if (thread == NULL || thread->nesting == 0 ||
+      --thread->nesting != 0)
+  {
+    return;
+  }
+  atomic_store_explicit(
+    &thread->local, 0, memory_order_release);
+  // A thread that stops retiring still releases its
+  // objects while it uses the domain.
+  if (thread->retiredCount != 0 &&
+      ++thread->exits >= GENUTILS_EPOCH_BATCH)
+  {
+    GenUtils_EpochCollect(thread);
+  }
+}
+
+// Retire an object.
+void GenUtils_EpochRetire(GenUtils_EpochThread *thread,
+  GenUtils_EpochEntry *entry,
+  void (*release)(GenUtils_EpochEntry *, void *),
+  void *extradata)
+{
+  // The current epoch.
+  uint64_t global = 0;
+  // The list of the epoch.
+  size_t index = 0;
+  if (thread == NULL || entry == NULL || release == NULL)
+  {
+    return;
+  }
+  global = atomic_load_explicit(
+    &thread->epoch->global, memory_order_acquire);
+  index = global % 3;
+  // The list was used three epochs ago, so it's safe.
+  if (thread->retiredEpoch[index] != global)
+  {
+    GenUtils_EpochInternalRelease(thread, index);
+    thread->retiredEpoch[index] = global;
+  }
+  entry->release = release;
+  entry->extradata = extradata;
+  entry->next = thread->retired[index];
+  thread->retired[index] = entry;
+  thread->retiredCount++;
+  if (thread->retiredCount >= GENUTILS_EPOCH_BATCH)
+  {
+    GenUtils_EpochCollect(thread);
+  }
+}
+
+// Advance the epoch and release the safe objects.
+void GenUtils_EpochCollect(GenUtils_EpochThread *thread)
+{
+  // The current epoch.
+  uint64_t global = 0;
+  // A registered thread.
+  GenUtils_EpochThread *other = NULL;
+  // Expected value of the used flag.
+  bool used = false;
+  if (thread == NULL)
+  {
+    return;
+  }
+  thread->exits = 0;
+  // Objects retired in the current epoch are safe two
+  // epochs later.
+  GenUtils_EpochInternalAdvance(thread->epoch);
+  GenUtils_EpochInternalAdvance(thread->epoch);
+  atomic_thread_fence(memory_order_seq_cst);
+  global = atomic_load_explicit(
+    &thread->epoch->global, memory_order_acquire);
+  GenUtils_EpochInternalReleaseSafe(thread, global);
+  // Release the objects left by unregistered threads,
+  // taking their records for a moment.
+  for (other = atomic_load_explicit(
+         &thread->epoch->threads, memory_order_acquire);
+       other != NULL; other = other->next)
+  {
+    used = false;
+    if (!atomic_load_explicit(
+          &other->used, memory_order_relaxed) &&
+        atomic_compare_exchange_strong_explicit(
+          &other->used, &used, true, memory_order_acquire,
+          memory_order_relaxed))
+    {
+      GenUtils_EpochInternalReleaseSafe(other, global);
+      atomic_store_explicit(
+        &other->used, false, memory_order_release);
+    }
+  }
+}
+
+// Release the objects of all the threads.
+void GenUtils_EpochFlush(GenUtils_Epoch *epoch)
+{
+  // A registered thread.
+  GenUtils_EpochThread *thread = NULL;
+  if (!GenUtils_EpochWasInit(epoch))
+  {
+    return;
+  }
+  for (thread = atomic_load_explicit(
+         &epoch->threads, memory_order_acquire);
+       thread != NULL; thread = thread->next)
+  {
+    for (size_t i = 0; i < 3; i++)
+    {
+      GenUtils_EpochInternalRelease(thread, i);
+    }
+  }
+}
@@ -0,0 +1,362 @@
+// File: FrozenMap.c
+// Author: DP-Dev
+// Implementation of a frozen map.
+#include <GenUtils/FrozenMap.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of prefixes in the levels prefetched below an
+// element, times the index of the element.
+#define GENUTILS_FROZEN_MAP_PREFETCH_STRIDE \
+  ((size_t)1 << GENUTILS_FROZEN_MAP_PREFETCH_LEVELS)
+
+// Number of prefixes in a cache line. The prefixes
+// prefetched below an element fill two lines.
+#define GENUTILS_FROZEN_MAP_LINE_PREFIXES \
+  (GENUTILS_CACHE_LINE / sizeof(uint64_t))
+
+_Static_assert(GENUTILS_FROZEN_MAP_PREFETCH_STRIDE ==
+                 2 * GENUTILS_FROZEN_MAP_LINE_PREFIXES,
+  "The prefetched prefixes must fill two cache lines.");
+
+// Index of the lowest bit set in a value that isn't zero.
+static inline unsigned GenUtils_FrozenMapInternalLowestBit(
+  size_t value)
+{
+#if defined(__GNUC__)
+  return (unsigned)__builtin_ctzll(value);
+#else
+  // The index of the bit.
+  unsigned index = 0;
+  while ((value & 1) == 0)
+  {
+    value >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+// Prefetch the memory of an address.
+static inline void GenUtils_FrozenMapInternalPrefetch(
+  const void *address)
+{
+#if defined(__GNUC__)
+  __builtin_prefetch(address);
+#else
+  (void)address;
+#endif
+}
+
+// Pack the first bytes of a key in big-endian order, so
+// the prefixes compare like the keys.
+static inline uint64_t GenUtils_FrozenMapInternalPrefix(
+  const char *key)
+{
+  // The prefix of the key.
+  uint64_t prefix = 0;
+  // Short keys are padded with zeros.
+  for (size_t i = 0; i < GENUTILS_FROZEN_MAP_PREFIX_SIZE;
+       i++)
+  {
+    prefix <<= 8;
+    if (*key != '\0')
+    {
+      prefix |= (unsigned char)*key;
+      key++;
+    }
+  }
+  return prefix;
+}
+
+// Fill the subtree of an element with the sorted pairs.
+static void GenUtils_FrozenMapInternalFill(
+  GenUtils_FrozenMap *frozenMap,
+  const GenUtils_BinaryTreeKeyValue *array, size_t *next,
+  size_t index)
+{
+  if (index > frozenMap->size)
+  {
+    return;
+  }
+  GenUtils_FrozenMapInternalFill(
+    frozenMap, array, next, 2 * index);
+  frozenMap->keyValues[index] = array[*next];
+  frozenMap->prefixes[index] =
+    GenUtils_FrozenMapInternalPrefix(array[*next].key);
+  (*next)++;
+  GenUtils_FrozenMapInternalFill(
+    frozenMap, array, next, 2 * index + 1);
+}
+
+// Descend to the first element whose key is greater or
+// equal to a key, or 0 if there is none. Without
+// compareKeys only the prefixes are compared, so the loop
+// has no branch that depends on the data, and the element
+// found is the first one whose prefix is greater or equal.
+static inline size_t GenUtils_FrozenMapInternalDescend(
+  GenUtils_FrozenMap *frozenMap, uint64_t prefix,
+  const char *key, bool compareKeys)
+{
+  // The element being compared.
+  size_t index = 1;
+  // The first descendant some levels below.
+  size_t descendant = 0;
+  // Whether the element is lesser than the key.
+  size_t less = 0;
+  while (index <= frozenMap->size)
+  {
+    // The prefixes of the descendants are consecutive and
+    // start at a cache line, so both lines they span are
+    // prefetched.
+    descendant =
+      GENUTILS_FROZEN_MAP_PREFETCH_STRIDE * index;
+    if (descendant <= frozenMap->size)
+    {
+      GenUtils_FrozenMapInternalPrefetch(
+        &frozenMap->prefixes[descendant]);
+    }
+    descendant += GENUTILS_FROZEN_MAP_LINE_PREFIXES;
+    if (descendant <= frozenMap->size)
+    {
+      GenUtils_FrozenMapInternalPrefetch(
+        &frozenMap->prefixes[descendant]);
+    }
+    less = frozenMap->prefixes[index] < prefix;
+    if (compareKeys)
+    {
+      less |= frozenMap->prefixes[index] == prefix &&
+        strcmp(frozenMap->keyValues[index].key, key) < 0;
+    }
+    index = 2 * index + less;
+  }
+  // Go up to the last element that wasn't lesser.
+  return index >>
+    (GenUtils_FrozenMapInternalLowestBit(~index) + 1);
+}
+
+// Search the pair of a key.
+static const GenUtils_BinaryTreeKeyValue *
+  GenUtils_FrozenMapInternalFind(
+    GenUtils_FrozenMap *frozenMap, const char *key)
+{
+  // The prefix of the key.
+  uint64_t prefix = 0;
+  // The element found.
+  size_t index = 0;
+  if (!GenUtils_FrozenMapWasInit(frozenMap) || key == NULL)
+  {
+    return NULL;
+  }
+  prefix = GenUtils_FrozenMapInternalPrefix(key);
+  index = GenUtils_FrozenMapInternalDescend(
+    frozenMap, prefix, key, false);
+  if (index == 0 || frozenMap->prefixes[index] != prefix)
+  {
+    return NULL;
+  }
+  // Only when other keys share the prefix of the key, they
+  // are compared in a second search.
+  if (strcmp(frozenMap->keyValues[index].key, key) != 0)
+  {
+    index = GenUtils_FrozenMapInternalDescend(
+      frozenMap, prefix, key, true);
+    if (index == 0 ||
+        frozenMap->prefixes[index] != prefix ||
+        strcmp(frozenMap->keyValues[index].key, key) != 0)
+    {
+      return NULL;
+    }
+  }
+  return &frozenMap->keyValues[index];
+}
+
+// Create a frozen map.
+GenUtils_FrozenMap *GenUtils_FrozenMapCreate(
+  GenUtils_BinaryTree *binaryTree)
+{
+  return GenUtils_FrozenMapCreateWithAllocator(
+    binaryTree, NULL);
+}
+
+// Create a frozen map that uses an allocator.
+GenUtils_FrozenMap *GenUtils_FrozenMapCreateWithAllocator(
+  GenUtils_BinaryTree *binaryTree,
+  const GenUtils_Allocator *allocator)
+{
+  // The frozen map to create.
+  GenUtils_FrozenMap *frozenMap = NULL;
+  // The sorted pairs of the tree.
+  GenUtils_BinaryTreeKeyValue *array = NULL;
+  // The next pair to store.
+  size_t next = 0;
+  // Address of the first aligned byte of the block.
+  uintptr_t aligned = 0;
+  if (!GenUtils_BinaryTreeWasInit(binaryTree))
+  {
+    return NULL;
+  }
+  frozenMap = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_FrozenMap));
+  if (frozenMap == NULL)
+  {
+    return NULL;
+  }
+  frozenMap->size = GenUtils_BinaryTreeGetSize(binaryTree);
+  frozenMap->allocator = allocator;
+  if (frozenMap->size >=
+      (SIZE_MAX - GENUTILS_CACHE_LINE) /
+        (sizeof(uint64_t) +
+          sizeof(GenUtils_BinaryTreeKeyValue)))
+  {
+    GenUtils_AllocatorFree(
+      allocator, frozenMap, sizeof(GenUtils_FrozenMap));
+    return NULL;
+  }
+  // Both arrays keep their first element unused.
+  frozenMap->blockSize = GENUTILS_CACHE_LINE +
+    (frozenMap->size + 1) *
+      (sizeof(uint64_t) +
+        sizeof(GenUtils_BinaryTreeKeyValue));
+  frozenMap->block = GenUtils_AllocatorAlloc(
+    allocator, frozenMap->blockSize);
+  if (frozenMap->size != 0)
+  {
+    array = GenUtils_BinaryTreeToArray(binaryTree);
+  }
+  if (frozenMap->block == NULL ||
+      (frozenMap->size != 0 && array == NULL))
+  {
+    free(array);
+    GenUtils_AllocatorFree(
+      allocator, frozenMap->block, frozenMap->blockSize);
+    GenUtils_AllocatorFree(
+      allocator, frozenMap, sizeof(GenUtils_FrozenMap));
+    return NULL;
+  }
+  aligned = ((uintptr_t)frozenMap->block +
+              GENUTILS_CACHE_LINE - 1) &
+    ~(uintptr_t)(GENUTILS_CACHE_LINE - 1);
+  frozenMap->prefixes = (uint64_t *)aligned;
+  frozenMap->keyValues =
+    (GenUtils_BinaryTreeKeyValue *)(frozenMap->prefixes +
+      frozenMap->size + 1);
+  frozenMap->prefixes[0] = 0;
+  frozenMap->keyValues[0].key = NULL;
+  frozenMap->keyValues[0].value = NULL;
+  GenUtils_FrozenMapInternalFill(
+    frozenMap, array, &next, 1);
+  free(array);
+  return frozenMap;
+}
+
+// Destroy a frozen map.
+void GenUtils_FrozenMapDestroy(
+  GenUtils_FrozenMap *frozenMap)
+{
+  if (!GenUtils_FrozenMapWasInit(frozenMap))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the map at
+  // once.
+  if (GenUtils_AllocatorReset(frozenMap->allocator))
+  {
+    return;
+  }
+  GenUtils_AllocatorFree(frozenMap->allocator,
+    frozenMap->block, frozenMap->blockSize);
+  GenUtils_AllocatorFree(frozenMap->allocator, frozenMap,
+    sizeof(GenUtils_FrozenMap));
+}
+
+// Check if a frozen map was initialized.
+bool GenUtils_FrozenMapWasInit(
+  GenUtils_FrozenMap *frozenMap)
+{
+  if (frozenMap != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the size of a frozen map.
+size_t GenUtils_FrozenMapGetSize(
+  GenUtils_FrozenMap *frozenMap)
+{
+  if (GenUtils_FrozenMapWasInit(frozenMap))
+  {
+    return frozenMap->size;
+  }
+  return 0;
+}
+
+// Check if a frozen map is empty.
+bool GenUtils_FrozenMapEmpty(GenUtils_FrozenMap *frozenMap)
+{
+  return GenUtils_FrozenMapGetSize(frozenMap) == 0;
+}
+
+// Check if a key exists.
+bool GenUtils_FrozenMapExist(
+  GenUtils_FrozenMap *frozenMap, const char *key)
+{
+  return GenUtils_FrozenMapInternalFind(frozenMap, key) !=
+    NULL;
+}
+
+// Get the value of a key.
+void *GenUtils_FrozenMapGet(
+  GenUtils_FrozenMap *frozenMap, const char *key)
+{
+  // The pair of the key.
+  const GenUtils_BinaryTreeKeyValue *keyValue =
+    GenUtils_FrozenMapInternalFind(frozenMap, key);
+  if (keyValue == NULL)
+  {
+    return NULL;
+  }
+  return keyValue->value;
+}
+
+// Iterate through all the elements in order.
+void GenUtils_FrozenMapInorder(
+  GenUtils_FrozenMap *frozenMap, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  // The element being visited.
+  size_t index = 1;
+  if (!GenUtils_FrozenMapWasInit(frozenMap) ||
+      function == NULL || frozenMap->size == 0)
+  {
+    return;
+  }
+  // Start at the leftmost element.
+  while (2 * index <= frozenMap->size)
+  {
+    index *= 2;
+  }
+  while (index != 0)
+  {
+    function(&frozenMap->keyValues[index], extradata);
+    if (2 * index + 1 <= frozenMap->size)
+    {
+      // The next element is the leftmost of the right
+      // subtree.
+      index = 2 * index + 1;
+      while (2 * index <= frozenMap->size)
+      {
+        index *= 2;
+      }
+    }
+    else
+    {
+      // The next element is the first ancestor reached
+      // from a left subtree.
+      index >>=
+        GenUtils_FrozenMapInternalLowestBit(~index) + 1;
+    }
+  }
+}
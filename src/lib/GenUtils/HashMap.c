@@ -0,0 +1,658 @@
+// File: HashMap.c
+// Author: DP-Dev
+// Implementation of a hash map.
+#include <GenUtils/HashMap.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Control byte of a slot never used.
+#define GENUTILS_HASH_MAP_EMPTY 0x80
+// Control byte of a removed slot.
+#define GENUTILS_HASH_MAP_DELETED 0xFE
+
+// Number of slots that can be used in a map of a capacity,
+// keeping a load factor of 7/8.
+#define GENUTILS_HASH_MAP_MAX_LOAD(capacity) \
+  ((capacity) - (capacity) / 8)
+
+// Index of the lowest bit set in a mask that isn't zero.
+static inline unsigned GenUtils_HashMapInternalLowestBit(
+  uint32_t mask)
+{
+#if defined(__GNUC__)
+  return (unsigned)__builtin_ctz(mask);
+#else
+  // The index of the bit.
+  unsigned index = 0;
+  while ((mask & 1) == 0)
+  {
+    mask >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+// Index of the highest bit set in a mask that isn't zero.
+static inline unsigned GenUtils_HashMapInternalHighestBit(
+  uint32_t mask)
+{
+#if defined(__GNUC__)
+  return 31 - (unsigned)__builtin_clz(mask);
+#else
+  // The index of the bit.
+  unsigned index = 0;
+  while (mask > 1)
+  {
+    mask >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+// Get a mask with a bit for every control byte of a group
+// equal to a value.
+static inline uint32_t GenUtils_HashMapInternalMatch(
+  const uint8_t *group, uint8_t value)
+{
+#ifdef __SSE2__
+  return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(
+    _mm_set1_epi8((char)value),
+    _mm_loadu_si128((const __m128i *)group)));
+#else
+  // The mask to return.
+  uint32_t mask = 0;
+  for (unsigned i = 0; i < GENUTILS_HASH_MAP_GROUP_WIDTH;
+       i++)
+  {
+    if (group[i] == value)
+    {
+      mask |= 1u << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+// Get a mask with a bit for every slot of a group that is
+// empty or removed. Their control bytes have the high bit
+// set.
+static inline uint32_t GenUtils_HashMapInternalMatchFree(
+  const uint8_t *group)
+{
+#ifdef __SSE2__
+  return (uint32_t)_mm_movemask_epi8(
+    _mm_loadu_si128((const __m128i *)group));
+#else
+  // The mask to return.
+  uint32_t mask = 0;
+  for (unsigned i = 0; i < GENUTILS_HASH_MAP_GROUP_WIDTH;
+       i++)
+  {
+    if ((group[i] & 0x80) != 0)
+    {
+      mask |= 1u << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+// Hash a key. FNV-1a, followed by a final mix so the high
+// bits also depend on every byte.
+static inline size_t GenUtils_HashMapInternalHash(
+  const char *key)
+{
+  // The hash of the key.
+  uint64_t hash = 14695981039346656037ULL;
+  while (*key != '\0')
+  {
+    hash ^= (unsigned char)*key;
+    hash *= 1099511628211ULL;
+    key++;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33;
+  return (size_t)hash;
+}
+
+// Get the bits of a hash stored in the control byte.
+static inline uint8_t GenUtils_HashMapInternalH2(
+  size_t hash)
+{
+  return (uint8_t)(hash & 0x7F);
+}
+
+// Set the control byte of a slot, and its copy after the
+// end if it's in the first group.
+static inline void GenUtils_HashMapInternalSetControl(
+  GenUtils_HashMap *hashMap, size_t index, uint8_t value)
+{
+  hashMap->control[index] = value;
+  if (index < GENUTILS_HASH_MAP_GROUP_WIDTH)
+  {
+    hashMap->control[hashMap->capacity + index] = value;
+  }
+}
+
+// Number of bytes of the slots and control bytes of a map.
+static inline size_t GenUtils_HashMapInternalBlockSize(
+  size_t capacity)
+{
+  return capacity * sizeof(GenUtils_HashMapSlot) +
+    capacity + GENUTILS_HASH_MAP_GROUP_WIDTH;
+}
+
+// Search the slot of a key. Returns the capacity if the key
+// isn't found.
+static size_t GenUtils_HashMapInternalFind(
+  GenUtils_HashMap *hashMap, const char *key, size_t hash)
+{
+  // Mask to wrap the positions.
+  size_t mask = hashMap->capacity - 1;
+  // The first slot of the current group.
+  size_t position = (hash >> 7) & mask;
+  // Distance to the next group.
+  size_t step = 0;
+  // Slots of the group whose control byte matches.
+  uint32_t matches = 0;
+  // The slot being checked.
+  size_t index = 0;
+  if (hashMap->capacity == 0)
+  {
+    return 0;
+  }
+  // Probe the groups until a group with an empty slot.
+  while (true)
+  {
+    matches = GenUtils_HashMapInternalMatch(
+      hashMap->control + position,
+      GenUtils_HashMapInternalH2(hash));
+    while (matches != 0)
+    {
+      index = position +
+        GenUtils_HashMapInternalLowestBit(matches);
+      index &= mask;
+      if (hashMap->slots[index].hash == hash &&
+          strcmp(hashMap->slots[index].keyValue.key, key) ==
+            0)
+      {
+        return index;
+      }
+      matches &= matches - 1;
+    }
+    if (GenUtils_HashMapInternalMatch(
+          hashMap->control + position,
+          GENUTILS_HASH_MAP_EMPTY) != 0)
+    {
+      return hashMap->capacity;
+    }
+    step += GENUTILS_HASH_MAP_GROUP_WIDTH;
+    position = (position + step) & mask;
+  }
+}
+
+// Search the first empty or removed slot for a hash. The
+// map must have free slots.
+static size_t GenUtils_HashMapInternalFindFree(
+  GenUtils_HashMap *hashMap, size_t hash)
+{
+  // Mask to wrap the positions.
+  size_t mask = hashMap->capacity - 1;
+  // The first slot of the current group.
+  size_t position = (hash >> 7) & mask;
+  // Distance to the next group.
+  size_t step = 0;
+  // Free slots of the group.
+  uint32_t matches = 0;
+  while (true)
+  {
+    matches = GenUtils_HashMapInternalMatchFree(
+      hashMap->control + position);
+    if (matches != 0)
+    {
+      return (position +
+               GenUtils_HashMapInternalLowestBit(
+                 matches)) & mask;
+    }
+    step += GENUTILS_HASH_MAP_GROUP_WIDTH;
+    position = (position + step) & mask;
+  }
+}
+
+// Get the smallest capacity that holds a number of
+// elements. Returns 0 on overflow.
+static size_t GenUtils_HashMapInternalCapacityFor(
+  size_t count)
+{
+  // The capacity, a power of two.
+  size_t capacity = GENUTILS_HASH_MAP_GROUP_WIDTH;
+  while (GENUTILS_HASH_MAP_MAX_LOAD(capacity) < count)
+  {
+    if (capacity > SIZE_MAX / 2)
+    {
+      return 0;
+    }
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+// Move the elements of a map to new slots.
+static bool GenUtils_HashMapInternalResize(
+  GenUtils_HashMap *hashMap, size_t capacity)
+{
+  // The old slots.
+  GenUtils_HashMapSlot *slots = hashMap->slots;
+  // The old control bytes.
+  uint8_t *control = hashMap->control;
+  // The old capacity.
+  size_t oldCapacity = hashMap->capacity;
+  // The slot of an element in the new slots.
+  size_t index = 0;
+  if (capacity >
+      (SIZE_MAX - GENUTILS_HASH_MAP_GROUP_WIDTH) /
+        (sizeof(GenUtils_HashMapSlot) + 1))
+  {
+    return false;
+  }
+  hashMap->slots = GenUtils_AllocatorAlloc(
+    hashMap->allocator,
+    GenUtils_HashMapInternalBlockSize(capacity));
+  if (hashMap->slots == NULL)
+  {
+    hashMap->slots = slots;
+    return false;
+  }
+  hashMap->control = (uint8_t *)(hashMap->slots + capacity);
+  hashMap->capacity = capacity;
+  memset(hashMap->control, GENUTILS_HASH_MAP_EMPTY,
+    capacity + GENUTILS_HASH_MAP_GROUP_WIDTH);
+  // Insert the elements again with their cached hashes.
+  for (size_t i = 0; i < oldCapacity; i++)
+  {
+    if ((control[i] & 0x80) == 0)
+    {
+      index = GenUtils_HashMapInternalFindFree(
+        hashMap, slots[i].hash);
+      GenUtils_HashMapInternalSetControl(hashMap, index,
+        GenUtils_HashMapInternalH2(slots[i].hash));
+      hashMap->slots[index] = slots[i];
+    }
+  }
+  hashMap->growthLeft =
+    GENUTILS_HASH_MAP_MAX_LOAD(capacity) - hashMap->size;
+  GenUtils_AllocatorFree(hashMap->allocator, slots,
+    GenUtils_HashMapInternalBlockSize(oldCapacity));
+  return true;
+}
+
+// Remove the element in a slot.
+static void GenUtils_HashMapInternalErase(
+  GenUtils_HashMap *hashMap, size_t index)
+{
+  // Mask to wrap the positions.
+  size_t mask = hashMap->capacity - 1;
+  // Empty slots of the group that starts at the slot.
+  uint32_t emptyAfter = GenUtils_HashMapInternalMatch(
+    hashMap->control + index, GENUTILS_HASH_MAP_EMPTY);
+  // Empty slots of the group that ends before the slot.
+  uint32_t emptyBefore = GenUtils_HashMapInternalMatch(
+    hashMap->control +
+      ((index - GENUTILS_HASH_MAP_GROUP_WIDTH) & mask),
+    GENUTILS_HASH_MAP_EMPTY);
+  hashMap->size--;
+  // If no group that holds the slot was ever full, no probe
+  // went past it, so it can be empty again.
+  if (emptyAfter != 0 && emptyBefore != 0 &&
+      (GENUTILS_HASH_MAP_GROUP_WIDTH - 1 -
+        GenUtils_HashMapInternalHighestBit(emptyBefore)) +
+          GenUtils_HashMapInternalLowestBit(emptyAfter) <
+        GENUTILS_HASH_MAP_GROUP_WIDTH)
+  {
+    GenUtils_HashMapInternalSetControl(
+      hashMap, index, GENUTILS_HASH_MAP_EMPTY);
+    hashMap->growthLeft++;
+    return;
+  }
+  GenUtils_HashMapInternalSetControl(
+    hashMap, index, GENUTILS_HASH_MAP_DELETED);
+}
+
+// Create a hash map.
+GenUtils_HashMap *GenUtils_HashMapCreate()
+{
+  return GenUtils_HashMapCreateWithAllocator(NULL);
+}
+
+// Create a hash map that uses an allocator.
+GenUtils_HashMap *GenUtils_HashMapCreateWithAllocator(
+  const GenUtils_Allocator *allocator)
+{
+  // The map to create.
+  GenUtils_HashMap *hashMap = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_HashMap));
+  if (hashMap == NULL)
+  {
+    return NULL;
+  }
+  // The slots are allocated with the first element.
+  hashMap->slots = NULL;
+  hashMap->control = NULL;
+  hashMap->size = 0;
+  hashMap->capacity = 0;
+  hashMap->growthLeft = 0;
+  hashMap->allocator = allocator;
+  return hashMap;
+}
+
+// Destroy a hash map.
+void GenUtils_HashMapDestroy(GenUtils_HashMap *hashMap)
+{
+  if (!GenUtils_HashMapWasInit(hashMap))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the map and its
+  // slots at once.
+  if (GenUtils_AllocatorReset(hashMap->allocator))
+  {
+    return;
+  }
+  GenUtils_AllocatorFree(hashMap->allocator, hashMap->slots,
+    GenUtils_HashMapInternalBlockSize(hashMap->capacity));
+  GenUtils_AllocatorFree(hashMap->allocator, hashMap,
+    sizeof(GenUtils_HashMap));
+}
+
+// Check if a hash map was initialized.
+bool GenUtils_HashMapWasInit(GenUtils_HashMap *hashMap)
+{
+  if (hashMap != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the size of a hash map.
+size_t GenUtils_HashMapGetSize(GenUtils_HashMap *hashMap)
+{
+  if (GenUtils_HashMapWasInit(hashMap))
+  {
+    return hashMap->size;
+  }
+  return 0;
+}
+
+// Query if a hash map is empty.
+bool GenUtils_HashMapEmpty(GenUtils_HashMap *hashMap)
+{
+  if (GenUtils_HashMapWasInit(hashMap) &&
+      hashMap->size == 0)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the capacity of a hash map.
+size_t GenUtils_HashMapGetCapacity(
+  GenUtils_HashMap *hashMap)
+{
+  if (GenUtils_HashMapWasInit(hashMap))
+  {
+    return hashMap->capacity;
+  }
+  return 0;
+}
+
+// Check if a key exists.
+bool GenUtils_HashMapExist(
+  GenUtils_HashMap *hashMap, const char *key)
+{
+  if (!GenUtils_HashMapWasInit(hashMap) || key == NULL)
+  {
+    return false;
+  }
+  return GenUtils_HashMapInternalFind(hashMap, key,
+           GenUtils_HashMapInternalHash(key)) <
+    hashMap->capacity;
+}
+
+// Get the value of a key.
+void *GenUtils_HashMapGet(
+  GenUtils_HashMap *hashMap, const char *key)
+{
+  // The slot of the key.
+  size_t index = 0;
+  if (!GenUtils_HashMapWasInit(hashMap) || key == NULL)
+  {
+    return NULL;
+  }
+  index = GenUtils_HashMapInternalFind(
+    hashMap, key, GenUtils_HashMapInternalHash(key));
+  if (index == hashMap->capacity)
+  {
+    return NULL;
+  }
+  return hashMap->slots[index].keyValue.value;
+}
+
+// Set the value of a key.
+bool GenUtils_HashMapSet(GenUtils_HashMap *hashMap,
+  GenUtils_BinaryTreeKeyValue keyValue)
+{
+  // The slot of the key.
+  size_t index = 0;
+  if (!GenUtils_HashMapWasInit(hashMap) ||
+      keyValue.key == NULL)
+  {
+    return false;
+  }
+  index = GenUtils_HashMapInternalFind(hashMap,
+    keyValue.key,
+    GenUtils_HashMapInternalHash(keyValue.key));
+  if (index == hashMap->capacity)
+  {
+    return false;
+  }
+  // If is found, set the new value.
+  hashMap->slots[index].keyValue.value = keyValue.value;
+  return true;
+}
+
+// Insert a pair in a hash map.
+bool GenUtils_HashMapInsert(GenUtils_HashMap *hashMap,
+  GenUtils_BinaryTreeKeyValue keyValue)
+{
+  // The hash of the key.
+  size_t hash = 0;
+  // The slot of the new pair.
+  size_t index = 0;
+  // The capacity after growing.
+  size_t capacity = 0;
+  if (!GenUtils_HashMapWasInit(hashMap) ||
+      keyValue.key == NULL)
+  {
+    return false;
+  }
+  hash = GenUtils_HashMapInternalHash(keyValue.key);
+  if (GenUtils_HashMapInternalFind(
+        hashMap, keyValue.key, hash) < hashMap->capacity)
+  {
+    return false;
+  }
+  if (hashMap->growthLeft == 0)
+  {
+    // Drop the removed slots if they take most of the room,
+    // otherwise double the capacity.
+    capacity = hashMap->capacity;
+    if (capacity == 0)
+    {
+      capacity = GENUTILS_HASH_MAP_GROUP_WIDTH;
+    }
+    else if (hashMap->size >=
+             GENUTILS_HASH_MAP_MAX_LOAD(capacity) / 2)
+    {
+      capacity *= 2;
+    }
+    if (capacity == 0 ||
+        !GenUtils_HashMapInternalResize(hashMap, capacity))
+    {
+      return false;
+    }
+  }
+  index = GenUtils_HashMapInternalFindFree(hashMap, hash);
+  if (hashMap->control[index] == GENUTILS_HASH_MAP_EMPTY)
+  {
+    hashMap->growthLeft--;
+  }
+  GenUtils_HashMapInternalSetControl(
+    hashMap, index, GenUtils_HashMapInternalH2(hash));
+  hashMap->slots[index].keyValue = keyValue;
+  hashMap->slots[index].hash = hash;
+  hashMap->size++;
+  return true;
+}
+
+// Remove a pair and return its value.
+void *GenUtils_HashMapRemove(
+  GenUtils_HashMap *hashMap, const char *key)
+{
+  // The slot of the key.
+  size_t index = 0;
+  if (!GenUtils_HashMapWasInit(hashMap) || key == NULL)
+  {
+    return NULL;
+  }
+  index = GenUtils_HashMapInternalFind(
+    hashMap, key, GenUtils_HashMapInternalHash(key));
+  if (index == hashMap->capacity)
+  {
+    return NULL;
+  }
+  GenUtils_HashMapInternalErase(hashMap, index);
+  return hashMap->slots[index].keyValue.value;
+}
+
+// Remove a pair.
+bool GenUtils_HashMapRemoveBool(
+  GenUtils_HashMap *hashMap, const char *key)
+{
+  // The slot of the key.
+  size_t index = 0;
+  if (!GenUtils_HashMapWasInit(hashMap) || key == NULL)
+  {
+    return false;
+  }
+  index = GenUtils_HashMapInternalFind(
+    hashMap, key, GenUtils_HashMapInternalHash(key));
+  if (index == hashMap->capacity)
+  {
+    return false;
+  }
+  GenUtils_HashMapInternalErase(hashMap, index);
+  return true;
+}
+
+// Grow a hash map.
+bool GenUtils_HashMapReserve(
+  GenUtils_HashMap *hashMap, size_t count)
+{
+  // The capacity needed for count elements.
+  size_t capacity = 0;
+  if (!GenUtils_HashMapWasInit(hashMap))
+  {
+    return false;
+  }
+  if (count <= hashMap->size + hashMap->growthLeft)
+  {
+    return true;
+  }
+  capacity = GenUtils_HashMapInternalCapacityFor(count);
+  if (capacity == 0)
+  {
+    return false;
+  }
+  // Removed slots are dropped if the capacity is enough.
+  if (capacity < hashMap->capacity)
+  {
+    capacity = hashMap->capacity;
+  }
+  return GenUtils_HashMapInternalResize(hashMap, capacity);
+}
+
+// Rehash a hash map.
+bool GenUtils_HashMapRehash(
+  GenUtils_HashMap *hashMap, size_t count)
+{
+  // The capacity needed for count elements.
+  size_t capacity = 0;
+  if (!GenUtils_HashMapWasInit(hashMap))
+  {
+    return false;
+  }
+  if (count < hashMap->size)
+  {
+    count = hashMap->size;
+  }
+  // An empty map without room releases its slots.
+  if (count == 0)
+  {
+    GenUtils_AllocatorFree(hashMap->allocator,
+      hashMap->slots,
+      GenUtils_HashMapInternalBlockSize(hashMap->capacity));
+    hashMap->slots = NULL;
+    hashMap->control = NULL;
+    hashMap->capacity = 0;
+    hashMap->growthLeft = 0;
+    return true;
+  }
+  capacity = GenUtils_HashMapInternalCapacityFor(count);
+  if (capacity == 0)
+  {
+    return false;
+  }
+  return GenUtils_HashMapInternalResize(hashMap, capacity);
+}
+
+// Remove all the elements of a hash map.
+void GenUtils_HashMapClear(GenUtils_HashMap *hashMap)
+{
+  if (GenUtils_HashMapGetCapacity(hashMap) == 0)
+  {
+    return;
+  }
+  memset(hashMap->control, GENUTILS_HASH_MAP_EMPTY,
+    hashMap->capacity + GENUTILS_HASH_MAP_GROUP_WIDTH);
+  hashMap->size = 0;
+  hashMap->growthLeft =
+    GENUTILS_HASH_MAP_MAX_LOAD(hashMap->capacity);
+}
+
+// Iterate a hash map with a function.
+void GenUtils_HashMapIterate(GenUtils_HashMap *hashMap,
+  void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  // Verify the function.
+  if (function == NULL ||
+      GenUtils_HashMapGetSize(hashMap) == 0)
+  {
+    return;
+  }
+  // Calls the function with every full slot.
+  for (size_t i = 0; i < hashMap->capacity; i++)
+  {
+    if ((hashMap->control[i] & 0x80) == 0)
+    {
+      function(&hashMap->slots[i].keyValue, extradata);
+    }
+  }
+}
@@ -0,0 +1,238 @@
+// File: ICDLL.c
+// Author: DP-Dev
+// Implementation of an intrusive CDLL.
+#include <GenUtils/ICDLL.h>
+
+// Link a link before another one.
+static inline void GenUtils_ICDLLInternalLinkBefore(
+  GenUtils_DoubleLink *position, GenUtils_DoubleLink *link)
+{
+  link->previous = position->previous;
+  link->next = position;
+  position->previous->next = link;
+  position->previous = link;
+}
+
+// Initialize an intrusive CDLL.
+void GenUtils_ICDLLInit(GenUtils_ICDLL *list)
+{
+  if (GenUtils_ICDLLWasInit(list))
+  {
+    list->head = NULL;
+    list->size = 0;
+  }
+}
+
+// Get the size of a list.
+size_t GenUtils_ICDLLGetSize(GenUtils_ICDLL *list)
+{
+  if (GenUtils_ICDLLWasInit(list))
+  {
+    return list->size;
+  }
+  return 0;
+}
+
+// Query if a list is empty.
+bool GenUtils_ICDLLEmpty(GenUtils_ICDLL *list)
+{
+  if (GenUtils_ICDLLWasInit(list) && list->size == 0)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Check if a list was initialized.
+bool GenUtils_ICDLLWasInit(GenUtils_ICDLL *list)
+{
+  if (list != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the head link.
+GenUtils_DoubleLink *GenUtils_ICDLLBegin(
+  GenUtils_ICDLL *list)
+{
+  if (GenUtils_ICDLLGetSize(list) == 0)
+  {
+    return NULL;
+  }
+  return list->head;
+}
+
+// Get the tail link.
+GenUtils_DoubleLink *GenUtils_ICDLLEnd(GenUtils_ICDLL *list)
+{
+  if (GenUtils_ICDLLGetSize(list) == 0)
+  {
+    return NULL;
+  }
+  return list->head->previous;
+}
+
+// Get the next link.
+GenUtils_DoubleLink *GenUtils_ICDLLNext(
+  GenUtils_ICDLL *list, GenUtils_DoubleLink *link)
+{
+  if (link == NULL || link == GenUtils_ICDLLEnd(list))
+  {
+    return NULL;
+  }
+  return link->next;
+}
+
+// Get the previous link.
+GenUtils_DoubleLink *GenUtils_ICDLLPrevious(
+  GenUtils_ICDLL *list, GenUtils_DoubleLink *link)
+{
+  if (link == NULL || link == GenUtils_ICDLLBegin(list))
+  {
+    return NULL;
+  }
+  return link->previous;
+}
+
+// Insert a link before another one.
+void GenUtils_ICDLLInsert(GenUtils_ICDLL *list,
+  GenUtils_DoubleLink *position, GenUtils_DoubleLink *link)
+{
+  if (!GenUtils_ICDLLWasInit(list) || link == NULL)
+  {
+    return;
+  }
+  // The link will be the only one.
+  if (list->size == 0)
+  {
+    link->previous = link;
+    link->next = link;
+    list->head = link;
+    list->size = 1;
+    return;
+  }
+  if (position == NULL)
+  {
+    return;
+  }
+  GenUtils_ICDLLInternalLinkBefore(position, link);
+  if (position == list->head)
+  {
+    list->head = link;
+  }
+  list->size++;
+}
+
+// Insert a link after another one.
+void GenUtils_ICDLLInsertAfter(GenUtils_ICDLL *list,
+  GenUtils_DoubleLink *position, GenUtils_DoubleLink *link)
+{
+  if (!GenUtils_ICDLLWasInit(list) || link == NULL)
+  {
+    return;
+  }
+  if (list->size == 0)
+  {
+    GenUtils_ICDLLInsert(list, NULL, link);
+    return;
+  }
+  if (position == NULL)
+  {
+    return;
+  }
+  GenUtils_ICDLLInternalLinkBefore(position->next, link);
+  list->size++;
+}
+
+// Remove a link.
+void GenUtils_ICDLLRemove(
+  GenUtils_ICDLL *list, GenUtils_DoubleLink *link)
+{
+  if (link == NULL || GenUtils_ICDLLGetSize(list) == 0)
+  {
+    return;
+  }
+  if (list->size == 1)
+  {
+    list->head = NULL;
+    list->size = 0;
+    return;
+  }
+  link->previous->next = link->next;
+  link->next->previous = link->previous;
+  if (link == list->head)
+  {
+    list->head = link->next;
+  }
+  list->size--;
+}
+
+// Add a link at the tail of the list.
+void GenUtils_ICDLLPushBack(
+  GenUtils_ICDLL *list, GenUtils_DoubleLink *link)
+{
+  GenUtils_ICDLLInsertAfter(
+    list, GenUtils_ICDLLEnd(list), link);
+}
+
+// Add a link at the head of the list.
+void GenUtils_ICDLLPushFront(
+  GenUtils_ICDLL *list, GenUtils_DoubleLink *link)
+{
+  GenUtils_ICDLLInsert(
+    list, GenUtils_ICDLLBegin(list), link);
+}
+
+// Remove the tail of the list.
+GenUtils_DoubleLink *GenUtils_ICDLLPopBack(
+  GenUtils_ICDLL *list)
+{
+  // The tail link.
+  GenUtils_DoubleLink *link = GenUtils_ICDLLEnd(list);
+  GenUtils_ICDLLRemove(list, link);
+  return link;
+}
+
+// Remove the head of the list.
+GenUtils_DoubleLink *GenUtils_ICDLLPopFront(
+  GenUtils_ICDLL *list)
+{
+  // The head link.
+  GenUtils_DoubleLink *link = GenUtils_ICDLLBegin(list);
+  GenUtils_ICDLLRemove(list, link);
+  return link;
+}
+
+// Remove all the links of a list.
+void GenUtils_ICDLLClear(GenUtils_ICDLL *list)
+{
+  GenUtils_ICDLLInit(list);
+}
+
+// Iterate a list with a function.
+void GenUtils_ICDLLIterate(GenUtils_ICDLL *list,
+  void *extradata,
+  void (*function)(GenUtils_DoubleLink *, void *))
+{
+  // The current link.
+  GenUtils_DoubleLink *currentLink =
+    GenUtils_ICDLLBegin(list);
+  // The link after the current one.
+  GenUtils_DoubleLink *nextLink = NULL;
+  // The number of links to visit.
+  size_t size = GenUtils_ICDLLGetSize(list);
+  // Verify the function.
+  if (function == NULL)
+  {
+    return;
+  }
+  // Calls the function, reading the next link first.
+  for (size_t i = 0; i < size; i++)
+  {
+    nextLink = currentLink->next;
+    function(currentLink, extradata);
+    currentLink = nextLink;
+  }
+}
@@ -0,0 +1,248 @@
+// File: ICSLL.c
+// Author: DP-Dev
+// Implementation of an intrusive CSLL.
+#include <GenUtils/ICSLL.h>
+
+// Initialize an intrusive CSLL.
+void GenUtils_ICSLLInit(GenUtils_ICSLL *list)
+{
+  if (GenUtils_ICSLLWasInit(list))
+  {
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+  }
+}
+
+// Get the size of a list.
+size_t GenUtils_ICSLLGetSize(GenUtils_ICSLL *list)
+{
+  if (GenUtils_ICSLLWasInit(list))
+  {
+    return list->size;
+  }
+  return 0;
+}
+
+// Query if a list is empty.
+bool GenUtils_ICSLLEmpty(GenUtils_ICSLL *list)
+{
+  if (GenUtils_ICSLLWasInit(list) && list->size == 0)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Check if a list was initialized.
+bool GenUtils_ICSLLWasInit(GenUtils_ICSLL *list)
+{
+  if (list != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the head link.
+GenUtils_SingleLink *GenUtils_ICSLLBegin(
+  GenUtils_ICSLL *list)
+{
+  if (GenUtils_ICSLLGetSize(list) == 0)
+  {
+    return NULL;
+  }
+  return list->head;
+}
+
+// Get the tail link.
+GenUtils_SingleLink *GenUtils_ICSLLEnd(GenUtils_ICSLL *list)
+{
+  if (GenUtils_ICSLLGetSize(list) == 0)
+  {
+    return NULL;
+  }
+  return list->tail;
+}
+
+// Get the next link.
+GenUtils_SingleLink *GenUtils_ICSLLNext(
+  GenUtils_ICSLL *list, GenUtils_SingleLink *link)
+{
+  if (link == NULL || link == GenUtils_ICSLLEnd(list))
+  {
+    return NULL;
+  }
+  return link->next;
+}
+
+// Insert a link after another one.
+void GenUtils_ICSLLInsertAfter(GenUtils_ICSLL *list,
+  GenUtils_SingleLink *position, GenUtils_SingleLink *link)
+{
+  if (!GenUtils_ICSLLWasInit(list) || link == NULL)
+  {
+    return;
+  }
+  // The link will be the only one.
+  if (list->size == 0)
+  {
+    link->next = link;
+    list->head = link;
+    list->tail = link;
+    list->size = 1;
+    return;
+  }
+  if (position == NULL)
+  {
+    return;
+  }
+  link->next = position->next;
+  position->next = link;
+  if (position == list->tail)
+  {
+    list->tail = link;
+  }
+  list->size++;
+}
+
+// Remove a link.
+bool GenUtils_ICSLLRemove(
+  GenUtils_ICSLL *list, GenUtils_SingleLink *link)
+{
+  // The link before the current one.
+  GenUtils_SingleLink *previous = NULL;
+  if (link == NULL || GenUtils_ICSLLGetSize(list) == 0)
+  {
+    return false;
+  }
+  // Search the link before, starting at the tail.
+  previous = list->tail;
+  for (size_t i = 0; i < list->size; i++)
+  {
+    if (previous->next == link)
+    {
+      GenUtils_ICSLLRemoveAfter(list, previous);
+      return true;
+    }
+    previous = previous->next;
+  }
+  return false;
+}
+
+// Remove the link after another one.
+GenUtils_SingleLink *GenUtils_ICSLLRemoveAfter(
+  GenUtils_ICSLL *list, GenUtils_SingleLink *position)
+{
+  // The link to remove.
+  GenUtils_SingleLink *link = NULL;
+  if (position == NULL || GenUtils_ICSLLGetSize(list) == 0)
+  {
+    return NULL;
+  }
+  // The link after the tail is the head.
+  link = position->next;
+  if (list->size == 1)
+  {
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    return link;
+  }
+  position->next = link->next;
+  if (link == list->head)
+  {
+    list->head = link->next;
+  }
+  if (link == list->tail)
+  {
+    list->tail = position;
+  }
+  list->size--;
+  return link;
+}
+
+// Add a link at the tail of the list.
+void GenUtils_ICSLLPushBack(
+  GenUtils_ICSLL *list, GenUtils_SingleLink *link)
+{
+  GenUtils_ICSLLInsertAfter(
+    list, GenUtils_ICSLLEnd(list), link);
+}
+
+// Add a link at the head of the list.
+void GenUtils_ICSLLPushFront(
+  GenUtils_ICSLL *list, GenUtils_SingleLink *link)
+{
+  if (!GenUtils_ICSLLWasInit(list) || link == NULL)
+  {
+    return;
+  }
+  if (list->size == 0)
+  {
+    GenUtils_ICSLLInsertAfter(list, NULL, link);
+    return;
+  }
+  link->next = list->head;
+  list->tail->next = link;
+  list->head = link;
+  list->size++;
+}
+
+// Remove the tail of the list.
+GenUtils_SingleLink *GenUtils_ICSLLPopBack(
+  GenUtils_ICSLL *list)
+{
+  // The link before the tail.
+  GenUtils_SingleLink *previous = NULL;
+  if (GenUtils_ICSLLGetSize(list) == 0)
+  {
+    return NULL;
+  }
+  previous = list->head;
+  while (previous->next != list->tail)
+  {
+    previous = previous->next;
+  }
+  return GenUtils_ICSLLRemoveAfter(list, previous);
+}
+
+// Remove the head of the list.
+GenUtils_SingleLink *GenUtils_ICSLLPopFront(
+  GenUtils_ICSLL *list)
+{
+  return GenUtils_ICSLLRemoveAfter(
+    list, GenUtils_ICSLLEnd(list));
+}
+
+// Remove all the links of a list.
+void GenUtils_ICSLLClear(GenUtils_ICSLL *list)
+{
+  GenUtils_ICSLLInit(list);
+}
+
+// Iterate a list with a function.
+void GenUtils_ICSLLIterate(GenUtils_ICSLL *list,
+  void *extradata,
+  void (*function)(GenUtils_SingleLink *, void *))
+{
+  // The current link.
+  GenUtils_SingleLink *currentLink =
+    GenUtils_ICSLLBegin(list);
+  // The link after the current one.
+  GenUtils_SingleLink *nextLink = NULL;
+  // The number of links to visit.
+  size_t size = GenUtils_ICSLLGetSize(list);
+  // Verify the function.
+  if (function == NULL)
+  {
+    return;
+  }
+  // Calls the function, reading the next link first.
+  for (size_t i = 0; i < size; i++)
+  {
+    nextLink = currentLink->next;
+    function(currentLink, extradata);
+    currentLink = nextLink;
+  }
+}
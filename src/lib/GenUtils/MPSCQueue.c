@@ -0,0 +1,369 @@
+// File: MPSCQueue.c
+// Author: DP-Dev
+// Implementation of a lock-free MPSC queue.
+#include <GenUtils/MPSCQueue.h>
+#include <stdint.h>
+
+// The next pointer of a node is accessed as an atomic. It
+// must have the same representation as a plain pointer.
+_Static_assert(
+  sizeof(_Atomic(GenUtils_SingleNode *)) ==
+    sizeof(GenUtils_SingleNode *),
+  "Atomic pointers must have the size of pointers.");
+
+// The link to a node made by Push has its lowest bit set,
+// so the nodes pushed with PushNode are never released.
+_Static_assert(_Alignof(GenUtils_SingleNode) > 1,
+  "Nodes must leave the lowest bit of a pointer free.");
+
+// Get the next pointer of a node as an atomic.
+static inline _Atomic(GenUtils_SingleNode *) *
+  GenUtils_MPSCQueueInternalNext(GenUtils_SingleNode *node)
+{
+  return (_Atomic(GenUtils_SingleNode *) *)&node->nextNode;
+}
+
+// Get the node a link points to.
+static inline GenUtils_SingleNode *
+  GenUtils_MPSCQueueInternalNode(GenUtils_SingleNode *link)
+{
+  return (GenUtils_SingleNode *)((uintptr_t)link &
+                                 ~(uintptr_t)1);
+}
+
+// Make the node a link points to the tail.
+static inline void GenUtils_MPSCQueueInternalAdvance(
+  GenUtils_MPSCQueue *queue, GenUtils_SingleNode *link)
+{
+  queue->tail = GenUtils_MPSCQueueInternalNode(link);
+  queue->owned = ((uintptr_t)link & 1) != 0;
+}
+
+// Push a node, marking the link to it if it was made by
+// Push.
+static void GenUtils_MPSCQueueInternalPush(
+  GenUtils_MPSCQueue *queue, GenUtils_SingleNode *node,
+  bool owned)
+{
+  // The node pushed before this one.
+  GenUtils_SingleNode *previous = NULL;
+  atomic_store_explicit(
+    GenUtils_MPSCQueueInternalNext(node), NULL,
+    memory_order_relaxed);
+  // Take the place of the head, then link the old head.
+  previous = atomic_exchange_explicit(
+    &queue->head, node, memory_order_acq_rel);
+  atomic_store_explicit(
+    GenUtils_MPSCQueueInternalNext(previous),
+    (GenUtils_SingleNode *)((uintptr_t)node |
+                            (uintptr_t)owned),
+    memory_order_release);
+}
+
+// Pop the oldest node without checking the queue, telling
+// if it was made by Push.
+static GenUtils_SingleNode *GenUtils_MPSCQueueInternalPop(
+  GenUtils_MPSCQueue *queue, bool *owned)
+{
+  // The node to pop.
+  GenUtils_SingleNode *tail = queue->tail;
+  // The node after it.
+  GenUtils_SingleNode *next = atomic_load_explicit(
+    GenUtils_MPSCQueueInternalNext(tail),
+    memory_order_acquire);
+  // The last node pushed.
+  GenUtils_SingleNode *head = NULL;
+  // Skip the stub.
+  if (tail == &queue->stub)
+  {
+    if (next == NULL)
+    {
+      return NULL;
+    }
+    GenUtils_MPSCQueueInternalAdvance(queue, next);
+    tail = queue->tail;
+    next = atomic_load_explicit(
+      GenUtils_MPSCQueueInternalNext(tail),
+      memory_order_acquire);
+  }
+  if (next != NULL)
+  {
+    *owned = queue->owned;
+    GenUtils_MPSCQueueInternalAdvance(queue, next);
+    return tail;
+  }
+  // The tail is the last node, or a producer is linking a
+  // node after it.
+  head = atomic_load_explicit(
+    &queue->head, memory_order_acquire);
+  if (tail != head)
+  {
+    return NULL;
+  }
+  // Push the stub so the last node can leave the list.
+  GenUtils_MPSCQueueInternalPush(
+    queue, &queue->stub, false);
+  next = atomic_load_explicit(
+    GenUtils_MPSCQueueInternalNext(tail),
+    memory_order_acquire);
+  if (next != NULL)
+  {
+    *owned = queue->owned;
+    GenUtils_MPSCQueueInternalAdvance(queue, next);
+    return tail;
+  }
+  return NULL;
+}
+
+// Create a MPSC queue.
+GenUtils_MPSCQueue *GenUtils_MPSCQueueCreate()
+{
+  return GenUtils_MPSCQueueCreateWithAllocator(NULL);
+}
+
+// Create a MPSC queue that uses an allocator.
+GenUtils_MPSCQueue *GenUtils_MPSCQueueCreateWithAllocator(
+  const GenUtils_Allocator *allocator)
+{
+  // The queue to create.
+  GenUtils_MPSCQueue *queue = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_MPSCQueue));
+  if (queue == NULL)
+  {
+    return NULL;
+  }
+  // The queue starts with only the stub.
+  queue->stub.userdata = NULL;
+  atomic_init(
+    GenUtils_MPSCQueueInternalNext(&queue->stub), NULL);
+  atomic_init(&queue->head, &queue->stub);
+  queue->tail = &queue->stub;
+  queue->owned = false;
+  queue->allocator = allocator;
+  return queue;
+}
+
+// Destroy a MPSC queue.
+void GenUtils_MPSCQueueDestroy(GenUtils_MPSCQueue *queue)
+{
+  // The node being released.
+  GenUtils_SingleNode *node = NULL;
+  // If the node was made by Push.
+  bool owned = false;
+  if (!GenUtils_MPSCQueueWasInit(queue))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the queue and
+  // its nodes at once.
+  if (GenUtils_AllocatorReset(queue->allocator))
+  {
+    return;
+  }
+  while ((node = GenUtils_MPSCQueueInternalPop(
+            queue, &owned)) != NULL)
+  {
+    if (owned)
+    {
+      GenUtils_AllocatorFree(queue->allocator, node,
+        sizeof(GenUtils_SingleNode));
+    }
+  }
+  GenUtils_AllocatorFree(
+    queue->allocator, queue, sizeof(GenUtils_MPSCQueue));
+}
+
+// Check if a MPSC queue was initialized.
+bool GenUtils_MPSCQueueWasInit(GenUtils_MPSCQueue *queue)
+{
+  if (queue != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Query if a MPSC queue is empty.
+bool GenUtils_MPSCQueueEmpty(GenUtils_MPSCQueue *queue)
+{
+  // The node to pop.
+  GenUtils_SingleNode *tail = NULL;
+  if (!GenUtils_MPSCQueueWasInit(queue))
+  {
+    return false;
+  }
+  tail = queue->tail;
+  if (tail != &queue->stub)
+  {
+    return false;
+  }
+  return atomic_load_explicit(
+           GenUtils_MPSCQueueInternalNext(tail),
+           memory_order_acquire) == NULL;
+}
+
+// Push a node.
+void GenUtils_MPSCQueuePushNode(
+  GenUtils_MPSCQueue *queue, GenUtils_SingleNode *node)
+{
+  if (!GenUtils_MPSCQueueWasInit(queue) || node == NULL)
+  {
+    return;
+  }
+  GenUtils_MPSCQueueInternalPush(queue, node, false);
+}
+
+// Push data in a new node.
+bool GenUtils_MPSCQueuePush(
+  GenUtils_MPSCQueue *queue, void *userdata)
+{
+  // The new node.
+  GenUtils_SingleNode *node = NULL;
+  if (!GenUtils_MPSCQueueWasInit(queue))
+  {
+    return false;
+  }
+  node = GenUtils_AllocatorAlloc(
+    queue->allocator, sizeof(GenUtils_SingleNode));
+  if (node == NULL)
+  {
+    return false;
+  }
+  node->userdata = userdata;
+  GenUtils_MPSCQueueInternalPush(queue, node, true);
+  return true;
+}
+
+// Pop a node, telling if it was made by Push.
+GenUtils_SingleNode *GenUtils_MPSCQueuePopNode(
+  GenUtils_MPSCQueue *queue, bool *owned)
+{
+  // If the node was made by Push.
+  bool made = false;
+  // The popped node.
+  GenUtils_SingleNode *node = NULL;
+  if (!GenUtils_MPSCQueueWasInit(queue))
+  {
+    return NULL;
+  }
+  node = GenUtils_MPSCQueueInternalPop(queue, &made);
+  if (node != NULL && owned != NULL)
+  {
+    *owned = made;
+  }
+  return node;
+}
+
+// Pop data and release its node if it was made by Push.
+void *GenUtils_MPSCQueuePop(GenUtils_MPSCQueue *queue)
+{
+  // The popped node.
+  GenUtils_SingleNode *node = NULL;
+  // If the node was made by Push.
+  bool owned = false;
+  // The data of the node.
+  void *userdata = NULL;
+  if (!GenUtils_MPSCQueueWasInit(queue))
+  {
+    return NULL;
+  }
+  node = GenUtils_MPSCQueueInternalPop(queue, &owned);
+  if (node == NULL)
+  {
+    return NULL;
+  }
+  userdata = node->userdata;
+  if (owned)
+  {
+    GenUtils_AllocatorFree(
+      queue->allocator, node, sizeof(GenUtils_SingleNode));
+  }
+  return userdata;
+}
+
+// Pop data and release its node if it was made by Push.
+bool GenUtils_MPSCQueuePopBool(GenUtils_MPSCQueue *queue)
+{
+  // The popped node.
+  GenUtils_SingleNode *node = NULL;
+  // If the node was made by Push.
+  bool owned = false;
+  if (!GenUtils_MPSCQueueWasInit(queue))
+  {
+    return false;
+  }
+  node = GenUtils_MPSCQueueInternalPop(queue, &owned);
+  if (node == NULL)
+  {
+    return false;
+  }
+  if (owned)
+  {
+    GenUtils_AllocatorFree(
+      queue->allocator, node, sizeof(GenUtils_SingleNode));
+  }
+  return true;
+}
+
+// Pop a batch of nodes, telling which were made by Push.
+size_t GenUtils_MPSCQueueDrainNodes(
+  GenUtils_MPSCQueue *queue, GenUtils_SingleNode **nodes,
+  bool *owned, size_t maxCount)
+{
+  // The number of nodes popped.
+  size_t count = 0;
+  // If the node was made by Push.
+  bool made = false;
+  if (!GenUtils_MPSCQueueWasInit(queue) || nodes == NULL)
+  {
+    return 0;
+  }
+  while (count < maxCount)
+  {
+    nodes[count] =
+      GenUtils_MPSCQueueInternalPop(queue, &made);
+    if (nodes[count] == NULL)
+    {
+      break;
+    }
+    if (owned != NULL)
+    {
+      owned[count] = made;
+    }
+    count++;
+  }
+  return count;
+}
+
+// Pop a batch of data.
+size_t GenUtils_MPSCQueueDrain(GenUtils_MPSCQueue *queue,
+  size_t maxCount, void *extradata,
+  void (*function)(void *, void *))
+{
+  // The number of elements popped.
+  size_t count = 0;
+  // The popped node.
+  GenUtils_SingleNode *node = NULL;
+  // If the node was made by Push.
+  bool owned = false;
+  if (!GenUtils_MPSCQueueWasInit(queue) || function == NULL)
+  {
+    return 0;
+  }
+  while (maxCount == 0 || count < maxCount)
+  {
+    node = GenUtils_MPSCQueueInternalPop(queue, &owned);
+    if (node == NULL)
+    {
+      break;
+    }
+    function(node->userdata, extradata);
+    if (owned)
+    {
+      GenUtils_AllocatorFree(queue->allocator, node,
+        sizeof(GenUtils_SingleNode));
+    }
+    count++;
+  }
+  return count;
+}
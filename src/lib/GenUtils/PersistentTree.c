@@ -0,0 +1,636 @@
+// File: PersistentTree.c
+// Author: DP-Dev
+// Implementation of a persistent binary tree.
+#include <GenUtils/PersistentTree.h>
+#include <stdatomic.h>
+#include <string.h>
+
+// Node of a persistent tree. It's not modified after it's
+// linked, except its reference count.
+struct GenUtils_PersistentTreeNode
+{
+  // The key/value pair stored in the node.
+  GenUtils_BinaryTreeKeyValue keyValue;
+  // The children, the lesser keys in the first one.
+  GenUtils_PersistentTreeNode *children[2];
+  // Number of trees and nodes that point to the node.
+  _Atomic size_t references;
+  // Height of the subtree of the node, 1 for a leaf.
+  size_t height;
+};
+
+// Get the height of a subtree.
+static inline size_t GenUtils_PersistentTreeInternalHeight(
+  GenUtils_PersistentTreeNode *node)
+{
+  if (node == NULL)
+  {
+    return 0;
+  }
+  return node->height;
+}
+
+// Take a new reference to a node.
+static inline GenUtils_PersistentTreeNode *
+  GenUtils_PersistentTreeInternalRetain(
+    GenUtils_PersistentTreeNode *node)
+{
+  if (node != NULL)
+  {
+    atomic_fetch_add_explicit(
+      &node->references, 1, memory_order_relaxed);
+  }
+  return node;
+}
+
+// Drop a reference to a node, releasing the nodes that
+// aren't used anymore.
+static void GenUtils_PersistentTreeInternalRelease(
+  const GenUtils_Allocator *allocator,
+  GenUtils_PersistentTreeNode *node)
+{
+  // The next node to release.
+  GenUtils_PersistentTreeNode *next = NULL;
+  // Recurse on the first child and loop on the second one.
+  while (node != NULL &&
+         atomic_fetch_sub_explicit(&node->references, 1,
+           memory_order_acq_rel) == 1)
+  {
+    GenUtils_PersistentTreeInternalRelease(
+      allocator, node->children[0]);
+    next = node->children[1];
+    GenUtils_AllocatorFree(allocator, node,
+      sizeof(GenUtils_PersistentTreeNode));
+    node = next;
+  }
+}
+
+// Make a node that takes the references to its children.
+// On error the references are dropped.
+static GenUtils_PersistentTreeNode *
+  GenUtils_PersistentTreeInternalMake(
+    const GenUtils_Allocator *allocator,
+    GenUtils_BinaryTreeKeyValue keyValue,
+    GenUtils_PersistentTreeNode *first,
+    GenUtils_PersistentTreeNode *second)
+{
+  // The new node.
+  GenUtils_PersistentTreeNode *node =
+    GenUtils_AllocatorAlloc(
+      allocator, sizeof(GenUtils_PersistentTreeNode));
+  // Heights of the children.
+  size_t firstHeight =
+    GenUtils_PersistentTreeInternalHeight(first);
+  size_t secondHeight =
+    GenUtils_PersistentTreeInternalHeight(second);
+  if (node == NULL)
+  {
+    GenUtils_PersistentTreeInternalRelease(
+      allocator, first);
+    GenUtils_PersistentTreeInternalRelease(
+      allocator, second);
+    return NULL;
+  }
+  node->keyValue = keyValue;
+  node->children[0] = first;
+  node->children[1] = second;
+  atomic_init(&node->references, 1);
+  node->height =
+    (firstHeight > secondHeight ? firstHeight
+                                : secondHeight) +
+    1;
+  return node;
+}
+
+// Make a node with a child on a side and another child on
+// the other side.
+static inline GenUtils_PersistentTreeNode *
+  GenUtils_PersistentTreeInternalMakeSide(
+    const GenUtils_Allocator *allocator,
+    GenUtils_BinaryTreeKeyValue keyValue, int side,
+    GenUtils_PersistentTreeNode *child,
+    GenUtils_PersistentTreeNode *other)
+{
+  if (side == 0)
+  {
+    return GenUtils_PersistentTreeInternalMake(
+      allocator, keyValue, child, other);
+  }
+  return GenUtils_PersistentTreeInternalMake(
+    allocator, keyValue, other, child);
+}
+
+// Make a balanced node from the children of a node whose
+// heights can differ by two. The references to the
+// children are taken, and the nodes rotated are copied.
+static GenUtils_PersistentTreeNode *
+  GenUtils_PersistentTreeInternalBalance(
+    const GenUtils_Allocator *allocator,
+    GenUtils_BinaryTreeKeyValue keyValue,
+    GenUtils_PersistentTreeNode *first,
+    GenUtils_PersistentTreeNode *second)
+{
+  // Heights of the children.
+  size_t firstHeight =
+    GenUtils_PersistentTreeInternalHeight(first);
+  size_t secondHeight =
+    GenUtils_PersistentTreeInternalHeight(second);
+  // The side of the highest child.
+  int side = secondHeight > firstHeight;
+  // The highest child and the other one.
+  GenUtils_PersistentTreeNode *heavy =
+    side ? second : first;
+  GenUtils_PersistentTreeNode *light =
+    side ? first : second;
+  // Nodes of the rotation.
+  GenUtils_PersistentTreeNode *inner = NULL;
+  GenUtils_PersistentTreeNode *lower = NULL;
+  GenUtils_PersistentTreeNode *upper = NULL;
+  GenUtils_PersistentTreeNode *result = NULL;
+  if (firstHeight <= secondHeight + 1 &&
+      secondHeight <= firstHeight + 1)
+  {
+    return GenUtils_PersistentTreeInternalMake(
+      allocator, keyValue, first, second);
+  }
+  inner = heavy->children[!side];
+  if (GenUtils_PersistentTreeInternalHeight(
+        heavy->children[side]) >=
+      GenUtils_PersistentTreeInternalHeight(inner))
+  {
+    // Single rotation, the heavy child becomes the root.
+    lower = GenUtils_PersistentTreeInternalMakeSide(
+      allocator, keyValue, side,
+      GenUtils_PersistentTreeInternalRetain(inner), light);
+    if (lower == NULL)
+    {
+      GenUtils_PersistentTreeInternalRelease(
+        allocator, heavy);
+      return NULL;
+    }
+    result = GenUtils_PersistentTreeInternalMakeSide(
+      allocator, heavy->keyValue, side,
+      GenUtils_PersistentTreeInternalRetain(
+        heavy->children[side]),
+      lower);
+    GenUtils_PersistentTreeInternalRelease(
+      allocator, heavy);
+    return result;
+  }
+  // Double rotation, the inner grandchild becomes the root.
+  upper = GenUtils_PersistentTreeInternalMakeSide(allocator,
+    heavy->keyValue, side,
+    GenUtils_PersistentTreeInternalRetain(
+      heavy->children[side]),
+    GenUtils_PersistentTreeInternalRetain(
+      inner->children[side]));
+  if (upper == NULL)
+  {
+    GenUtils_PersistentTreeInternalRelease(
+      allocator, heavy);
+    GenUtils_PersistentTreeInternalRelease(
+      allocator, light);
+    return NULL;
+  }
+  lower = GenUtils_PersistentTreeInternalMakeSide(allocator,
+    keyValue, side,
+    GenUtils_PersistentTreeInternalRetain(
+      inner->children[!side]),
+    light);
+  if (lower == NULL)
+  {
+    GenUtils_PersistentTreeInternalRelease(
+      allocator, upper);
+    GenUtils_PersistentTreeInternalRelease(
+      allocator, heavy);
+    return NULL;
+  }
+  result = GenUtils_PersistentTreeInternalMakeSide(
+    allocator, inner->keyValue, side, upper, lower);
+  GenUtils_PersistentTreeInternalRelease(allocator, heavy);
+  return result;
+}
+
+// Make a balanced copy of a node with a new child on a
+// side, sharing the other child.
+static inline GenUtils_PersistentTreeNode *
+  GenUtils_PersistentTreeInternalReplace(
+    const GenUtils_Allocator *allocator,
+    GenUtils_PersistentTreeNode *node, int side,
+    GenUtils_PersistentTreeNode *child)
+{
+  // The shared child.
+  GenUtils_PersistentTreeNode *other =
+    GenUtils_PersistentTreeInternalRetain(
+      node->children[!side]);
+  if (side == 0)
+  {
+    return GenUtils_PersistentTreeInternalBalance(
+      allocator, node->keyValue, child, other);
+  }
+  return GenUtils_PersistentTreeInternalBalance(
+    allocator, node->keyValue, other, child);
+}
+
+// Insert a pair in a subtree, storing the new subtree.
+static bool GenUtils_PersistentTreeInternalInsert(
+  const GenUtils_Allocator *allocator,
+  GenUtils_PersistentTreeNode *node,
+  GenUtils_BinaryTreeKeyValue keyValue,
+  GenUtils_PersistentTreeNode **result)
+{
+  // The new child.
+  GenUtils_PersistentTreeNode *child = NULL;
+  // Result of string comparison.
+  int comparison = 0;
+  if (node == NULL)
+  {
+    *result = GenUtils_PersistentTreeInternalMake(
+      allocator, keyValue, NULL, NULL);
+    return *result != NULL;
+  }
+  comparison = strcmp(keyValue.key, node->keyValue.key);
+  if (comparison == 0 ||
+      !GenUtils_PersistentTreeInternalInsert(allocator,
+        node->children[comparison > 0], keyValue, &child))
+  {
+    return false;
+  }
+  *result = GenUtils_PersistentTreeInternalReplace(
+    allocator, node, comparison > 0, child);
+  return *result != NULL;
+}
+
+// Remove the least key of a subtree, storing its pair and
+// the new subtree.
+static bool GenUtils_PersistentTreeInternalRemoveFirst(
+  const GenUtils_Allocator *allocator,
+  GenUtils_PersistentTreeNode *node,
+  GenUtils_BinaryTreeKeyValue *keyValue,
+  GenUtils_PersistentTreeNode **result)
+{
+  // The new child.
+  GenUtils_PersistentTreeNode *child = NULL;
+  if (node->children[0] == NULL)
+  {
+    *keyValue = node->keyValue;
+    *result = GenUtils_PersistentTreeInternalRetain(
+      node->children[1]);
+    return true;
+  }
+  if (!GenUtils_PersistentTreeInternalRemoveFirst(
+        allocator, node->children[0], keyValue, &child))
+  {
+    return false;
+  }
+  *result = GenUtils_PersistentTreeInternalReplace(
+    allocator, node, 0, child);
+  return *result != NULL;
+}
+
+// Remove a key from a subtree, storing its value and the
+// new subtree.
+static bool GenUtils_PersistentTreeInternalRemove(
+  const GenUtils_Allocator *allocator,
+  GenUtils_PersistentTreeNode *node, const char *key,
+  void **value, GenUtils_PersistentTreeNode **result)
+{
+  // The new child.
+  GenUtils_PersistentTreeNode *child = NULL;
+  // The pair that replaces the removed one.
+  GenUtils_BinaryTreeKeyValue successor;
+  // Result of string comparison.
+  int comparison = 0;
+  if (node == NULL)
+  {
+    return false;
+  }
+  comparison = strcmp(key, node->keyValue.key);
+  if (comparison != 0)
+  {
+    if (!GenUtils_PersistentTreeInternalRemove(allocator,
+          node->children[comparison > 0], key, value,
+          &child))
+    {
+      return false;
+    }
+    *result = GenUtils_PersistentTreeInternalReplace(
+      allocator, node, comparison > 0, child);
+    return *result != NULL;
+  }
+  *value = node->keyValue.value;
+  if (node->children[0] == NULL ||
+      node->children[1] == NULL)
+  {
+    *result = GenUtils_PersistentTreeInternalRetain(
+      node->children[node->children[0] == NULL]);
+    return true;
+  }
+  // Replace the pair by the next one.
+  if (!GenUtils_PersistentTreeInternalRemoveFirst(allocator,
+        node->children[1], &successor, &child))
+  {
+    return false;
+  }
+  *result = GenUtils_PersistentTreeInternalBalance(
+    allocator, successor,
+    GenUtils_PersistentTreeInternalRetain(
+      node->children[0]),
+    child);
+  return *result != NULL;
+}
+
+// Set the value of a key in a subtree, storing the new
+// subtree.
+static bool GenUtils_PersistentTreeInternalSet(
+  const GenUtils_Allocator *allocator,
+  GenUtils_PersistentTreeNode *node,
+  GenUtils_BinaryTreeKeyValue keyValue,
+  GenUtils_PersistentTreeNode **result)
+{
+  // The new child.
+  GenUtils_PersistentTreeNode *child = NULL;
+  // Result of string comparison.
+  int comparison = 0;
+  if (node == NULL)
+  {
+    return false;
+  }
+  comparison = strcmp(keyValue.key, node->keyValue.key);
+  if (comparison == 0)
+  {
+    keyValue.key = node->keyValue.key;
+    *result = GenUtils_PersistentTreeInternalMake(allocator,
+      keyValue,
+      GenUtils_PersistentTreeInternalRetain(
+        node->children[0]),
+      GenUtils_PersistentTreeInternalRetain(
+        node->children[1]));
+    return *result != NULL;
+  }
+  if (!GenUtils_PersistentTreeInternalSet(allocator,
+        node->children[comparison > 0], keyValue, &child))
+  {
+    return false;
+  }
+  // The shape doesn't change, so the copy is balanced.
+  *result = GenUtils_PersistentTreeInternalReplace(
+    allocator, node, comparison > 0, child);
+  return *result != NULL;
+}
+
+// Search the node of a key.
+static GenUtils_PersistentTreeNode *
+  GenUtils_PersistentTreeInternalFind(
+    GenUtils_PersistentTree *tree, const char *key)
+{
+  // Current node being processed.
+  GenUtils_PersistentTreeNode *node = NULL;
+  // Result of string comparison.
+  int comparison = 0;
+  if (!GenUtils_PersistentTreeWasInit(tree) || key == NULL)
+  {
+    return NULL;
+  }
+  node = tree->root;
+  while (node != NULL)
+  {
+    comparison = strcmp(key, node->keyValue.key);
+    if (comparison == 0)
+    {
+      return node;
+    }
+    node = node->children[comparison > 0];
+  }
+  return NULL;
+}
+
+// Auxiliar function for inorder tree traversal.
+static void GenUtils_PersistentTreeInternalInorder(
+  GenUtils_PersistentTreeNode *node, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  if (node != NULL)
+  {
+    GenUtils_PersistentTreeInternalInorder(
+      node->children[0], extradata, function);
+    function(&node->keyValue, extradata);
+    GenUtils_PersistentTreeInternalInorder(
+      node->children[1], extradata, function);
+  }
+}
+
+// Create a persistent tree.
+GenUtils_PersistentTree *GenUtils_PersistentTreeCreate()
+{
+  return GenUtils_PersistentTreeCreateWithAllocator(NULL);
+}
+
+// Create a persistent tree that uses an allocator.
+GenUtils_PersistentTree *
+  GenUtils_PersistentTreeCreateWithAllocator(
+    const GenUtils_Allocator *allocator)
+{
+  // The tree to create.
+  GenUtils_PersistentTree *tree = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_PersistentTree));
+  if (tree != NULL)
+  {
+    tree->root = NULL;
+    tree->size = 0;
+    tree->allocator = allocator;
+  }
+  return tree;
+}
+
+// Destroy a persistent tree.
+void GenUtils_PersistentTreeDestroy(
+  GenUtils_PersistentTree *tree)
+{
+  if (!GenUtils_PersistentTreeWasInit(tree))
+  {
+    return;
+  }
+  // The allocator is never reset, the snapshots can still
+  // use its nodes.
+  GenUtils_PersistentTreeInternalRelease(
+    tree->allocator, tree->root);
+  GenUtils_AllocatorFree(tree->allocator, tree,
+    sizeof(GenUtils_PersistentTree));
+}
+
+// Check if a persistent tree was initialized.
+bool GenUtils_PersistentTreeWasInit(
+  GenUtils_PersistentTree *tree)
+{
+  if (tree != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the size of a persistent tree.
+size_t GenUtils_PersistentTreeGetSize(
+  GenUtils_PersistentTree *tree)
+{
+  if (GenUtils_PersistentTreeWasInit(tree))
+  {
+    return tree->size;
+  }
+  return 0;
+}
+
+// Check if a persistent tree is empty.
+bool GenUtils_PersistentTreeEmpty(
+  GenUtils_PersistentTree *tree)
+{
+  return GenUtils_PersistentTreeGetSize(tree) == 0;
+}
+
+// Check if a key exists.
+bool GenUtils_PersistentTreeExist(
+  GenUtils_PersistentTree *tree, const char *key)
+{
+  return GenUtils_PersistentTreeInternalFind(tree, key) !=
+    NULL;
+}
+
+// Get the value of a key.
+void *GenUtils_PersistentTreeGet(
+  GenUtils_PersistentTree *tree, const char *key)
+{
+  // The node of the key.
+  GenUtils_PersistentTreeNode *node =
+    GenUtils_PersistentTreeInternalFind(tree, key);
+  if (node == NULL)
+  {
+    return NULL;
+  }
+  return node->keyValue.value;
+}
+
+// Set the value of a key.
+bool GenUtils_PersistentTreeSet(
+  GenUtils_PersistentTree *tree,
+  GenUtils_BinaryTreeKeyValue keyValue)
+{
+  // The new root.
+  GenUtils_PersistentTreeNode *root = NULL;
+  if (!GenUtils_PersistentTreeWasInit(tree) ||
+      keyValue.key == NULL ||
+      !GenUtils_PersistentTreeInternalSet(
+        tree->allocator, tree->root, keyValue, &root))
+  {
+    return false;
+  }
+  GenUtils_PersistentTreeInternalRelease(
+    tree->allocator, tree->root);
+  tree->root = root;
+  return true;
+}
+
+// Insert a key/value pair.
+bool GenUtils_PersistentTreeInsert(
+  GenUtils_PersistentTree *tree,
+  GenUtils_BinaryTreeKeyValue keyValue)
+{
+  // The new root.
+  GenUtils_PersistentTreeNode *root = NULL;
+  if (!GenUtils_PersistentTreeWasInit(tree) ||
+      keyValue.key == NULL ||
+      !GenUtils_PersistentTreeInternalInsert(
+        tree->allocator, tree->root, keyValue, &root))
+  {
+    return false;
+  }
+  GenUtils_PersistentTreeInternalRelease(
+    tree->allocator, tree->root);
+  tree->root = root;
+  tree->size++;
+  return true;
+}
+
+// Remove a key and return its value.
+void *GenUtils_PersistentTreeRemove(
+  GenUtils_PersistentTree *tree, const char *key)
+{
+  // The value of the key.
+  void *value = NULL;
+  // The new root.
+  GenUtils_PersistentTreeNode *root = NULL;
+  if (!GenUtils_PersistentTreeWasInit(tree) ||
+      key == NULL ||
+      !GenUtils_PersistentTreeInternalRemove(
+        tree->allocator, tree->root, key, &value, &root))
+  {
+    return NULL;
+  }
+  GenUtils_PersistentTreeInternalRelease(
+    tree->allocator, tree->root);
+  tree->root = root;
+  tree->size--;
+  return value;
+}
+
+// Remove a key.
+bool GenUtils_PersistentTreeRemoveBool(
+  GenUtils_PersistentTree *tree, const char *key)
+{
+  // The size before the removal.
+  size_t size = GenUtils_PersistentTreeGetSize(tree);
+  GenUtils_PersistentTreeRemove(tree, key);
+  return GenUtils_PersistentTreeGetSize(tree) != size;
+}
+
+// Make a snapshot of a persistent tree.
+GenUtils_PersistentTree *GenUtils_PersistentTreeSnapshot(
+  GenUtils_PersistentTree *tree)
+{
+  // The snapshot to create.
+  GenUtils_PersistentTree *snapshot = NULL;
+  if (!GenUtils_PersistentTreeWasInit(tree))
+  {
+    return NULL;
+  }
+  snapshot = GenUtils_PersistentTreeCreateWithAllocator(
+    tree->allocator);
+  if (snapshot == NULL)
+  {
+    return NULL;
+  }
+  snapshot->root =
+    GenUtils_PersistentTreeInternalRetain(tree->root);
+  snapshot->size = tree->size;
+  return snapshot;
+}
+
+// Clear a persistent tree.
+void GenUtils_PersistentTreeClear(
+  GenUtils_PersistentTree *tree)
+{
+  if (!GenUtils_PersistentTreeWasInit(tree))
+  {
+    return;
+  }
+  GenUtils_PersistentTreeInternalRelease(
+    tree->allocator, tree->root);
+  tree->root = NULL;
+  tree->size = 0;
+}
+
+// Inorder traversal.
+void GenUtils_PersistentTreeInorder(
+  GenUtils_PersistentTree *tree, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  if (!GenUtils_PersistentTreeWasInit(tree) ||
+      function == NULL)
+  {
+    return;
+  }
+  GenUtils_PersistentTreeInternalInorder(
+    tree->root, extradata, function);
+}
@@ -0,0 +1,209 @@
+// File: Pool.c
+// Author: DP-Dev
+// Implementation of a pool of fixed size objects.
+#include <GenUtils/Pool.h>
+#include <stdint.h>
+
+// Minimum number of objects in a chunk.
+#define GENUTILS_POOL_MIN_CHUNK 16
+// Maximum number of objects of the chunks that grow
+// automatically.
+#define GENUTILS_POOL_MAX_CHUNK 65536
+
+// Header of a chunk of objects, the objects follow it.
+typedef struct GenUtils_PoolInternalChunk
+{
+  // The next chunk in the list.
+  struct GenUtils_PoolInternalChunk *next;
+  // The number of objects of the chunk.
+  size_t capacity;
+} GenUtils_PoolInternalChunk;
+
+// Allocate a new chunk and make it the current one.
+static bool GenUtils_PoolInternalAddChunk(
+  GenUtils_Pool *pool)
+{
+  // The new chunk.
+  GenUtils_PoolInternalChunk *chunk = NULL;
+  // Check the size of the chunk.
+  if (pool->chunkCapacity >
+      (SIZE_MAX - sizeof(GenUtils_PoolInternalChunk)) /
+        pool->objectSize)
+  {
+    return false;
+  }
+  chunk = GenUtils_AllocatorAlloc(pool->allocator,
+    sizeof(GenUtils_PoolInternalChunk) +
+      pool->chunkCapacity * pool->objectSize);
+  if (chunk == NULL)
+  {
+    return false;
+  }
+  chunk->next = pool->chunks;
+  chunk->capacity = pool->chunkCapacity;
+  pool->chunks = chunk;
+  pool->next = (char *)(chunk + 1);
+  pool->end =
+    pool->next + chunk->capacity * pool->objectSize;
+  // The chunks grow geometrically up to a limit.
+  if (pool->chunkCapacity < GENUTILS_POOL_MAX_CHUNK)
+  {
+    pool->chunkCapacity *= 2;
+  }
+  return true;
+}
+
+// Release the memory of a chunk.
+static void GenUtils_PoolInternalFreeChunk(
+  GenUtils_Pool *pool, GenUtils_PoolInternalChunk *chunk)
+{
+  GenUtils_AllocatorFree(pool->allocator, chunk,
+    sizeof(GenUtils_PoolInternalChunk) +
+      chunk->capacity * pool->objectSize);
+}
+
+// Create a pool.
+GenUtils_Pool *GenUtils_PoolCreate(
+  size_t objectSize, size_t capacityHint)
+{
+  return GenUtils_PoolCreateWithAllocator(
+    objectSize, capacityHint, NULL);
+}
+
+// Create a pool that uses an allocator.
+GenUtils_Pool *GenUtils_PoolCreateWithAllocator(
+  size_t objectSize, size_t capacityHint,
+  const GenUtils_Allocator *allocator)
+{
+  // The pool to create.
+  GenUtils_Pool *pool = NULL;
+  // Check the size of the objects.
+  if (objectSize == 0 || objectSize > SIZE_MAX / 2)
+  {
+    return NULL;
+  }
+  pool = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_Pool));
+  if (pool == NULL)
+  {
+    return NULL;
+  }
+  // Released objects store a pointer, so they must be big
+  // enough and aligned to hold it.
+  if (objectSize < sizeof(void *))
+  {
+    objectSize = sizeof(void *);
+  }
+  pool->objectSize = (objectSize + sizeof(void *) - 1) /
+                     sizeof(void *) * sizeof(void *);
+  pool->chunkCapacity =
+    capacityHint < GENUTILS_POOL_MIN_CHUNK
+      ? GENUTILS_POOL_MIN_CHUNK
+      : capacityHint;
+  pool->chunks = NULL;
+  pool->freeList = NULL;
+  pool->next = NULL;
+  pool->end = NULL;
+  pool->allocator = allocator;
+  // Allocate the first chunk now.
+  if (!GenUtils_PoolInternalAddChunk(pool))
+  {
+    GenUtils_AllocatorFree(
+      allocator, pool, sizeof(GenUtils_Pool));
+    return NULL;
+  }
+  return pool;
+}
+
+// Destroy a pool.
+void GenUtils_PoolDestroy(GenUtils_Pool *pool)
+{
+  // The chunk to release.
+  GenUtils_PoolInternalChunk *chunk = NULL;
+  if (!GenUtils_PoolWasInit(pool))
+  {
+    return;
+  }
+  // Release all the chunks.
+  while (pool->chunks != NULL)
+  {
+    chunk = pool->chunks;
+    pool->chunks = chunk->next;
+    GenUtils_PoolInternalFreeChunk(pool, chunk);
+  }
+  GenUtils_AllocatorFree(
+    pool->allocator, pool, sizeof(GenUtils_Pool));
+}
+
+// Check if a pool was initialized.
+bool GenUtils_PoolWasInit(GenUtils_Pool *pool)
+{
+  if (pool != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get an object from a pool.
+void *GenUtils_PoolAlloc(GenUtils_Pool *pool)
+{
+  // The object to return.
+  void *object = NULL;
+  if (!GenUtils_PoolWasInit(pool))
+  {
+    return NULL;
+  }
+  // Reuse a released object if possible.
+  if (pool->freeList != NULL)
+  {
+    object = pool->freeList;
+    pool->freeList = *(void **)object;
+    return object;
+  }
+  // Add a new chunk if the current one is full.
+  if (pool->next == pool->end &&
+      !GenUtils_PoolInternalAddChunk(pool))
+  {
+    return NULL;
+  }
+  object = pool->next;
+  pool->next += pool->objectSize;
+  return object;
+}
+
+// Return an object to a pool.
+void GenUtils_PoolFree(GenUtils_Pool *pool, void *object)
+{
+  if (!GenUtils_PoolWasInit(pool) || object == NULL)
+  {
+    return;
+  }
+  *(void **)object = pool->freeList;
+  pool->freeList = object;
+}
+
+// Release all the objects of a pool.
+void GenUtils_PoolReset(GenUtils_Pool *pool)
+{
+  // The newest chunk, it's kept.
+  GenUtils_PoolInternalChunk *newest = NULL;
+  // The chunk to release.
+  GenUtils_PoolInternalChunk *chunk = NULL;
+  if (!GenUtils_PoolWasInit(pool))
+  {
+    return;
+  }
+  // Release all the chunks but the newest.
+  newest = pool->chunks;
+  while (newest->next != NULL)
+  {
+    chunk = newest->next;
+    newest->next = chunk->next;
+    GenUtils_PoolInternalFreeChunk(pool, chunk);
+  }
+  pool->freeList = NULL;
+  pool->next = (char *)(newest + 1);
+  pool->end =
+    pool->next + newest->capacity * pool->objectSize;
+}
@@ -0,0 +1,236 @@
+// File: SPSCRing.c
+// Author: DP-Dev
+// Implementation of a lock-free SPSC ring buffer.
+#include <GenUtils/SPSCRing.h>
+#include <stdint.h>
+#include <string.h>
+
+// Create a SPSC ring.
+GenUtils_SPSCRing *GenUtils_SPSCRingCreate(size_t capacity)
+{
+  return GenUtils_SPSCRingCreateWithAllocator(
+    capacity, NULL);
+}
+
+// Create a SPSC ring that uses an allocator.
+GenUtils_SPSCRing *GenUtils_SPSCRingCreateWithAllocator(
+  size_t capacity, const GenUtils_Allocator *allocator)
+{
+  // The ring to create.
+  GenUtils_SPSCRing *ring = NULL;
+  // The capacity, a power of two.
+  size_t realCapacity = 1;
+  if (capacity == 0)
+  {
+    return NULL;
+  }
+  while (realCapacity < capacity)
+  {
+    if (realCapacity > SIZE_MAX / 2 / sizeof(void *))
+    {
+      return NULL;
+    }
+    realCapacity *= 2;
+  }
+  ring = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_SPSCRing));
+  if (ring == NULL)
+  {
+    return NULL;
+  }
+  ring->data = GenUtils_AllocatorAlloc(
+    allocator, realCapacity * sizeof(void *));
+  if (ring->data == NULL)
+  {
+    GenUtils_AllocatorFree(
+      allocator, ring, sizeof(GenUtils_SPSCRing));
+    return NULL;
+  }
+  ring->capacity = realCapacity;
+  ring->allocator = allocator;
+  atomic_init(&ring->head, 0);
+  ring->cachedTail = 0;
+  atomic_init(&ring->tail, 0);
+  ring->cachedHead = 0;
+  return ring;
+}
+
+// Destroy a SPSC ring.
+void GenUtils_SPSCRingDestroy(GenUtils_SPSCRing *ring)
+{
+  if (!GenUtils_SPSCRingWasInit(ring))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the ring and
+  // its buffer at once.
+  if (GenUtils_AllocatorReset(ring->allocator))
+  {
+    return;
+  }
+  GenUtils_AllocatorFree(ring->allocator, ring->data,
+    ring->capacity * sizeof(void *));
+  GenUtils_AllocatorFree(
+    ring->allocator, ring, sizeof(GenUtils_SPSCRing));
+}
+
+// Check if a SPSC ring was initialized.
+bool GenUtils_SPSCRingWasInit(GenUtils_SPSCRing *ring)
+{
+  if (ring != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the capacity of a ring.
+size_t GenUtils_SPSCRingGetCapacity(GenUtils_SPSCRing *ring)
+{
+  if (GenUtils_SPSCRingWasInit(ring))
+  {
+    return ring->capacity;
+  }
+  return 0;
+}
+
+// Get the size of a ring.
+size_t GenUtils_SPSCRingGetSize(GenUtils_SPSCRing *ring)
+{
+  // Number of elements popped.
+  size_t head = 0;
+  if (!GenUtils_SPSCRingWasInit(ring))
+  {
+    return 0;
+  }
+  head = atomic_load_explicit(
+    &ring->head, memory_order_acquire);
+  return atomic_load_explicit(
+           &ring->tail, memory_order_acquire) -
+    head;
+}
+
+// Query if a ring is empty.
+bool GenUtils_SPSCRingEmpty(GenUtils_SPSCRing *ring)
+{
+  if (GenUtils_SPSCRingWasInit(ring) &&
+      GenUtils_SPSCRingGetSize(ring) == 0)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Push an element.
+bool GenUtils_SPSCRingTryPush(
+  GenUtils_SPSCRing *ring, void *userdata)
+{
+  return GenUtils_SPSCRingTryPushN(ring, &userdata, 1) == 1;
+}
+
+// Push several elements.
+size_t GenUtils_SPSCRingTryPushN(GenUtils_SPSCRing *ring,
+  void *const *elements, size_t count)
+{
+  // Number of elements pushed, only changed here.
+  size_t tail = 0;
+  // Number of free slots.
+  size_t freeSlots = 0;
+  // Position of the first element in the buffer.
+  size_t start = 0;
+  // Number of elements before the end of the buffer.
+  size_t firstCount = 0;
+  if (!GenUtils_SPSCRingWasInit(ring) || elements == NULL)
+  {
+    return 0;
+  }
+  tail = atomic_load_explicit(
+    &ring->tail, memory_order_relaxed);
+  freeSlots = ring->capacity - (tail - ring->cachedHead);
+  // Read the consumer index only if it looks full.
+  if (freeSlots < count)
+  {
+    ring->cachedHead = atomic_load_explicit(
+      &ring->head, memory_order_acquire);
+    freeSlots = ring->capacity - (tail - ring->cachedHead);
+  }
+  if (count > freeSlots)
+  {
+    count = freeSlots;
+  }
+  if (count == 0)
+  {
+    return 0;
+  }
+  // Copy the elements in at most two segments.
+  start = tail & (ring->capacity - 1);
+  firstCount = ring->capacity - start;
+  if (firstCount > count)
+  {
+    firstCount = count;
+  }
+  memcpy(ring->data + start, elements,
+    firstCount * sizeof(void *));
+  memcpy(ring->data, elements + firstCount,
+    (count - firstCount) * sizeof(void *));
+  atomic_store_explicit(
+    &ring->tail, tail + count, memory_order_release);
+  return count;
+}
+
+// Pop an element.
+bool GenUtils_SPSCRingTryPop(
+  GenUtils_SPSCRing *ring, void **userdata)
+{
+  return GenUtils_SPSCRingTryPopN(ring, userdata, 1) == 1;
+}
+
+// Pop several elements.
+size_t GenUtils_SPSCRingTryPopN(
+  GenUtils_SPSCRing *ring, void **elements, size_t count)
+{
+  // Number of elements popped, only changed here.
+  size_t head = 0;
+  // Number of elements available.
+  size_t available = 0;
+  // Position of the first element in the buffer.
+  size_t start = 0;
+  // Number of elements before the end of the buffer.
+  size_t firstCount = 0;
+  if (!GenUtils_SPSCRingWasInit(ring) || elements == NULL)
+  {
+    return 0;
+  }
+  head = atomic_load_explicit(
+    &ring->head, memory_order_relaxed);
+  available = ring->cachedTail - head;
+  // Read the producer index only if it looks empty.
+  if (available < count)
+  {
+    ring->cachedTail = atomic_load_explicit(
+      &ring->tail, memory_order_acquire);
+    available = ring->cachedTail - head;
+  }
+  if (count > available)
+  {
+    count = available;
+  }
+  if (count == 0)
+  {
+    return 0;
+  }
+  // Copy the elements in at most two segments.
+  start = head & (ring->capacity - 1);
+  firstCount = ring->capacity - start;
+  if (firstCount > count)
+  {
+    firstCount = count;
+  }
+  memcpy(elements, ring->data + start,
+    firstCount * sizeof(void *));
+  memcpy(elements + firstCount, ring->data,
+    (count - firstCount) * sizeof(void *));
+  atomic_store_explicit(
+    &ring->head, head + count, memory_order_release);
+  return count;
+}
@@ -0,0 +1,488 @@
+// File: ShardedTree.c
+// Author: DP-Dev
+// Implementation of a sharded binary tree.
+// The reader-writer locks are POSIX.1-2001.
+#define _POSIX_C_SOURCE 200112L
+#include <GenUtils/ShardedTree.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+// A shard of a sharded tree.
+struct GenUtils_ShardedTreeShard
+{
+  // The lock of the shard.
+  pthread_rwlock_t lock;
+  // The binary tree of the shard.
+  GenUtils_BinaryTree *tree;
+  // Padding to keep the next shard out of the cache line.
+  char padding[GENUTILS_CACHE_LINE];
+};
+
+// Hash a key. FNV-1a, followed by a final mix so the low
+// bits that select the shard depend on every byte.
+static inline size_t GenUtils_ShardedTreeInternalHash(
+  const char *key)
+{
+  // The hash of the key.
+  uint64_t hash = 14695981039346656037ULL;
+  while (*key != '\0')
+  {
+    hash ^= (unsigned char)*key;
+    hash *= 1099511628211ULL;
+    key++;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCDULL;
+  hash ^= hash >> 33;
+  return (size_t)hash;
+}
+
+// Get the shard of a key.
+static inline GenUtils_ShardedTreeShard *
+  GenUtils_ShardedTreeInternalShard(
+    GenUtils_ShardedTree *shardedTree, const char *key)
+{
+  return &shardedTree->shards
+            [GenUtils_ShardedTreeInternalHash(key) &
+              (shardedTree->shardCount - 1)];
+}
+
+// Check if the next key of a cursor is less than the next
+// key of another one.
+static inline bool GenUtils_ShardedTreeInternalLess(
+  GenUtils_BinaryTreeCursor *cursor,
+  GenUtils_BinaryTreeCursor *other)
+{
+  return strcmp(GenUtils_BinaryTreeCursorGet(cursor)->key,
+           GenUtils_BinaryTreeCursorGet(other)->key) < 0;
+}
+
+// Move a cursor down a min-heap of cursors until it's not
+// greater than its children.
+static void GenUtils_ShardedTreeInternalSiftDown(
+  GenUtils_BinaryTreeCursor **heap, size_t size,
+  size_t index)
+{
+  // The cursor being moved.
+  GenUtils_BinaryTreeCursor *cursor = heap[index];
+  // The least child of the position.
+  size_t child = 0;
+  while ((child = 2 * index + 1) < size)
+  {
+    if (child + 1 < size &&
+        GenUtils_ShardedTreeInternalLess(
+          heap[child + 1], heap[child]))
+    {
+      child++;
+    }
+    if (!GenUtils_ShardedTreeInternalLess(
+          heap[child], cursor))
+    {
+      break;
+    }
+    heap[index] = heap[child];
+    index = child;
+  }
+  heap[index] = cursor;
+}
+
+// Create a sharded tree.
+GenUtils_ShardedTree *GenUtils_ShardedTreeCreate(
+  size_t shardCount)
+{
+  return GenUtils_ShardedTreeCreateWithAllocator(
+    shardCount, NULL);
+}
+
+// Create a sharded tree that uses an allocator.
+GenUtils_ShardedTree *
+  GenUtils_ShardedTreeCreateWithAllocator(
+    size_t shardCount, const GenUtils_Allocator *allocator)
+{
+  // The sharded tree to create.
+  GenUtils_ShardedTree *shardedTree = NULL;
+  // The number of shards, a power of two.
+  size_t realShardCount = 1;
+  // The number of shards initialized.
+  size_t initialized = 0;
+  // Allocator of the trees of the shards.
+  const GenUtils_Allocator *shared = NULL;
+  if (shardCount == 0)
+  {
+    shardCount = GENUTILS_SHARDED_TREE_DEFAULT_SHARDS;
+  }
+  while (realShardCount < shardCount)
+  {
+    if (realShardCount >
+        SIZE_MAX / 2 / sizeof(GenUtils_ShardedTreeShard))
+    {
+      return NULL;
+    }
+    realShardCount *= 2;
+  }
+  shardedTree = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_ShardedTree));
+  if (shardedTree == NULL)
+  {
+    return NULL;
+  }
+  shardedTree->shards = GenUtils_AllocatorAlloc(allocator,
+    realShardCount * sizeof(GenUtils_ShardedTreeShard));
+  if (shardedTree->shards == NULL)
+  {
+    GenUtils_AllocatorFree(allocator, shardedTree,
+      sizeof(GenUtils_ShardedTree));
+    return NULL;
+  }
+  shardedTree->shardCount = realShardCount;
+  shardedTree->allocator = allocator;
+  // Only the sharded tree resets the allocator.
+  shared = GenUtils_AllocatorShare(
+    allocator, &shardedTree->shared);
+  for (; initialized < realShardCount; initialized++)
+  {
+    // The shard to initialize.
+    GenUtils_ShardedTreeShard *shard =
+      &shardedTree->shards[initialized];
+    shard->tree =
+      GenUtils_BinaryTreeCreateWithAllocator(shared);
+    if (shard->tree == NULL)
+    {
+      break;
+    }
+    if (pthread_rwlock_init(&shard->lock, NULL) != 0)
+    {
+      GenUtils_BinaryTreeDestroy(shard->tree);
+      break;
+    }
+  }
+  if (initialized == realShardCount)
+  {
+    return shardedTree;
+  }
+  // Undo the shards initialized before the error.
+  while (initialized > 0)
+  {
+    initialized--;
+    pthread_rwlock_destroy(
+      &shardedTree->shards[initialized].lock);
+    GenUtils_BinaryTreeDestroy(
+      shardedTree->shards[initialized].tree);
+  }
+  GenUtils_AllocatorFree(allocator, shardedTree->shards,
+    realShardCount * sizeof(GenUtils_ShardedTreeShard));
+  GenUtils_AllocatorFree(
+    allocator, shardedTree, sizeof(GenUtils_ShardedTree));
+  return NULL;
+}
+
+// Destroy a sharded tree.
+void GenUtils_ShardedTreeDestroy(
+  GenUtils_ShardedTree *shardedTree)
+{
+  if (!GenUtils_ShardedTreeWasInit(shardedTree))
+  {
+    return;
+  }
+  for (size_t i = 0; i < shardedTree->shardCount; i++)
+  {
+    pthread_rwlock_destroy(&shardedTree->shards[i].lock);
+  }
+  // An allocator that can be reset releases the sharded
+  // tree and all its nodes at once.
+  if (GenUtils_AllocatorReset(shardedTree->allocator))
+  {
+    return;
+  }
+  for (size_t i = 0; i < shardedTree->shardCount; i++)
+  {
+    GenUtils_BinaryTreeDestroy(shardedTree->shards[i].tree);
+  }
+  GenUtils_AllocatorFree(shardedTree->allocator,
+    shardedTree->shards,
+    shardedTree->shardCount *
+      sizeof(GenUtils_ShardedTreeShard));
+  GenUtils_AllocatorFree(shardedTree->allocator,
+    shardedTree, sizeof(GenUtils_ShardedTree));
+}
+
+// Check if a sharded tree was initialized.
+bool GenUtils_ShardedTreeWasInit(
+  GenUtils_ShardedTree *shardedTree)
+{
+  if (shardedTree != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the size of a sharded tree.
+size_t GenUtils_ShardedTreeGetSize(
+  GenUtils_ShardedTree *shardedTree)
+{
+  // The number of elements.
+  size_t size = 0;
+  if (!GenUtils_ShardedTreeWasInit(shardedTree))
+  {
+    return 0;
+  }
+  for (size_t i = 0; i < shardedTree->shardCount; i++)
+  {
+    // The shard being counted.
+    GenUtils_ShardedTreeShard *shard =
+      &shardedTree->shards[i];
+    pthread_rwlock_rdlock(&shard->lock);
+    size += GenUtils_BinaryTreeGetSize(shard->tree);
+    pthread_rwlock_unlock(&shard->lock);
+  }
+  return size;
+}
+
+// Check if a sharded tree is empty.
+bool GenUtils_ShardedTreeEmpty(
+  GenUtils_ShardedTree *shardedTree)
+{
+  // Whether the shard being checked is empty.
+  bool empty = true;
+  if (!GenUtils_ShardedTreeWasInit(shardedTree))
+  {
+    return true;
+  }
+  for (size_t i = 0; i < shardedTree->shardCount && empty;
+       i++)
+  {
+    // The shard being checked.
+    GenUtils_ShardedTreeShard *shard =
+      &shardedTree->shards[i];
+    pthread_rwlock_rdlock(&shard->lock);
+    empty = GenUtils_BinaryTreeEmpty(shard->tree);
+    pthread_rwlock_unlock(&shard->lock);
+  }
+  return empty;
+}
+
+// Check if a key exists.
+bool GenUtils_ShardedTreeExist(
+  GenUtils_ShardedTree *shardedTree, const char *key)
+{
+  // The shard of the key.
+  GenUtils_ShardedTreeShard *shard = NULL;
+  // Whether the key exists.
+  bool exist = false;
+  if (!GenUtils_ShardedTreeWasInit(shardedTree) ||
+      key == NULL)
+  {
+    return false;
+  }
+  shard =
+    GenUtils_ShardedTreeInternalShard(shardedTree, key);
+  pthread_rwlock_rdlock(&shard->lock);
+  exist = GenUtils_BinaryTreeExist(shard->tree, key);
+  pthread_rwlock_unlock(&shard->lock);
+  return exist;
+}
+
+// Get the value of a key.
+void *GenUtils_ShardedTreeGet(
+  GenUtils_ShardedTree *shardedTree, const char *key)
+{
+  // The shard of the key.
+  GenUtils_ShardedTreeShard *shard = NULL;
+  // The value of the key.
+  void *value = NULL;
+  if (!GenUtils_ShardedTreeWasInit(shardedTree) ||
+      key == NULL)
+  {
+    return NULL;
+  }
+  shard =
+    GenUtils_ShardedTreeInternalShard(shardedTree, key);
+  pthread_rwlock_rdlock(&shard->lock);
+  value = GenUtils_BinaryTreeGet(shard->tree, key);
+  pthread_rwlock_unlock(&shard->lock);
+  return value;
+}
+
+// Set the value of a key.
+bool GenUtils_ShardedTreeSet(
+  GenUtils_ShardedTree *shardedTree,
+  GenUtils_BinaryTreeKeyValue keyValue)
+{
+  // The shard of the key.
+  GenUtils_ShardedTreeShard *shard = NULL;
+  // Whether the value was set.
+  bool set = false;
+  if (!GenUtils_ShardedTreeWasInit(shardedTree) ||
+      keyValue.key == NULL)
+  {
+    return false;
+  }
+  shard = GenUtils_ShardedTreeInternalShard(
+    shardedTree, keyValue.key);
+  pthread_rwlock_wrlock(&shard->lock);
+  set = GenUtils_BinaryTreeSet(shard->tree, keyValue);
+  pthread_rwlock_unlock(&shard->lock);
+  return set;
+}
+
+// Insert a key/value pair.
+bool GenUtils_ShardedTreeInsert(
+  GenUtils_ShardedTree *shardedTree,
+  GenUtils_BinaryTreeKeyValue keyValue)
+{
+  // The shard of the key.
+  GenUtils_ShardedTreeShard *shard = NULL;
+  // Whether the pair was inserted.
+  bool inserted = false;
+  if (!GenUtils_ShardedTreeWasInit(shardedTree) ||
+      keyValue.key == NULL)
+  {
+    return false;
+  }
+  shard = GenUtils_ShardedTreeInternalShard(
+    shardedTree, keyValue.key);
+  pthread_rwlock_wrlock(&shard->lock);
+  inserted =
+    GenUtils_BinaryTreeInsert(shard->tree, keyValue);
+  pthread_rwlock_unlock(&shard->lock);
+  return inserted;
+}
+
+// Remove a key and return its value.
+void *GenUtils_ShardedTreeRemove(
+  GenUtils_ShardedTree *shardedTree, const char *key)
+{
+  // The shard of the key.
+  GenUtils_ShardedTreeShard *shard = NULL;
+  // The value of the key.
+  void *value = NULL;
+  if (!GenUtils_ShardedTreeWasInit(shardedTree) ||
+      key == NULL)
+  {
+    return NULL;
+  }
+  shard =
+    GenUtils_ShardedTreeInternalShard(shardedTree, key);
+  pthread_rwlock_wrlock(&shard->lock);
+  value = GenUtils_BinaryTreeRemove(shard->tree, key);
+  pthread_rwlock_unlock(&shard->lock);
+  return value;
+}
+
+// Remove a key.
+bool GenUtils_ShardedTreeRemoveBool(
+  GenUtils_ShardedTree *shardedTree, const char *key)
+{
+  // The shard of the key.
+  GenUtils_ShardedTreeShard *shard = NULL;
+  // Whether the key was removed.
+  bool removed = false;
+  if (!GenUtils_ShardedTreeWasInit(shardedTree) ||
+      key == NULL)
+  {
+    return false;
+  }
+  shard =
+    GenUtils_ShardedTreeInternalShard(shardedTree, key);
+  pthread_rwlock_wrlock(&shard->lock);
+  removed = GenUtils_BinaryTreeRemoveBool(shard->tree, key);
+  pthread_rwlock_unlock(&shard->lock);
+  return removed;
+}
+
+// Clear a sharded tree.
+void GenUtils_ShardedTreeClear(
+  GenUtils_ShardedTree *shardedTree)
+{
+  if (!GenUtils_ShardedTreeWasInit(shardedTree))
+  {
+    return;
+  }
+  for (size_t i = 0; i < shardedTree->shardCount; i++)
+  {
+    // The shard being cleared.
+    GenUtils_ShardedTreeShard *shard =
+      &shardedTree->shards[i];
+    pthread_rwlock_wrlock(&shard->lock);
+    GenUtils_BinaryTreeClear(shard->tree);
+    pthread_rwlock_unlock(&shard->lock);
+  }
+}
+
+// Iterate through all the elements in order, merging the
+// shards.
+void GenUtils_ShardedTreeInorder(
+  GenUtils_ShardedTree *shardedTree, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  // A cursor per shard, at the next element of the shard.
+  GenUtils_BinaryTreeCursor *cursors = NULL;
+  // Min-heap of the cursors with elements left, keyed on
+  // their next key.
+  GenUtils_BinaryTreeCursor **heap = NULL;
+  // Number of cursors in the heap.
+  size_t heapCount = 0;
+  // Size of the cursors and the heap.
+  size_t cursorsSize = 0;
+  // Shard with the least next key.
+  GenUtils_BinaryTreeCursor *least = NULL;
+  if (!GenUtils_ShardedTreeWasInit(shardedTree) ||
+      function == NULL)
+  {
+    return;
+  }
+  cursorsSize = shardedTree->shardCount *
+    (sizeof(GenUtils_BinaryTreeCursor) +
+      sizeof(GenUtils_BinaryTreeCursor *));
+  cursors = GenUtils_AllocatorAlloc(
+    shardedTree->allocator, cursorsSize);
+  if (cursors == NULL)
+  {
+    return;
+  }
+  heap = (GenUtils_BinaryTreeCursor **)(cursors +
+    shardedTree->shardCount);
+  // Lock every shard, always in the same order.
+  for (size_t i = 0; i < shardedTree->shardCount; i++)
+  {
+    pthread_rwlock_rdlock(&shardedTree->shards[i].lock);
+    GenUtils_BinaryTreeCursorFirst(
+      &cursors[i], shardedTree->shards[i].tree);
+    if (GenUtils_BinaryTreeCursorGet(&cursors[i]) != NULL)
+    {
+      heap[heapCount++] = &cursors[i];
+    }
+  }
+  for (size_t i = heapCount / 2; i > 0; i--)
+  {
+    GenUtils_ShardedTreeInternalSiftDown(
+      heap, heapCount, i - 1);
+  }
+  // Visit the least next key of all the shards each time.
+  while (heapCount > 0)
+  {
+    least = heap[0];
+    function(
+      GenUtils_BinaryTreeCursorGet(least), extradata);
+    GenUtils_BinaryTreeCursorNext(least);
+    // A shard with no elements left leaves the heap.
+    if (GenUtils_BinaryTreeCursorGet(least) == NULL)
+    {
+      heap[0] = heap[--heapCount];
+    }
+    if (heapCount > 0)
+    {
+      GenUtils_ShardedTreeInternalSiftDown(
+        heap, heapCount, 0);
+    }
+  }
+  for (size_t i = 0; i < shardedTree->shardCount; i++)
+  {
+    pthread_rwlock_unlock(&shardedTree->shards[i].lock);
+  }
+  GenUtils_AllocatorFree(
+    shardedTree->allocator, cursors, cursorsSize);
+}
@@ -0,0 +1,834 @@
+// File: SkipList.c
+// Author: DP-Dev
+// Implementation of a concurrent skip list.
+#include <GenUtils/SkipList.h>
+#include <GenUtils/types.h>
+#include <stdint.h>
+#include <string.h>
+
+// The node has been linked in all its levels.
+#define GENUTILS_SKIP_LIST_INSERTED 1
+// The node has been marked in all its levels.
+#define GENUTILS_SKIP_LIST_REMOVED 2
+
+// A node of a skip list.
+struct GenUtils_SkipListNode
+{
+  // The key of the node.
+  const char *key;
+  // The value of the node.
+  _Atomic(void *) value;
+  // Entry used to release the node when it's removed.
+  GenUtils_EpochEntry entry;
+  // The number of levels of the node.
+  size_t height;
+  // GENUTILS_SKIP_LIST_INSERTED and
+  // GENUTILS_SKIP_LIST_REMOVED, the thread that sets the
+  // second one releases the node.
+  _Atomic unsigned char state;
+  // The next node in every level. The lowest bit marks the
+  // node as removed in that level.
+  _Atomic uintptr_t next[];
+};
+
+// Get the node of a next pointer.
+static inline GenUtils_SkipListNode *
+  GenUtils_SkipListInternalNode(uintptr_t next)
+{
+  return (GenUtils_SkipListNode *)(next & ~(uintptr_t)1);
+}
+
+// Check if a next pointer is marked.
+static inline bool GenUtils_SkipListInternalMarked(
+  uintptr_t next)
+{
+  return (next & 1) != 0;
+}
+
+// Get a random number of levels, every level has a
+// probability of 1/4.
+static size_t GenUtils_SkipListInternalRandomHeight()
+{
+  // State of the generator of every thread.
+  static _Thread_local uint32_t seed = 0;
+  // The number of levels.
+  size_t height = 1;
+  if (seed == 0)
+  {
+    seed = (uint32_t)((uintptr_t)&seed * 2654435761u) | 1;
+  }
+  // Xorshift generator.
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  for (uint32_t bits = seed; (bits & 3) == 0 &&
+       height < GENUTILS_SKIP_LIST_MAX_HEIGHT;
+       bits >>= 2)
+  {
+    height++;
+  }
+  return height;
+}
+
+// Get the size of a node.
+static inline size_t GenUtils_SkipListInternalNodeSize(
+  size_t height)
+{
+  return sizeof(GenUtils_SkipListNode) +
+    height * sizeof(_Atomic uintptr_t);
+}
+
+// Allocate a node.
+static GenUtils_SkipListNode *
+  GenUtils_SkipListInternalAllocNode(
+    const GenUtils_Allocator *allocator,
+    GenUtils_BinaryTreeKeyValue keyValue, size_t height)
+{
+  // The new node.
+  GenUtils_SkipListNode *node = GenUtils_AllocatorAlloc(
+    allocator, GenUtils_SkipListInternalNodeSize(height));
+  if (node == NULL)
+  {
+    return NULL;
+  }
+  node->key = keyValue.key;
+  atomic_init(&node->value, keyValue.value);
+  node->height = height;
+  atomic_init(&node->state, 0);
+  for (size_t i = 0; i < height; i++)
+  {
+    atomic_init(&node->next[i], 0);
+  }
+  return node;
+}
+
+// Release a node.
+static inline void GenUtils_SkipListInternalFreeNode(
+  const GenUtils_Allocator *allocator,
+  GenUtils_SkipListNode *node)
+{
+  GenUtils_AllocatorFree(allocator, node,
+    GenUtils_SkipListInternalNodeSize(node->height));
+}
+
+// Search the first node of every level whose key isn't
+// lesser than a key, unlinking the removed nodes found.
+static bool GenUtils_SkipListInternalFind(
+  GenUtils_SkipList *skipList, const char *key,
+  GenUtils_SkipListNode **preds,
+  GenUtils_SkipListNode **succs)
+{
+  // The number of levels in use.
+  size_t height = 0;
+  // The last node with a lesser key.
+  GenUtils_SkipListNode *pred = NULL;
+  // The node being compared.
+  GenUtils_SkipListNode *curr = NULL;
+  // Next pointer of the node being compared.
+  uintptr_t next = 0;
+  // Expected next pointer of pred.
+  uintptr_t expected = 0;
+  // Set when another thread changed the list.
+  bool retry = true;
+  while (retry)
+  {
+    retry = false;
+    height = atomic_load_explicit(
+      &skipList->height, memory_order_acquire);
+    pred = skipList->head;
+    for (size_t level = height; level-- > 0 && !retry;)
+    {
+      curr = GenUtils_SkipListInternalNode(
+        atomic_load_explicit(
+          &pred->next[level], memory_order_acquire));
+      while (curr != NULL)
+      {
+        next = atomic_load_explicit(
+          &curr->next[level], memory_order_acquire);
+        // Unlink the removed nodes.
+        if (GenUtils_SkipListInternalMarked(next))
+        {
+          expected = (uintptr_t)curr;
+          if (!atomic_compare_exchange_strong_explicit(
+                &pred->next[level], &expected,
+                next & ~(uintptr_t)1, memory_order_acq_rel,
+                memory_order_relaxed))
+          {
+            retry = true;
+            break;
+          }
+          curr = GenUtils_SkipListInternalNode(next);
+          continue;
+        }
+        if (strcmp(curr->key, key) >= 0)
+        {
+          break;
+        }
+        pred = curr;
+        curr = GenUtils_SkipListInternalNode(next);
+      }
+      preds[level] = pred;
+      succs[level] = curr;
+    }
+  }
+  return succs[0] != NULL &&
+    strcmp(succs[0]->key, key) == 0;
+}
+
+// Search the first node whose key isn't lesser than a key
+// without writing, the node can be removed.
+static GenUtils_SkipListNode *
+  GenUtils_SkipListInternalLowerBound(
+    GenUtils_SkipList *skipList, const char *key)
+{
+  // The last node with a lesser key.
+  GenUtils_SkipListNode *pred = skipList->head;
+  // The node being compared.
+  GenUtils_SkipListNode *curr = NULL;
+  // Next pointer of the node being compared.
+  uintptr_t next = 0;
+  for (size_t level = atomic_load_explicit(
+         &skipList->height, memory_order_acquire);
+       level-- > 0;)
+  {
+    curr = GenUtils_SkipListInternalNode(
+      atomic_load_explicit(
+        &pred->next[level], memory_order_acquire));
+    while (curr != NULL)
+    {
+      next = atomic_load_explicit(
+        &curr->next[level], memory_order_acquire);
+      // Skip the removed nodes.
+      if (!GenUtils_SkipListInternalMarked(next) &&
+          strcmp(curr->key, key) >= 0)
+      {
+        break;
+      }
+      if (!GenUtils_SkipListInternalMarked(next))
+      {
+        pred = curr;
+      }
+      curr = GenUtils_SkipListInternalNode(next);
+    }
+  }
+  return curr;
+}
+
+// Search the node of a key without writing.
+static GenUtils_SkipListNode *
+  GenUtils_SkipListInternalSearch(
+    GenUtils_SkipList *skipList, const char *key)
+{
+  // The first node whose key isn't lesser.
+  GenUtils_SkipListNode *node =
+    GenUtils_SkipListInternalLowerBound(skipList, key);
+  if (node != NULL && strcmp(node->key, key) == 0)
+  {
+    return node;
+  }
+  return NULL;
+}
+
+// Release a removed node.
+static void GenUtils_SkipListInternalReleaseNode(
+  GenUtils_EpochEntry *entry, void *extradata)
+{
+  // The skip list of the node.
+  GenUtils_SkipList *skipList = extradata;
+  GenUtils_SkipListInternalFreeNode(skipList->allocator,
+    GENUTILS_CONTAINER_OF(
+      entry, GenUtils_SkipListNode, entry));
+}
+
+// Set the state of a node when it's been linked or
+// removed. The removing thread unlinks the node, and the
+// thread that sets the second state retires it.
+static void GenUtils_SkipListInternalRetire(
+  GenUtils_SkipList *skipList, GenUtils_EpochThread *thread,
+  GenUtils_SkipListNode *node, unsigned char state)
+{
+  // Nodes before and after the key, unused.
+  GenUtils_SkipListNode
+    *preds[GENUTILS_SKIP_LIST_MAX_HEIGHT];
+  GenUtils_SkipListNode
+    *succs[GENUTILS_SKIP_LIST_MAX_HEIGHT];
+  // The state set by the other thread.
+  unsigned char previous = atomic_fetch_or_explicit(
+    &node->state, state, memory_order_acq_rel);
+  if (previous == 0 && state == GENUTILS_SKIP_LIST_INSERTED)
+  {
+    return;
+  }
+  // The levels linked by the inserting thread are visible
+  // now, unlink them all.
+  GenUtils_SkipListInternalFind(
+    skipList, node->key, preds, succs);
+  if (previous == 0)
+  {
+    return;
+  }
+  GenUtils_EpochRetire(thread, &node->entry,
+    GenUtils_SkipListInternalReleaseNode, skipList);
+}
+
+// Release all the nodes of a skip list.
+static void GenUtils_SkipListInternalRelease(
+  GenUtils_SkipList *skipList)
+{
+  // The node being released.
+  GenUtils_SkipListNode *node = NULL;
+  // Next pointer of the node.
+  uintptr_t next = atomic_load_explicit(
+    &skipList->head->next[0], memory_order_relaxed);
+  // The removed nodes are released by the epoch domain.
+  while ((node = GenUtils_SkipListInternalNode(next)) !=
+         NULL)
+  {
+    next = atomic_load_explicit(
+      &node->next[0], memory_order_relaxed);
+    if (!GenUtils_SkipListInternalMarked(next))
+    {
+      GenUtils_SkipListInternalFreeNode(
+        skipList->allocator, node);
+    }
+  }
+  GenUtils_EpochFlush(skipList->epoch);
+}
+
+// Create a skip list.
+GenUtils_SkipList *GenUtils_SkipListCreate()
+{
+  return GenUtils_SkipListCreateWithAllocator(NULL);
+}
+
+// Create a skip list that uses an allocator.
+GenUtils_SkipList *GenUtils_SkipListCreateWithAllocator(
+  const GenUtils_Allocator *allocator)
+{
+  // The head has no key.
+  GenUtils_BinaryTreeKeyValue keyValue = {NULL, NULL};
+  // The skip list to create.
+  GenUtils_SkipList *skipList = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_SkipList));
+  if (skipList == NULL)
+  {
+    return NULL;
+  }
+  // Only the skip list resets the allocator.
+  skipList->epoch = GenUtils_EpochCreateWithAllocator(
+    GenUtils_AllocatorShare(allocator, &skipList->shared));
+  if (skipList->epoch == NULL)
+  {
+    GenUtils_AllocatorFree(
+      allocator, skipList, sizeof(GenUtils_SkipList));
+    return NULL;
+  }
+  skipList->head = GenUtils_SkipListInternalAllocNode(
+    allocator, keyValue, GENUTILS_SKIP_LIST_MAX_HEIGHT);
+  if (skipList->head == NULL)
+  {
+    GenUtils_EpochDestroy(skipList->epoch);
+    GenUtils_AllocatorFree(
+      allocator, skipList, sizeof(GenUtils_SkipList));
+    return NULL;
+  }
+  atomic_init(&skipList->height, 1);
+  atomic_init(&skipList->size, 0);
+  skipList->allocator = allocator;
+  return skipList;
+}
+
+// Destroy a skip list.
+void GenUtils_SkipListDestroy(GenUtils_SkipList *skipList)
+{
+  if (!GenUtils_SkipListWasInit(skipList))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the skip list
+  // and its nodes at once.
+  if (GenUtils_AllocatorReset(skipList->allocator))
+  {
+    return;
+  }
+  GenUtils_SkipListInternalRelease(skipList);
+  GenUtils_EpochDestroy(skipList->epoch);
+  GenUtils_SkipListInternalFreeNode(
+    skipList->allocator, skipList->head);
+  GenUtils_AllocatorFree(skipList->allocator, skipList,
+    sizeof(GenUtils_SkipList));
+}
+
+// Check if a skip list was initialized.
+bool GenUtils_SkipListWasInit(GenUtils_SkipList *skipList)
+{
+  if (skipList != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the size of a skip list.
+size_t GenUtils_SkipListGetSize(GenUtils_SkipList *skipList)
+{
+  if (GenUtils_SkipListWasInit(skipList))
+  {
+    return atomic_load_explicit(
+      &skipList->size, memory_order_relaxed);
+  }
+  return 0;
+}
+
+// Query if a skip list is empty.
+bool GenUtils_SkipListEmpty(GenUtils_SkipList *skipList)
+{
+  if (GenUtils_SkipListWasInit(skipList) &&
+      GenUtils_SkipListGetSize(skipList) == 0)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Check if a key exists.
+bool GenUtils_SkipListExist(
+  GenUtils_SkipList *skipList, const char *key)
+{
+  // The record of the calling thread.
+  GenUtils_EpochThread *thread = NULL;
+  // Whether the key exists.
+  bool exist = false;
+  if (!GenUtils_SkipListWasInit(skipList) || key == NULL)
+  {
+    return false;
+  }
+  thread = GenUtils_EpochGetThread(skipList->epoch);
+  if (thread == NULL)
+  {
+    return false;
+  }
+  GenUtils_EpochEnter(thread);
+  exist =
+    GenUtils_SkipListInternalSearch(skipList, key) != NULL;
+  GenUtils_EpochExit(thread);
+  return exist;
+}
+
+// Get the value of a key.
+void *GenUtils_SkipListGet(
+  GenUtils_SkipList *skipList, const char *key)
+{
+  // The record of the calling thread.
+  GenUtils_EpochThread *thread = NULL;
+  // The node of the key.
+  GenUtils_SkipListNode *node = NULL;
+  // The value of the key.
+  void *value = NULL;
+  if (!GenUtils_SkipListWasInit(skipList) || key == NULL)
+  {
+    return NULL;
+  }
+  thread = GenUtils_EpochGetThread(skipList->epoch);
+  if (thread == NULL)
+  {
+    return NULL;
+  }
+  GenUtils_EpochEnter(thread);
+  node = GenUtils_SkipListInternalSearch(skipList, key);
+  if (node != NULL)
+  {
+    value = atomic_load_explicit(
+      &node->value, memory_order_acquire);
+  }
+  GenUtils_EpochExit(thread);
+  return value;
+}
+
+// Set the value of a key.
+bool GenUtils_SkipListSet(GenUtils_SkipList *skipList,
+  GenUtils_BinaryTreeKeyValue keyValue)
+{
+  // The record of the calling thread.
+  GenUtils_EpochThread *thread = NULL;
+  // The node of the key.
+  GenUtils_SkipListNode *node = NULL;
+  if (!GenUtils_SkipListWasInit(skipList) ||
+      keyValue.key == NULL)
+  {
+    return false;
+  }
+  thread = GenUtils_EpochGetThread(skipList->epoch);
+  if (thread == NULL)
+  {
+    return false;
+  }
+  GenUtils_EpochEnter(thread);
+  node = GenUtils_SkipListInternalSearch(
+    skipList, keyValue.key);
+  if (node != NULL)
+  {
+    atomic_store_explicit(
+      &node->value, keyValue.value, memory_order_release);
+  }
+  GenUtils_EpochExit(thread);
+  return node != NULL;
+}
+
+// Insert a key/value pair inside a critical section.
+static bool GenUtils_SkipListInternalInsert(
+  GenUtils_SkipList *skipList, GenUtils_EpochThread *thread,
+  GenUtils_BinaryTreeKeyValue keyValue)
+{
+  // Nodes before and after the key in every level.
+  GenUtils_SkipListNode
+    *preds[GENUTILS_SKIP_LIST_MAX_HEIGHT];
+  GenUtils_SkipListNode
+    *succs[GENUTILS_SKIP_LIST_MAX_HEIGHT];
+  // The number of levels of the new node.
+  size_t height = 0;
+  // The number of levels in use.
+  size_t listHeight = 0;
+  // The new node.
+  GenUtils_SkipListNode *node = NULL;
+  // Next pointer of the new node in a level.
+  uintptr_t next = 0;
+  // Expected next pointer of a node.
+  uintptr_t expected = 0;
+  // Set when the node is removed while it's linked.
+  bool removed = false;
+  height = GenUtils_SkipListInternalRandomHeight();
+  node = GenUtils_SkipListInternalAllocNode(
+    skipList->allocator, keyValue, height);
+  if (node == NULL)
+  {
+    return false;
+  }
+  // The levels of the node must be searched from now on.
+  listHeight = atomic_load_explicit(
+    &skipList->height, memory_order_relaxed);
+  while (listHeight < height &&
+         !atomic_compare_exchange_weak_explicit(
+           &skipList->height, &listHeight, height,
+           memory_order_acq_rel, memory_order_relaxed))
+  {
+  }
+  // Link the lowest level, that makes the key visible.
+  while (true)
+  {
+    if (GenUtils_SkipListInternalFind(
+          skipList, keyValue.key, preds, succs))
+    {
+      GenUtils_SkipListInternalFreeNode(
+        skipList->allocator, node);
+      return false;
+    }
+    for (size_t level = 0; level < height; level++)
+    {
+      atomic_store_explicit(&node->next[level],
+        (uintptr_t)succs[level], memory_order_relaxed);
+    }
+    expected = (uintptr_t)succs[0];
+    if (atomic_compare_exchange_strong_explicit(
+          &preds[0]->next[0], &expected, (uintptr_t)node,
+          memory_order_release, memory_order_relaxed))
+    {
+      break;
+    }
+  }
+  atomic_fetch_add_explicit(
+    &skipList->size, 1, memory_order_relaxed);
+  // Link the upper levels, unless the node is removed.
+  for (size_t level = 1; level < height && !removed;
+       level++)
+  {
+    while (true)
+    {
+      next = atomic_load_explicit(
+        &node->next[level], memory_order_acquire);
+      if (GenUtils_SkipListInternalMarked(next))
+      {
+        removed = true;
+        break;
+      }
+      // Only a removing thread can change it, marking it.
+      if (GenUtils_SkipListInternalNode(next) !=
+            succs[level] &&
+          !atomic_compare_exchange_strong_explicit(
+            &node->next[level], &next,
+            (uintptr_t)succs[level], memory_order_acq_rel,
+            memory_order_relaxed))
+      {
+        removed = true;
+        break;
+      }
+      expected = (uintptr_t)succs[level];
+      if (atomic_compare_exchange_strong_explicit(
+            &preds[level]->next[level], &expected,
+            (uintptr_t)node, memory_order_release,
+            memory_order_relaxed))
+      {
+        break;
+      }
+      GenUtils_SkipListInternalFind(
+        skipList, keyValue.key, preds, succs);
+      if (succs[0] != node)
+      {
+        removed = true;
+        break;
+      }
+    }
+  }
+  GenUtils_SkipListInternalRetire(
+    skipList, thread, node, GENUTILS_SKIP_LIST_INSERTED);
+  return true;
+}
+
+// Insert a key/value pair.
+bool GenUtils_SkipListInsert(GenUtils_SkipList *skipList,
+  GenUtils_BinaryTreeKeyValue keyValue)
+{
+  // The record of the calling thread.
+  GenUtils_EpochThread *thread = NULL;
+  // Whether the pair was inserted.
+  bool inserted = false;
+  if (!GenUtils_SkipListWasInit(skipList) ||
+      keyValue.key == NULL)
+  {
+    return false;
+  }
+  thread = GenUtils_EpochGetThread(skipList->epoch);
+  if (thread == NULL)
+  {
+    return false;
+  }
+  GenUtils_EpochEnter(thread);
+  inserted = GenUtils_SkipListInternalInsert(
+    skipList, thread, keyValue);
+  GenUtils_EpochExit(thread);
+  return inserted;
+}
+
+// Remove a key inside a critical section, storing its
+// value.
+static bool GenUtils_SkipListInternalRemove(
+  GenUtils_SkipList *skipList, GenUtils_EpochThread *thread,
+  const char *key, void **value)
+{
+  // Nodes before and after the key in every level.
+  GenUtils_SkipListNode
+    *preds[GENUTILS_SKIP_LIST_MAX_HEIGHT];
+  GenUtils_SkipListNode
+    *succs[GENUTILS_SKIP_LIST_MAX_HEIGHT];
+  // The node to remove.
+  GenUtils_SkipListNode *node = NULL;
+  // Next pointer of the node in a level.
+  uintptr_t next = 0;
+  if (!GenUtils_SkipListInternalFind(
+        skipList, key, preds, succs))
+  {
+    return false;
+  }
+  node = succs[0];
+  // Mark the upper levels, so they can't be linked.
+  for (size_t level = node->height; level-- > 1;)
+  {
+    next = atomic_load_explicit(
+      &node->next[level], memory_order_relaxed);
+    while (!GenUtils_SkipListInternalMarked(next) &&
+           !atomic_compare_exchange_weak_explicit(
+             &node->next[level], &next, next | 1,
+             memory_order_acq_rel, memory_order_relaxed))
+    {
+    }
+  }
+  // The thread that marks the lowest level removes the key.
+  next = atomic_load_explicit(
+    &node->next[0], memory_order_relaxed);
+  while (true)
+  {
+    if (GenUtils_SkipListInternalMarked(next))
+    {
+      return false;
+    }
+    if (atomic_compare_exchange_weak_explicit(
+          &node->next[0], &next, next | 1,
+          memory_order_acq_rel, memory_order_relaxed))
+    {
+      break;
+    }
+  }
+  *value = atomic_load_explicit(
+    &node->value, memory_order_acquire);
+  atomic_fetch_sub_explicit(
+    &skipList->size, 1, memory_order_relaxed);
+  GenUtils_SkipListInternalRetire(
+    skipList, thread, node, GENUTILS_SKIP_LIST_REMOVED);
+  return true;
+}
+
+// Remove a key, storing its value.
+static bool GenUtils_SkipListInternalRemoveKey(
+  GenUtils_SkipList *skipList, const char *key,
+  void **value)
+{
+  // The record of the calling thread.
+  GenUtils_EpochThread *thread = NULL;
+  // Whether the key was removed.
+  bool removed = false;
+  if (!GenUtils_SkipListWasInit(skipList) || key == NULL)
+  {
+    return false;
+  }
+  thread = GenUtils_EpochGetThread(skipList->epoch);
+  if (thread == NULL)
+  {
+    return false;
+  }
+  GenUtils_EpochEnter(thread);
+  removed = GenUtils_SkipListInternalRemove(
+    skipList, thread, key, value);
+  GenUtils_EpochExit(thread);
+  return removed;
+}
+
+// Remove a key and return its value.
+void *GenUtils_SkipListRemove(
+  GenUtils_SkipList *skipList, const char *key)
+{
+  // The value of the key.
+  void *value = NULL;
+  if (GenUtils_SkipListInternalRemoveKey(
+        skipList, key, &value))
+  {
+    return value;
+  }
+  return NULL;
+}
+
+// Remove a key.
+bool GenUtils_SkipListRemoveBool(
+  GenUtils_SkipList *skipList, const char *key)
+{
+  // The value of the key.
+  void *value = NULL;
+  return GenUtils_SkipListInternalRemoveKey(
+    skipList, key, &value);
+}
+
+// Clear a skip list.
+void GenUtils_SkipListClear(GenUtils_SkipList *skipList)
+{
+  if (!GenUtils_SkipListWasInit(skipList))
+  {
+    return;
+  }
+  GenUtils_SkipListInternalRelease(skipList);
+  for (size_t i = 0; i < GENUTILS_SKIP_LIST_MAX_HEIGHT; i++)
+  {
+    atomic_store_explicit(
+      &skipList->head->next[i], 0, memory_order_relaxed);
+  }
+  atomic_store_explicit(
+    &skipList->height, 1, memory_order_relaxed);
+  atomic_store_explicit(
+    &skipList->size, 0, memory_order_relaxed);
+}
+
+// Release the removed nodes that are safe.
+void GenUtils_SkipListCollect(GenUtils_SkipList *skipList)
+{
+  if (!GenUtils_SkipListWasInit(skipList))
+  {
+    return;
+  }
+  GenUtils_EpochCollect(
+    GenUtils_EpochGetThread(skipList->epoch));
+}
+
+// Unregister the calling thread.
+void GenUtils_SkipListUnregister(
+  GenUtils_SkipList *skipList)
+{
+  if (!GenUtils_SkipListWasInit(skipList))
+  {
+    return;
+  }
+  GenUtils_EpochUnregister(
+    GenUtils_EpochGetThread(skipList->epoch));
+}
+
+// Iterate through the elements of a range.
+static void GenUtils_SkipListInternalIterate(
+  GenUtils_SkipList *skipList, const char *from,
+  const char *to, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  // The record of the calling thread.
+  GenUtils_EpochThread *thread = NULL;
+  // The node being visited.
+  GenUtils_SkipListNode *node = NULL;
+  // Copy of the pair passed to the function.
+  GenUtils_BinaryTreeKeyValue keyValue;
+  // Next pointer of the node.
+  uintptr_t next = 0;
+  if (!GenUtils_SkipListWasInit(skipList) ||
+      function == NULL)
+  {
+    return;
+  }
+  thread = GenUtils_EpochGetThread(skipList->epoch);
+  if (thread == NULL)
+  {
+    return;
+  }
+  GenUtils_EpochEnter(thread);
+  if (from == NULL)
+  {
+    node = GenUtils_SkipListInternalNode(
+      atomic_load_explicit(
+        &skipList->head->next[0], memory_order_acquire));
+  }
+  else
+  {
+    node =
+      GenUtils_SkipListInternalLowerBound(skipList, from);
+  }
+  while (node != NULL &&
+         (to == NULL || strcmp(node->key, to) < 0))
+  {
+    next = atomic_load_explicit(
+      &node->next[0], memory_order_acquire);
+    // Skip the removed nodes.
+    if (!GenUtils_SkipListInternalMarked(next))
+    {
+      keyValue.key = node->key;
+      keyValue.value = atomic_load_explicit(
+        &node->value, memory_order_acquire);
+      function(&keyValue, extradata);
+    }
+    node = GenUtils_SkipListInternalNode(next);
+  }
+  GenUtils_EpochExit(thread);
+}
+
+// Iterate through all the elements in order.
+void GenUtils_SkipListInorder(GenUtils_SkipList *skipList,
+  void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  GenUtils_SkipListInternalIterate(
+    skipList, NULL, NULL, extradata, function);
+}
+
+// Iterate through the elements of a range in order.
+void GenUtils_SkipListRange(GenUtils_SkipList *skipList,
+  const char *from, const char *to, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  GenUtils_SkipListInternalIterate(
+    skipList, from, to, extradata, function);
+}
@@ -0,0 +1,371 @@
+// File: SnapshotMap.c
+// Author: DP-Dev
+// Implementation of a read-copy-update map.
+#include <GenUtils/SnapshotMap.h>
+#include <GenUtils/types.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Search a key in a version.
+static GenUtils_BinaryTreeKeyValue *
+  GenUtils_SnapshotMapInternalFind(
+    const GenUtils_SnapshotMapVersion *version,
+    const char *key)
+{
+  // First index of the range that can have the key.
+  size_t low = 0;
+  // Index after the range that can have the key.
+  size_t high = version->size;
+  // Result of string comparison.
+  int comparison = 0;
+  while (low < high)
+  {
+    // The element in the middle of the range.
+    size_t middle = low + (high - low) / 2;
+    comparison = strcmp(key, version->array[middle].key);
+    if (comparison == 0)
+    {
+      return &version->array[middle];
+    }
+    if (comparison < 0)
+    {
+      high = middle;
+    }
+    else
+    {
+      low = middle + 1;
+    }
+  }
+  return NULL;
+}
+
+// Release a version.
+static void GenUtils_SnapshotMapInternalReleaseVersion(
+  GenUtils_EpochEntry *entry, void *extradata)
+{
+  // The version to release.
+  GenUtils_SnapshotMapVersion *version =
+    GENUTILS_CONTAINER_OF(
+      entry, GenUtils_SnapshotMapVersion, entry);
+  // The allocator of the map.
+  const GenUtils_Allocator *allocator = extradata;
+  free(version->array);
+  GenUtils_AllocatorFree(allocator, version,
+    sizeof(GenUtils_SnapshotMapVersion));
+}
+
+// Create a snapshot map.
+GenUtils_SnapshotMap *GenUtils_SnapshotMapCreate()
+{
+  return GenUtils_SnapshotMapCreateWithAllocator(NULL);
+}
+
+// Create a snapshot map that uses an allocator.
+GenUtils_SnapshotMap *
+  GenUtils_SnapshotMapCreateWithAllocator(
+    const GenUtils_Allocator *allocator)
+{
+  // The snapshot map to create.
+  GenUtils_SnapshotMap *snapshotMap = NULL;
+  // The first version, empty.
+  GenUtils_SnapshotMapVersion *version = NULL;
+  snapshotMap = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_SnapshotMap));
+  if (snapshotMap == NULL)
+  {
+    return NULL;
+  }
+  version = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_SnapshotMapVersion));
+  if (version == NULL)
+  {
+    GenUtils_AllocatorFree(allocator, snapshotMap,
+      sizeof(GenUtils_SnapshotMap));
+    return NULL;
+  }
+  // Only the map resets the allocator.
+  snapshotMap->epoch = GenUtils_EpochCreateWithAllocator(
+    GenUtils_AllocatorShare(
+      allocator, &snapshotMap->shared));
+  if (snapshotMap->epoch == NULL)
+  {
+    GenUtils_AllocatorFree(allocator, version,
+      sizeof(GenUtils_SnapshotMapVersion));
+    GenUtils_AllocatorFree(allocator, snapshotMap,
+      sizeof(GenUtils_SnapshotMap));
+    return NULL;
+  }
+  version->array = NULL;
+  version->size = 0;
+  atomic_init(&snapshotMap->current, version);
+  snapshotMap->allocator = allocator;
+  return snapshotMap;
+}
+
+// Destroy a snapshot map.
+void GenUtils_SnapshotMapDestroy(
+  GenUtils_SnapshotMap *snapshotMap)
+{
+  // The current version.
+  GenUtils_SnapshotMapVersion *version = NULL;
+  // The allocator of the map.
+  const GenUtils_Allocator *allocator = NULL;
+  if (!GenUtils_SnapshotMapWasInit(snapshotMap))
+  {
+    return;
+  }
+  version = atomic_load_explicit(
+    &snapshotMap->current, memory_order_relaxed);
+  allocator = snapshotMap->allocator;
+  // The arrays are allocated with malloc, so they're
+  // released even with an allocator that can be reset.
+  free(version->array);
+  // The domain releases the old versions and its records
+  // without resetting the allocator.
+  GenUtils_EpochDestroy(snapshotMap->epoch);
+  // An allocator that can be reset releases the map and
+  // its versions at once.
+  if (GenUtils_AllocatorReset(allocator))
+  {
+    return;
+  }
+  GenUtils_AllocatorFree(allocator, version,
+    sizeof(GenUtils_SnapshotMapVersion));
+  GenUtils_AllocatorFree(
+    allocator, snapshotMap, sizeof(GenUtils_SnapshotMap));
+}
+
+// Check if a snapshot map was initialized.
+bool GenUtils_SnapshotMapWasInit(
+  GenUtils_SnapshotMap *snapshotMap)
+{
+  if (snapshotMap != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the size of the current version.
+size_t GenUtils_SnapshotMapGetSize(
+  GenUtils_SnapshotMap *snapshotMap)
+{
+  // The current version.
+  const GenUtils_SnapshotMapVersion *version =
+    GenUtils_SnapshotMapAcquire(snapshotMap);
+  // The number of elements.
+  size_t size = 0;
+  if (version == NULL)
+  {
+    return 0;
+  }
+  size = version->size;
+  GenUtils_SnapshotMapRelease(snapshotMap);
+  return size;
+}
+
+// Check if the current version is empty.
+bool GenUtils_SnapshotMapEmpty(
+  GenUtils_SnapshotMap *snapshotMap)
+{
+  return GenUtils_SnapshotMapGetSize(snapshotMap) == 0;
+}
+
+// Check if a key exists in the current version.
+bool GenUtils_SnapshotMapExist(
+  GenUtils_SnapshotMap *snapshotMap, const char *key)
+{
+  // The current version.
+  const GenUtils_SnapshotMapVersion *version = NULL;
+  // Whether the key exists.
+  bool exist = false;
+  if (key == NULL)
+  {
+    return false;
+  }
+  version = GenUtils_SnapshotMapAcquire(snapshotMap);
+  if (version == NULL)
+  {
+    return false;
+  }
+  exist =
+    GenUtils_SnapshotMapInternalFind(version, key) != NULL;
+  GenUtils_SnapshotMapRelease(snapshotMap);
+  return exist;
+}
+
+// Get the value of a key in the current version.
+void *GenUtils_SnapshotMapGet(
+  GenUtils_SnapshotMap *snapshotMap, const char *key)
+{
+  // The current version.
+  const GenUtils_SnapshotMapVersion *version = NULL;
+  // The value of the key.
+  void *value = NULL;
+  if (key == NULL)
+  {
+    return NULL;
+  }
+  version = GenUtils_SnapshotMapAcquire(snapshotMap);
+  if (version == NULL)
+  {
+    return NULL;
+  }
+  value = GenUtils_SnapshotMapVersionGet(version, key);
+  GenUtils_SnapshotMapRelease(snapshotMap);
+  return value;
+}
+
+// Publish a new version made from a binary tree.
+bool GenUtils_SnapshotMapPublish(
+  GenUtils_SnapshotMap *snapshotMap,
+  GenUtils_BinaryTree *binaryTree)
+{
+  // The record of the calling thread.
+  GenUtils_EpochThread *thread = NULL;
+  // The new version.
+  GenUtils_SnapshotMapVersion *version = NULL;
+  // The replaced version.
+  GenUtils_SnapshotMapVersion *previous = NULL;
+  if (!GenUtils_SnapshotMapWasInit(snapshotMap) ||
+      !GenUtils_BinaryTreeWasInit(binaryTree))
+  {
+    return false;
+  }
+  thread = GenUtils_EpochGetThread(snapshotMap->epoch);
+  if (thread == NULL)
+  {
+    return false;
+  }
+  version = GenUtils_AllocatorAlloc(snapshotMap->allocator,
+    sizeof(GenUtils_SnapshotMapVersion));
+  if (version == NULL)
+  {
+    return false;
+  }
+  version->size = GenUtils_BinaryTreeGetSize(binaryTree);
+  version->array = NULL;
+  if (version->size != 0)
+  {
+    version->array = GenUtils_BinaryTreeToArray(binaryTree);
+    if (version->array == NULL)
+    {
+      GenUtils_AllocatorFree(snapshotMap->allocator,
+        version, sizeof(GenUtils_SnapshotMapVersion));
+      return false;
+    }
+  }
+  // Every replaced version is retired once, by the writer
+  // that replaced it.
+  previous = atomic_exchange_explicit(
+    &snapshotMap->current, version, memory_order_acq_rel);
+  GenUtils_EpochEnter(thread);
+  GenUtils_EpochRetire(thread, &previous->entry,
+    GenUtils_SnapshotMapInternalReleaseVersion,
+    (void *)snapshotMap->allocator);
+  GenUtils_EpochExit(thread);
+  // Writers are rare, so release the old versions now
+  // instead of waiting for a batch.
+  GenUtils_EpochCollect(thread);
+  return true;
+}
+
+// Get the current version.
+const GenUtils_SnapshotMapVersion *
+  GenUtils_SnapshotMapAcquire(
+    GenUtils_SnapshotMap *snapshotMap)
+{
+  // The record of the calling thread.
+  GenUtils_EpochThread *thread = NULL;
+  if (!GenUtils_SnapshotMapWasInit(snapshotMap))
+  {
+    return NULL;
+  }
+  thread = GenUtils_EpochGetThread(snapshotMap->epoch);
+  if (thread == NULL)
+  {
+    return NULL;
+  }
+  GenUtils_EpochEnter(thread);
+  return atomic_load_explicit(
+    &snapshotMap->current, memory_order_acquire);
+}
+
+// Release the version got by the calling thread.
+void GenUtils_SnapshotMapRelease(
+  GenUtils_SnapshotMap *snapshotMap)
+{
+  if (!GenUtils_SnapshotMapWasInit(snapshotMap))
+  {
+    return;
+  }
+  GenUtils_EpochExit(
+    GenUtils_EpochGetThread(snapshotMap->epoch));
+}
+
+// Get the value of a key in a version.
+void *GenUtils_SnapshotMapVersionGet(
+  const GenUtils_SnapshotMapVersion *version,
+  const char *key)
+{
+  // The pair of the key.
+  GenUtils_BinaryTreeKeyValue *keyValue = NULL;
+  if (version == NULL || key == NULL)
+  {
+    return NULL;
+  }
+  keyValue = GenUtils_SnapshotMapInternalFind(version, key);
+  if (keyValue == NULL)
+  {
+    return NULL;
+  }
+  return keyValue->value;
+}
+
+// Iterate through the current version in order.
+void GenUtils_SnapshotMapInorder(
+  GenUtils_SnapshotMap *snapshotMap, void *extradata,
+  void (*function)(
+    const GenUtils_BinaryTreeKeyValue *, void *))
+{
+  // The current version.
+  const GenUtils_SnapshotMapVersion *version = NULL;
+  if (function == NULL)
+  {
+    return;
+  }
+  version = GenUtils_SnapshotMapAcquire(snapshotMap);
+  if (version == NULL)
+  {
+    return;
+  }
+  for (size_t i = 0; i < version->size; i++)
+  {
+    function(&version->array[i], extradata);
+  }
+  GenUtils_SnapshotMapRelease(snapshotMap);
+}
+
+// Release the old versions that are safe.
+void GenUtils_SnapshotMapCollect(
+  GenUtils_SnapshotMap *snapshotMap)
+{
+  if (!GenUtils_SnapshotMapWasInit(snapshotMap))
+  {
+    return;
+  }
+  GenUtils_EpochCollect(
+    GenUtils_EpochGetThread(snapshotMap->epoch));
+}
+
+// Unregister the calling thread.
+void GenUtils_SnapshotMapUnregister(
+  GenUtils_SnapshotMap *snapshotMap)
+{
+  if (!GenUtils_SnapshotMapWasInit(snapshotMap))
+  {
+    return;
+  }
+  GenUtils_EpochUnregister(
+    GenUtils_EpochGetThread(snapshotMap->epoch));
+}
@@ -1,65 +1,172 @@
 // File: Stack.c
 // Author: DP-Dev
 // Definition of the stack API.
-#include <GenUtils/CDLL.h>
 #include <GenUtils/Stack.h>
+#include <stdint.h>
+#include <string.h>
+
+// Move the elements of a stack to a new buffer.
+static bool GenUtils_StackInternalResize(
+  GenUtils_Stack *stack, size_t capacity)
+{
+  // The new buffer.
+  void **data = stack->inlineData;
+  // Use the inline buffer if the elements fit in it.
+  if (capacity <= GENUTILS_STACK_INLINE_CAPACITY)
+  {
+    capacity = GENUTILS_STACK_INLINE_CAPACITY;
+  }
+  else
+  {
+    if (capacity > SIZE_MAX / sizeof(void *))
+    {
+      return false;
+    }
+    data = GenUtils_AllocatorAlloc(
+      stack->allocator, capacity * sizeof(void *));
+    if (data == NULL)
+    {
+      return false;
+    }
+  }
+  if (data != stack->data)
+  {
+    memcpy(data, stack->data, stack->size * sizeof(void *));
+  }
+  // Release the old buffer.
+  if (stack->data != stack->inlineData)
+  {
+    GenUtils_AllocatorFree(stack->allocator, stack->data,
+      stack->capacity * sizeof(void *));
+  }
+  stack->data = data;
+  stack->capacity = capacity;
+  return true;
+}
 
 // Create a stack.
 GenUtils_Stack *GenUtils_StackCreate()
 {
-  return GenUtils_CDLLCreate();
+  return GenUtils_StackCreateWithAllocator(NULL);
+}
+
+// Create a stack that uses an allocator.
+GenUtils_Stack *GenUtils_StackCreateWithAllocator(
+  const GenUtils_Allocator *allocator)
+{
+  // The stack to create.
+  GenUtils_Stack *stack = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_Stack));
+  if (stack == NULL)
+  {
+    return NULL;
+  }
+  // Initialize the structure with the inline buffer.
+  stack->data = stack->inlineData;
+  stack->size = 0;
+  stack->capacity = GENUTILS_STACK_INLINE_CAPACITY;
+  stack->allocator = allocator;
+  return stack;
 }
 
 // Verify if a stack was init.
 bool GenUtils_StackWasInit(GenUtils_Stack *stack)
 {
-  return GenUtils_CDLLWasInit(stack);
+  if (stack != NULL)
+  {
+    return true;
+  }
+  return false;
 }
 
 // Destroy a stack.
 void GenUtils_StackDestroy(GenUtils_Stack *stack)
 {
-  GenUtils_CDLLDestroy(stack);
+  if (!GenUtils_StackWasInit(stack))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the stack and
+  // its buffer at once.
+  if (GenUtils_AllocatorReset(stack->allocator))
+  {
+    return;
+  }
+  if (stack->data != stack->inlineData)
+  {
+    GenUtils_AllocatorFree(stack->allocator, stack->data,
+      stack->capacity * sizeof(void *));
+  }
+  GenUtils_AllocatorFree(
+    stack->allocator, stack, sizeof(GenUtils_Stack));
 }
 
 // Get the size of a stack.
 size_t GenUtils_StackGetSize(GenUtils_Stack *stack)
 {
-  return GenUtils_CDLLGetSize(stack);
+  if (GenUtils_StackWasInit(stack))
+  {
+    return stack->size;
+  }
+  return 0;
 }
 
 // Query if a stack is empty.
 bool GenUtils_StackEmpty(GenUtils_Stack *stack)
 {
-  return GenUtils_CDLLEmpty(stack);
+  if (GenUtils_StackWasInit(stack) && stack->size == 0)
+  {
+    return true;
+  }
+  return false;
 }
 
 // Push an element in the stack.
 bool GenUtils_StackPush(
   GenUtils_Stack *stack, void *userdata)
 {
-  return GenUtils_CDLLPushBack(stack, userdata);
+  if (!GenUtils_StackWasInit(stack))
+  {
+    return false;
+  }
+  // Double the capacity if the buffer is full.
+  if (stack->size == stack->capacity &&
+      !GenUtils_StackInternalResize(
+        stack, stack->capacity * 2))
+  {
+    return false;
+  }
+  stack->data[stack->size++] = userdata;
+  return true;
 }
 
 // Pop and return value.
-bool GenUtils_StackPop(GenUtils_Stack *stack)
+void *GenUtils_StackPop(GenUtils_Stack *stack)
 {
-  return GenUtils_CDLLPopBack(stack);
+  if (GenUtils_StackWasInit(stack) && stack->size > 0)
+  {
+    return stack->data[--stack->size];
+  }
+  return NULL;
 }
 
 // Pop an element from a stack.
 bool GenUtils_StackPopBool(GenUtils_Stack *stack)
 {
-  return GenUtils_CDLLPopBackBool(stack);
+  if (GenUtils_StackWasInit(stack) && stack->size > 0)
+  {
+    stack->size--;
+    return true;
+  }
+  return false;
 }
 
 // Get the element in the top of a stack.
 void *GenUtils_StackTop(GenUtils_Stack *stack)
 {
-  if (GenUtils_CDLLWasInit(stack) &&
-      !GenUtils_CDLLEmpty(stack))
+  if (GenUtils_StackWasInit(stack) && stack->size > 0)
   {
-    return GenUtils_CDLLEnd(stack)->userdata;
+    return stack->data[stack->size - 1];
   }
   return NULL;
 }
@@ -67,5 +174,48 @@ void *GenUtils_StackTop(GenUtils_Stack *stack)
 // Clear a stack.
 void GenUtils_StackClear(GenUtils_Stack *stack)
 {
-  GenUtils_CDLLClear(stack);
+  if (GenUtils_StackWasInit(stack))
+  {
+    stack->size = 0;
+  }
+}
+
+// Get the capacity of a stack.
+size_t GenUtils_StackGetCapacity(GenUtils_Stack *stack)
+{
+  if (GenUtils_StackWasInit(stack))
+  {
+    return stack->capacity;
+  }
+  return 0;
+}
+
+// Grow the buffer of a stack.
+bool GenUtils_StackReserve(
+  GenUtils_Stack *stack, size_t capacity)
+{
+  if (!GenUtils_StackWasInit(stack))
+  {
+    return false;
+  }
+  if (capacity <= stack->capacity)
+  {
+    return true;
+  }
+  return GenUtils_StackInternalResize(stack, capacity);
+}
+
+// Shrink the buffer of a stack.
+bool GenUtils_StackShrink(GenUtils_Stack *stack)
+{
+  if (!GenUtils_StackWasInit(stack))
+  {
+    return false;
+  }
+  if (stack->size == stack->capacity ||
+      stack->data == stack->inlineData)
+  {
+    return true;
+  }
+  return GenUtils_StackInternalResize(stack, stack->size);
 }
@@ -0,0 +1,642 @@
+// File: UCDLL.c
+// Author: DP-Dev
+// Implementation of an unrolled CDLL.
+#include <GenUtils/UCDLL.h>
+#include <stdint.h>
+#include <string.h>
+#if defined(__AVX2__) && UINTPTR_MAX == UINT64_MAX
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Blocks left with less elements by a removal are merged
+// with a neighbour or take elements from the next block.
+#define GENUTILS_UCDLL_MIN_FILL \
+  (GENUTILS_UCDLL_BLOCK_CAPACITY / 2)
+
+// Bytes taken from a custom allocator for a block, with
+// room to align it and to store the address to release.
+#define GENUTILS_UCDLL_RAW_BLOCK_SIZE \
+  (GENUTILS_UCDLL_BLOCK_SIZE + GENUTILS_CACHE_LINE + \
+    sizeof(void *))
+
+_Static_assert(
+  sizeof(GenUtils_UCDLLBlock) == GENUTILS_UCDLL_BLOCK_SIZE,
+  "The links, count and elements must fill a block.");
+
+// Search a pointer in an array of pointers. Returns the
+// index of the first match, or count if it isn't found.
+static inline size_t GenUtils_UCDLLInternalScan(
+  void **data, size_t count, void *userdata)
+{
+  // The index of the current element.
+  size_t i = 0;
+#if defined(__AVX2__) && UINTPTR_MAX == UINT64_MAX
+  // The pointer repeated in every lane.
+  __m256i key = _mm256_set1_epi64x((long long)userdata);
+  // Compare four pointers at once.
+  for (; i + 4 <= count; i += 4)
+  {
+    // The lanes that are equal, a bit per lane.
+    int mask = _mm256_movemask_pd(_mm256_castsi256_pd(
+      _mm256_cmpeq_epi64(key,
+        _mm256_loadu_si256((const __m256i *)(data + i)))));
+    if (mask != 0)
+    {
+      return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+  }
+#elif defined(__SSE2__) && UINTPTR_MAX == UINT64_MAX
+  // The pointer repeated in every lane.
+  __m128i key = _mm_set1_epi64x((long long)userdata);
+  // Compare two pointers at once. SSE2 lacks a 64 bits
+  // compare, so every byte of the lane must be equal.
+  for (; i + 2 <= count; i += 2)
+  {
+    // The bytes that are equal, a bit per byte.
+    int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+      key, _mm_loadu_si128((const __m128i *)(data + i))));
+    if ((mask & 0xFF) == 0xFF)
+    {
+      return i;
+    }
+    if ((mask & 0xFF00) == 0xFF00)
+    {
+      return i + 1;
+    }
+  }
+#elif defined(__SSE2__) && UINTPTR_MAX == UINT32_MAX
+  // The pointer repeated in every lane.
+  __m128i key = _mm_set1_epi32((int)(uintptr_t)userdata);
+  // Compare four pointers at once.
+  for (; i + 4 <= count; i += 4)
+  {
+    // The lanes that are equal, a bit per lane.
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(
+      _mm_cmpeq_epi32(key,
+        _mm_loadu_si128((const __m128i *)(data + i)))));
+    if (mask != 0)
+    {
+      return i + (size_t)__builtin_ctz((unsigned)mask);
+    }
+  }
+#endif
+  // Compare the remaining pointers one by one.
+  for (; i < count; i++)
+  {
+    if (data[i] == userdata)
+    {
+      return i;
+    }
+  }
+  return count;
+}
+
+// Allocate a block aligned to a cache line. A custom
+// allocator only keeps the alignment of malloc, so more
+// memory is taken and its address is stored before the
+// block.
+static GenUtils_UCDLLBlock *
+  GenUtils_UCDLLInternalAllocBlock(GenUtils_UCDLL *list)
+{
+  // The memory given by the allocator.
+  char *raw = NULL;
+  // The address of the block.
+  uintptr_t aligned = 0;
+  if (list->allocator == NULL)
+  {
+    return aligned_alloc(
+      GENUTILS_CACHE_LINE, sizeof(GenUtils_UCDLLBlock));
+  }
+  raw = GenUtils_AllocatorAlloc(
+    list->allocator, GENUTILS_UCDLL_RAW_BLOCK_SIZE);
+  if (raw == NULL)
+  {
+    return NULL;
+  }
+  aligned = ((uintptr_t)raw + sizeof(void *) +
+              GENUTILS_CACHE_LINE - 1) &
+    ~(uintptr_t)(GENUTILS_CACHE_LINE - 1);
+  ((void **)aligned)[-1] = raw;
+  return (GenUtils_UCDLLBlock *)aligned;
+}
+
+// Release a block allocated with InternalAllocBlock.
+static void GenUtils_UCDLLInternalFreeBlock(
+  GenUtils_UCDLL *list, GenUtils_UCDLLBlock *block)
+{
+  if (list->allocator == NULL)
+  {
+    free(block);
+    return;
+  }
+  GenUtils_AllocatorFree(list->allocator,
+    ((void **)block)[-1], GENUTILS_UCDLL_RAW_BLOCK_SIZE);
+}
+
+// Create an empty block after another one, or as the only
+// block of the list if after is NULL.
+static GenUtils_UCDLLBlock *GenUtils_UCDLLInternalNewBlock(
+  GenUtils_UCDLL *list, GenUtils_UCDLLBlock *after)
+{
+  // The new block.
+  GenUtils_UCDLLBlock *block =
+    GenUtils_UCDLLInternalAllocBlock(list);
+  if (block == NULL)
+  {
+    return NULL;
+  }
+  block->count = 0;
+  if (after == NULL)
+  {
+    block->previous = block;
+    block->next = block;
+    list->head = block;
+    return block;
+  }
+  // Link the block in the ring.
+  block->previous = after;
+  block->next = after->next;
+  after->next->previous = block;
+  after->next = block;
+  return block;
+}
+
+// Unlink a block from the list and release it.
+static void GenUtils_UCDLLInternalDeleteBlock(
+  GenUtils_UCDLL *list, GenUtils_UCDLLBlock *block)
+{
+  if (block->next == block)
+  {
+    list->head = NULL;
+  }
+  else
+  {
+    block->previous->next = block->next;
+    block->next->previous = block->previous;
+    if (list->head == block)
+    {
+      list->head = block->next;
+    }
+  }
+  GenUtils_UCDLLInternalFreeBlock(list, block);
+}
+
+// Insert data at an index of a block, splitting the block
+// if it's full. If block is NULL the list must be empty.
+static bool GenUtils_UCDLLInternalInsertAt(
+  GenUtils_UCDLL *list, GenUtils_UCDLLBlock *block,
+  size_t index, void *userdata)
+{
+  // The block created by a split.
+  GenUtils_UCDLLBlock *newBlock = NULL;
+  // The number of elements kept in a split block.
+  size_t half = GENUTILS_UCDLL_BLOCK_CAPACITY / 2;
+  if (block == NULL)
+  {
+    block = GenUtils_UCDLLInternalNewBlock(list, NULL);
+    if (block == NULL)
+    {
+      return false;
+    }
+    index = 0;
+  }
+  else if (block->count == GENUTILS_UCDLL_BLOCK_CAPACITY)
+  {
+    // Move the upper half to a new block.
+    newBlock = GenUtils_UCDLLInternalNewBlock(list, block);
+    if (newBlock == NULL)
+    {
+      return false;
+    }
+    memcpy(newBlock->userdata, block->userdata + half,
+      (block->count - half) * sizeof(void *));
+    newBlock->count = block->count - half;
+    block->count = half;
+    if (index > half)
+    {
+      block = newBlock;
+      index -= half;
+    }
+  }
+  // Make room for the data.
+  memmove(block->userdata + index + 1,
+    block->userdata + index,
+    (block->count - index) * sizeof(void *));
+  block->userdata[index] = userdata;
+  block->count++;
+  list->size++;
+  return true;
+}
+
+// Append the first elements of a block to another one.
+static inline void GenUtils_UCDLLInternalMoveFront(
+  GenUtils_UCDLLBlock *destination,
+  GenUtils_UCDLLBlock *source, size_t count)
+{
+  memcpy(destination->userdata + destination->count,
+    source->userdata, count * sizeof(void *));
+  memmove(source->userdata, source->userdata + count,
+    (source->count - count) * sizeof(void *));
+  destination->count += count;
+  source->count -= count;
+}
+
+// Remove the data at an index of a block. A block left
+// less than half full is merged into the previous one if
+// they fit in a block, whose elements don't move. Else the
+// next block is merged into it, or gives it elements until
+// both are at least half full, so only the positions in the
+// block and in the next one are invalidated. The tail can
+// stay less than half full.
+static void GenUtils_UCDLLInternalRemoveAt(
+  GenUtils_UCDLL *list, GenUtils_UCDLLBlock *block,
+  size_t index)
+{
+  // The previous block.
+  GenUtils_UCDLLBlock *previous = block->previous;
+  // The next block.
+  GenUtils_UCDLLBlock *next = block->next;
+  memmove(block->userdata + index,
+    block->userdata + index + 1,
+    (block->count - index - 1) * sizeof(void *));
+  block->count--;
+  list->size--;
+  if (block->count == 0)
+  {
+    GenUtils_UCDLLInternalDeleteBlock(list, block);
+    return;
+  }
+  if (block->count >= GENUTILS_UCDLL_MIN_FILL)
+  {
+    return;
+  }
+  // Don't merge the head into the tail.
+  if (block != list->head &&
+      previous->count + block->count <=
+        GENUTILS_UCDLL_BLOCK_CAPACITY)
+  {
+    GenUtils_UCDLLInternalMoveFront(
+      previous, block, block->count);
+    GenUtils_UCDLLInternalDeleteBlock(list, block);
+    return;
+  }
+  // Nor the tail into the head.
+  if (next == list->head)
+  {
+    return;
+  }
+  if (block->count + next->count <=
+      GENUTILS_UCDLL_BLOCK_CAPACITY)
+  {
+    GenUtils_UCDLLInternalMoveFront(
+      block, next, next->count);
+    GenUtils_UCDLLInternalDeleteBlock(list, next);
+  }
+  else
+  {
+    GenUtils_UCDLLInternalMoveFront(block, next,
+      (next->count - block->count) / 2);
+  }
+}
+
+// Check if a position points to an element.
+static inline bool GenUtils_UCDLLInternalValid(
+  GenUtils_UCDLLPosition position)
+{
+  return position.block != NULL &&
+    position.index < position.block->count;
+}
+
+// Create an unrolled CDLL.
+GenUtils_UCDLL *GenUtils_UCDLLCreate()
+{
+  return GenUtils_UCDLLCreateWithAllocator(NULL);
+}
+
+// Create an unrolled CDLL that uses an allocator.
+GenUtils_UCDLL *GenUtils_UCDLLCreateWithAllocator(
+  const GenUtils_Allocator *allocator)
+{
+  // The list to create.
+  GenUtils_UCDLL *list = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_UCDLL));
+  if (list == NULL)
+  {
+    return NULL;
+  }
+  list->head = NULL;
+  list->size = 0;
+  list->allocator = allocator;
+  return list;
+}
+
+// Destroy an unrolled CDLL.
+void GenUtils_UCDLLDestroy(GenUtils_UCDLL *list)
+{
+  if (!GenUtils_UCDLLWasInit(list))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the list and
+  // its blocks at once.
+  if (GenUtils_AllocatorReset(list->allocator))
+  {
+    return;
+  }
+  GenUtils_UCDLLClear(list);
+  GenUtils_AllocatorFree(
+    list->allocator, list, sizeof(GenUtils_UCDLL));
+}
+
+// Get the size of a list.
+size_t GenUtils_UCDLLGetSize(GenUtils_UCDLL *list)
+{
+  if (GenUtils_UCDLLWasInit(list))
+  {
+    return list->size;
+  }
+  return 0;
+}
+
+// Query if a list is empty.
+bool GenUtils_UCDLLEmpty(GenUtils_UCDLL *list)
+{
+  if (GenUtils_UCDLLWasInit(list) && list->size == 0)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Check if a list was initialized.
+bool GenUtils_UCDLLWasInit(GenUtils_UCDLL *list)
+{
+  if (list != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the position of the first element.
+GenUtils_UCDLLPosition GenUtils_UCDLLBegin(
+  GenUtils_UCDLL *list)
+{
+  // The position to return.
+  GenUtils_UCDLLPosition position = {NULL, 0};
+  if (GenUtils_UCDLLGetSize(list) > 0)
+  {
+    position.block = list->head;
+  }
+  return position;
+}
+
+// Get the position of the last element.
+GenUtils_UCDLLPosition GenUtils_UCDLLEnd(
+  GenUtils_UCDLL *list)
+{
+  // The position to return.
+  GenUtils_UCDLLPosition position = {NULL, 0};
+  if (GenUtils_UCDLLGetSize(list) > 0)
+  {
+    position.block = list->head->previous;
+    position.index = position.block->count - 1;
+  }
+  return position;
+}
+
+// Get the position of the next element.
+GenUtils_UCDLLPosition GenUtils_UCDLLNext(
+  GenUtils_UCDLL *list, GenUtils_UCDLLPosition position)
+{
+  // The position to return.
+  GenUtils_UCDLLPosition next = {NULL, 0};
+  if (!GenUtils_UCDLLWasInit(list) ||
+      !GenUtils_UCDLLInternalValid(position))
+  {
+    return next;
+  }
+  if (position.index + 1 < position.block->count)
+  {
+    next.block = position.block;
+    next.index = position.index + 1;
+  }
+  else if (position.block->next != list->head)
+  {
+    next.block = position.block->next;
+  }
+  return next;
+}
+
+// Get the element in a position.
+void *GenUtils_UCDLLGet(GenUtils_UCDLLPosition position)
+{
+  if (!GenUtils_UCDLLInternalValid(position))
+  {
+    return NULL;
+  }
+  return position.block->userdata[position.index];
+}
+
+// Search an element by its pointer.
+GenUtils_UCDLLPosition GenUtils_UCDLLFind(
+  GenUtils_UCDLL *list, void *userdata)
+{
+  // The position to return.
+  GenUtils_UCDLLPosition position = {NULL, 0};
+  // The current block.
+  GenUtils_UCDLLBlock *block = NULL;
+  if (GenUtils_UCDLLGetSize(list) == 0)
+  {
+    return position;
+  }
+  // Scan every block once.
+  block = list->head;
+  do
+  {
+    position.index = GenUtils_UCDLLInternalScan(
+      block->userdata, block->count, userdata);
+    if (position.index < block->count)
+    {
+      position.block = block;
+      return position;
+    }
+    block = block->next;
+  } while (block != list->head);
+  position.index = 0;
+  return position;
+}
+
+// Insert data before a position.
+bool GenUtils_UCDLLInsert(GenUtils_UCDLL *list,
+  GenUtils_UCDLLPosition position, void *userdata)
+{
+  if (!GenUtils_UCDLLWasInit(list))
+  {
+    return false;
+  }
+  if (list->size == 0)
+  {
+    return GenUtils_UCDLLInternalInsertAt(
+      list, NULL, 0, userdata);
+  }
+  if (!GenUtils_UCDLLInternalValid(position))
+  {
+    return false;
+  }
+  return GenUtils_UCDLLInternalInsertAt(
+    list, position.block, position.index, userdata);
+}
+
+// Insert data after a position.
+bool GenUtils_UCDLLInsertAfter(GenUtils_UCDLL *list,
+  GenUtils_UCDLLPosition position, void *userdata)
+{
+  if (!GenUtils_UCDLLWasInit(list))
+  {
+    return false;
+  }
+  if (list->size == 0)
+  {
+    return GenUtils_UCDLLInternalInsertAt(
+      list, NULL, 0, userdata);
+  }
+  if (!GenUtils_UCDLLInternalValid(position))
+  {
+    return false;
+  }
+  return GenUtils_UCDLLInternalInsertAt(
+    list, position.block, position.index + 1, userdata);
+}
+
+// Remove the element in a position.
+bool GenUtils_UCDLLRemove(
+  GenUtils_UCDLL *list, GenUtils_UCDLLPosition position)
+{
+  if (!GenUtils_UCDLLWasInit(list) ||
+      !GenUtils_UCDLLInternalValid(position))
+  {
+    return false;
+  }
+  GenUtils_UCDLLInternalRemoveAt(
+    list, position.block, position.index);
+  return true;
+}
+
+// Add data at the tail of the list.
+bool GenUtils_UCDLLPushBack(
+  GenUtils_UCDLL *list, void *userdata)
+{
+  // The tail block.
+  GenUtils_UCDLLBlock *tail = NULL;
+  if (!GenUtils_UCDLLWasInit(list))
+  {
+    return false;
+  }
+  if (list->size == 0)
+  {
+    return GenUtils_UCDLLInternalInsertAt(
+      list, NULL, 0, userdata);
+  }
+  tail = list->head->previous;
+  return GenUtils_UCDLLInternalInsertAt(
+    list, tail, tail->count, userdata);
+}
+
+// Add data at the head of the list.
+bool GenUtils_UCDLLPushFront(
+  GenUtils_UCDLL *list, void *userdata)
+{
+  if (!GenUtils_UCDLLWasInit(list))
+  {
+    return false;
+  }
+  return GenUtils_UCDLLInternalInsertAt(
+    list, list->head, 0, userdata);
+}
+
+// Remove and return data from the tail of the list.
+void *GenUtils_UCDLLPopBack(GenUtils_UCDLL *list)
+{
+  // The position of the tail.
+  GenUtils_UCDLLPosition position =
+    GenUtils_UCDLLEnd(list);
+  // The data of the tail.
+  void *data = GenUtils_UCDLLGet(position);
+  GenUtils_UCDLLRemove(list, position);
+  return data;
+}
+
+// Remove data from the tail of the list.
+bool GenUtils_UCDLLPopBackBool(GenUtils_UCDLL *list)
+{
+  return GenUtils_UCDLLRemove(
+    list, GenUtils_UCDLLEnd(list));
+}
+
+// Remove and return data from the head of the list.
+void *GenUtils_UCDLLPopFront(GenUtils_UCDLL *list)
+{
+  // The position of the head.
+  GenUtils_UCDLLPosition position =
+    GenUtils_UCDLLBegin(list);
+  // The data of the head.
+  void *data = GenUtils_UCDLLGet(position);
+  GenUtils_UCDLLRemove(list, position);
+  return data;
+}
+
+// Remove data from the head of the list.
+bool GenUtils_UCDLLPopFrontBool(GenUtils_UCDLL *list)
+{
+  return GenUtils_UCDLLRemove(
+    list, GenUtils_UCDLLBegin(list));
+}
+
+// Remove all the elements of a list.
+void GenUtils_UCDLLClear(GenUtils_UCDLL *list)
+{
+  // The current block.
+  GenUtils_UCDLLBlock *block = NULL;
+  // The block after the current one.
+  GenUtils_UCDLLBlock *next = NULL;
+  if (GenUtils_UCDLLGetSize(list) == 0)
+  {
+    return;
+  }
+  // Release every block once.
+  block = list->head;
+  do
+  {
+    next = block->next;
+    GenUtils_UCDLLInternalFreeBlock(list, block);
+    block = next;
+  } while (block != list->head);
+  list->head = NULL;
+  list->size = 0;
+}
+
+// Iterate a list with a function.
+void GenUtils_UCDLLIterate(GenUtils_UCDLL *list,
+  void *extradata, void (*function)(void *, void *))
+{
+  // The current block.
+  GenUtils_UCDLLBlock *block = NULL;
+  // Verify the function.
+  if (function == NULL || GenUtils_UCDLLGetSize(list) == 0)
+  {
+    return;
+  }
+  // Calls the function, a block at a time.
+  block = list->head;
+  do
+  {
+    for (size_t i = 0; i < block->count; i++)
+    {
+      function(block->userdata[i], extradata);
+    }
+    block = block->next;
+  } while (block != list->head);
+}
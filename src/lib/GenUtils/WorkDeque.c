@@ -0,0 +1,349 @@
+// File: WorkDeque.c
+// Author: DP-Dev
+// Implementation of a work-stealing deque.
+#include <GenUtils/WorkDeque.h>
+#include <stdint.h>
+
+// Allocate a buffer.
+static GenUtils_WorkDequeBuffer *
+  GenUtils_WorkDequeInternalAllocBuffer(
+    const GenUtils_Allocator *allocator, size_t capacity)
+{
+  // The new buffer.
+  GenUtils_WorkDequeBuffer *buffer = NULL;
+  if (capacity >
+      (SIZE_MAX - sizeof(GenUtils_WorkDequeBuffer)) /
+        sizeof(_Atomic(void *)))
+  {
+    return NULL;
+  }
+  buffer = GenUtils_AllocatorAlloc(allocator,
+    sizeof(GenUtils_WorkDequeBuffer) +
+      capacity * sizeof(_Atomic(void *)));
+  if (buffer == NULL)
+  {
+    return NULL;
+  }
+  buffer->capacity = capacity;
+  buffer->previous = NULL;
+  return buffer;
+}
+
+// Move the elements to a buffer twice as large.
+static GenUtils_WorkDequeBuffer *
+  GenUtils_WorkDequeInternalGrow(GenUtils_WorkDeque *deque,
+    GenUtils_WorkDequeBuffer *buffer, ptrdiff_t top,
+    ptrdiff_t bottom)
+{
+  // The new buffer.
+  GenUtils_WorkDequeBuffer *grown = NULL;
+  // Mask of the old indices.
+  size_t mask = buffer->capacity - 1;
+  if (buffer->capacity > SIZE_MAX / 2)
+  {
+    return NULL;
+  }
+  grown = GenUtils_WorkDequeInternalAllocBuffer(
+    deque->allocator, buffer->capacity * 2);
+  if (grown == NULL)
+  {
+    return NULL;
+  }
+  // The indices don't change, only their position in the
+  // buffer.
+  for (ptrdiff_t i = top; i < bottom; i++)
+  {
+    atomic_store_explicit(
+      &grown->data[(size_t)i & (grown->capacity - 1)],
+      atomic_load_explicit(&buffer->data[(size_t)i & mask],
+        memory_order_relaxed),
+      memory_order_relaxed);
+  }
+  // A thief can still read the old buffer, so it's kept
+  // until the deque is destroyed.
+  grown->previous = buffer;
+  atomic_store_explicit(
+    &deque->buffer, grown, memory_order_release);
+  return grown;
+}
+
+// Create a work-stealing deque.
+GenUtils_WorkDeque *GenUtils_WorkDequeCreate()
+{
+  return GenUtils_WorkDequeCreateWithAllocator(NULL);
+}
+
+// Create a work-stealing deque that uses an allocator.
+GenUtils_WorkDeque *GenUtils_WorkDequeCreateWithAllocator(
+  const GenUtils_Allocator *allocator)
+{
+  // The deque to create.
+  GenUtils_WorkDeque *deque = GenUtils_AllocatorAlloc(
+    allocator, sizeof(GenUtils_WorkDeque));
+  // The first buffer.
+  GenUtils_WorkDequeBuffer *buffer = NULL;
+  if (deque == NULL)
+  {
+    return NULL;
+  }
+  buffer = GenUtils_WorkDequeInternalAllocBuffer(
+    allocator, GENUTILS_WORK_DEQUE_INITIAL_CAPACITY);
+  if (buffer == NULL)
+  {
+    GenUtils_AllocatorFree(
+      allocator, deque, sizeof(GenUtils_WorkDeque));
+    return NULL;
+  }
+  atomic_init(&deque->top, 0);
+  atomic_init(&deque->bottom, 0);
+  atomic_init(&deque->buffer, buffer);
+  deque->allocator = allocator;
+  return deque;
+}
+
+// Destroy a work-stealing deque.
+void GenUtils_WorkDequeDestroy(GenUtils_WorkDeque *deque)
+{
+  // The buffer being released.
+  GenUtils_WorkDequeBuffer *buffer = NULL;
+  // The buffer before it.
+  GenUtils_WorkDequeBuffer *previous = NULL;
+  if (!GenUtils_WorkDequeWasInit(deque))
+  {
+    return;
+  }
+  // An allocator that can be reset releases the deque and
+  // its buffers at once.
+  if (GenUtils_AllocatorReset(deque->allocator))
+  {
+    return;
+  }
+  buffer = atomic_load_explicit(
+    &deque->buffer, memory_order_relaxed);
+  while (buffer != NULL)
+  {
+    previous = buffer->previous;
+    GenUtils_AllocatorFree(deque->allocator, buffer,
+      sizeof(GenUtils_WorkDequeBuffer) +
+        buffer->capacity * sizeof(_Atomic(void *)));
+    buffer = previous;
+  }
+  GenUtils_AllocatorFree(
+    deque->allocator, deque, sizeof(GenUtils_WorkDeque));
+}
+
+// Check if a work-stealing deque was initialized.
+bool GenUtils_WorkDequeWasInit(GenUtils_WorkDeque *deque)
+{
+  if (deque != NULL)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Get the size of a work-stealing deque.
+size_t GenUtils_WorkDequeGetSize(
+  GenUtils_WorkDeque *deque)
+{
+  // Index after the newest element.
+  ptrdiff_t bottom = 0;
+  // Index of the oldest element.
+  ptrdiff_t top = 0;
+  if (!GenUtils_WorkDequeWasInit(deque))
+  {
+    return 0;
+  }
+  bottom = atomic_load_explicit(
+    &deque->bottom, memory_order_relaxed);
+  top = atomic_load_explicit(
+    &deque->top, memory_order_acquire);
+  // A pop in progress moves bottom before top.
+  if (bottom <= top)
+  {
+    return 0;
+  }
+  return (size_t)(bottom - top);
+}
+
+// Query if a work-stealing deque is empty.
+bool GenUtils_WorkDequeEmpty(GenUtils_WorkDeque *deque)
+{
+  if (GenUtils_WorkDequeWasInit(deque) &&
+      GenUtils_WorkDequeGetSize(deque) == 0)
+  {
+    return true;
+  }
+  return false;
+}
+
+// Push an element in the top of a work-stealing deque.
+bool GenUtils_WorkDequePush(
+  GenUtils_WorkDeque *deque, void *userdata)
+{
+  // Index of the new element.
+  ptrdiff_t bottom = 0;
+  // Index of the oldest element.
+  ptrdiff_t top = 0;
+  // The current buffer.
+  GenUtils_WorkDequeBuffer *buffer = NULL;
+  if (!GenUtils_WorkDequeWasInit(deque))
+  {
+    return false;
+  }
+  bottom = atomic_load_explicit(
+    &deque->bottom, memory_order_relaxed);
+  top = atomic_load_explicit(
+    &deque->top, memory_order_acquire);
+  buffer = atomic_load_explicit(
+    &deque->buffer, memory_order_relaxed);
+  // Double the capacity if the buffer is full.
+  if ((size_t)(bottom - top) >= buffer->capacity)
+  {
+    buffer = GenUtils_WorkDequeInternalGrow(
+      deque, buffer, top, bottom);
+    if (buffer == NULL)
+    {
+      return false;
+    }
+  }
+  atomic_store_explicit(
+    &buffer->data[(size_t)bottom & (buffer->capacity - 1)],
+    userdata, memory_order_relaxed);
+  // Publish the element before the new bottom.
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit(
+    &deque->bottom, bottom + 1, memory_order_relaxed);
+  return true;
+}
+
+// Pop the newest element, racing with the thieves if it's
+// the last one.
+static bool GenUtils_WorkDequeInternalPop(
+  GenUtils_WorkDeque *deque, void **userdata)
+{
+  // Index of the element to pop.
+  ptrdiff_t bottom = atomic_load_explicit(
+    &deque->bottom, memory_order_relaxed);
+  // The current buffer.
+  GenUtils_WorkDequeBuffer *buffer = atomic_load_explicit(
+    &deque->buffer, memory_order_relaxed);
+  // Index of the oldest element.
+  ptrdiff_t top = 0;
+  // Whether an element was popped.
+  bool popped = true;
+  // Reserve the element, then look at the thieves.
+  bottom--;
+  atomic_store_explicit(
+    &deque->bottom, bottom, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  top = atomic_load_explicit(
+    &deque->top, memory_order_relaxed);
+  if (top > bottom)
+  {
+    // The deque was empty.
+    atomic_store_explicit(
+      &deque->bottom, bottom + 1, memory_order_relaxed);
+    return false;
+  }
+  *userdata = atomic_load_explicit(
+    &buffer->data[(size_t)bottom & (buffer->capacity - 1)],
+    memory_order_relaxed);
+  if (top == bottom)
+  {
+    // The last element, a thief can take it first.
+    popped = atomic_compare_exchange_strong_explicit(
+      &deque->top, &top, top + 1, memory_order_seq_cst,
+      memory_order_relaxed);
+    atomic_store_explicit(
+      &deque->bottom, bottom + 1, memory_order_relaxed);
+  }
+  return popped;
+}
+
+// Pop and return value.
+void *GenUtils_WorkDequePop(GenUtils_WorkDeque *deque)
+{
+  // The popped element.
+  void *userdata = NULL;
+  if (GenUtils_WorkDequeWasInit(deque) &&
+      GenUtils_WorkDequeInternalPop(deque, &userdata))
+  {
+    return userdata;
+  }
+  return NULL;
+}
+
+// Pop an element from a work-stealing deque.
+bool GenUtils_WorkDequePopBool(GenUtils_WorkDeque *deque)
+{
+  // The popped element.
+  void *userdata = NULL;
+  if (GenUtils_WorkDequeWasInit(deque))
+  {
+    return GenUtils_WorkDequeInternalPop(deque, &userdata);
+  }
+  return false;
+}
+
+// Get the element in the top of a work-stealing deque.
+void *GenUtils_WorkDequeTop(GenUtils_WorkDeque *deque)
+{
+  // Index after the newest element.
+  ptrdiff_t bottom = 0;
+  // The current buffer.
+  GenUtils_WorkDequeBuffer *buffer = NULL;
+  if (GenUtils_WorkDequeEmpty(deque))
+  {
+    return NULL;
+  }
+  bottom = atomic_load_explicit(
+    &deque->bottom, memory_order_relaxed);
+  buffer = atomic_load_explicit(
+    &deque->buffer, memory_order_relaxed);
+  return atomic_load_explicit(
+    &buffer->data[(size_t)(bottom - 1) &
+      (buffer->capacity - 1)],
+    memory_order_relaxed);
+}
+
+// Take the oldest element of a work-stealing deque.
+bool GenUtils_WorkDequeSteal(
+  GenUtils_WorkDeque *deque, void **userdata)
+{
+  // Index of the element to take.
+  ptrdiff_t top = 0;
+  // Index after the newest element.
+  ptrdiff_t bottom = 0;
+  // The current buffer.
+  GenUtils_WorkDequeBuffer *buffer = NULL;
+  // The element to take.
+  void *element = NULL;
+  if (!GenUtils_WorkDequeWasInit(deque) || userdata == NULL)
+  {
+    return false;
+  }
+  top = atomic_load_explicit(
+    &deque->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  bottom = atomic_load_explicit(
+    &deque->bottom, memory_order_acquire);
+  if (top >= bottom)
+  {
+    return false;
+  }
+  buffer = atomic_load_explicit(
+    &deque->buffer, memory_order_acquire);
+  element = atomic_load_explicit(
+    &buffer->data[(size_t)top & (buffer->capacity - 1)],
+    memory_order_relaxed);
+  // The element is ours only if top didn't move.
+  if (!atomic_compare_exchange_strong_explicit(&deque->top,
+        &top, top + 1, memory_order_seq_cst,
+        memory_order_relaxed))
+  {
+    return false;
+  }
+  *userdata = element;
+  return true;
+}
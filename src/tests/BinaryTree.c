@@ -0,0 +1,481 @@
+/// @file BinaryTree.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a binary tree.
+#include "TestUtils.h"
+#include <GenUtils/BinaryTree.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Number of keys used in the test.
+#define TEST_SIZE 4096
+
+/// @brief Check the order of a subtree and get its height.
+/// @param root The root of the subtree.
+/// @param height Where the height will be stored.
+/// @return true if the keys of the subtree are sorted.
+static bool CheckSubtree(
+  GenUtils_DoubleNode *root, size_t *height)
+{
+  size_t leftHeight = 0;
+  size_t rightHeight = 0;
+  GenUtils_BinaryTreeKeyValue *keyValue = NULL;
+  GenUtils_BinaryTreeKeyValue *childKeyValue = NULL;
+  *height = 0;
+  if (root == NULL)
+  {
+    return true;
+  }
+  keyValue = root->userdata;
+  if (root->first != NULL)
+  {
+    childKeyValue = root->first->userdata;
+    if (strcmp(childKeyValue->key, keyValue->key) >= 0)
+    {
+      return false;
+    }
+  }
+  if (root->second != NULL)
+  {
+    childKeyValue = root->second->userdata;
+    if (strcmp(childKeyValue->key, keyValue->key) <= 0)
+    {
+      return false;
+    }
+  }
+  if (!CheckSubtree(root->first, &leftHeight) ||
+      !CheckSubtree(root->second, &rightHeight))
+  {
+    return false;
+  }
+  *height = 1 + (leftHeight > rightHeight ? leftHeight
+                                          : rightHeight);
+  return true;
+}
+
+/// @brief Check the order and the height of a tree.
+/// @param tree The tree to check.
+/// @return true if the tree is sorted and balanced.
+static bool CheckTree(GenUtils_BinaryTree *tree)
+{
+  size_t height = 0;
+  size_t maxHeight = 0;
+  // The height of a red-black tree is at most
+  // 2 * log2(n + 1).
+  for (size_t n = GenUtils_BinaryTreeGetSize(tree) + 1;
+       n > 1; n /= 2)
+  {
+    maxHeight += 2;
+  }
+  if (!CheckSubtree(GenUtils_BinaryTreeRoot(tree), &height))
+  {
+    puts("The keys of the tree aren't sorted.");
+    return false;
+  }
+  printf("Size: %zu, height: %zu.\n",
+    GenUtils_BinaryTreeGetSize(tree), height);
+  if (height > maxHeight + 2)
+  {
+    puts("The tree isn't balanced.");
+    return false;
+  }
+  return true;
+}
+
+/// @brief Check the order of an inorder traversal.
+/// @param keyValue The current key/value pair.
+/// @param extradata Pointer to the previous key.
+static void CheckInorder(
+  const GenUtils_BinaryTreeKeyValue *keyValue,
+  void *extradata)
+{
+  const char **previousKey = extradata;
+  if (*previousKey != NULL &&
+      strcmp(*previousKey, keyValue->key) >= 0)
+  {
+    puts("Inorder traversal isn't sorted.");
+    exit(EXIT_FAILURE);
+  }
+  *previousKey = keyValue->key;
+}
+
+/// @brief Count the pairs of a traversal.
+/// @param keyValue The current key/value pair.
+/// @param extradata Pointer to the counter.
+static void CountKeys(
+  const GenUtils_BinaryTreeKeyValue *keyValue,
+  void *extradata)
+{
+  (void)keyValue;
+  (*(size_t *)extradata)++;
+}
+
+/// @brief Check the keys visited by a cursor, that must be
+/// the odd keys.
+/// @param cursor The cursor at the first key to check.
+/// @param keys The keys of the test.
+/// @param forward true to move to the next keys.
+/// @return true if all the odd keys were visited.
+static bool CheckCursor(GenUtils_BinaryTreeCursor *cursor,
+  char (*keys)[16], bool forward)
+{
+  size_t count = 0;
+  const GenUtils_BinaryTreeKeyValue *keyValue =
+    GenUtils_BinaryTreeCursorGet(cursor);
+  while (keyValue != NULL)
+  {
+    size_t i = forward ? 2 * count + 1
+                       : TEST_SIZE - 1 - 2 * count;
+    if (count >= TEST_SIZE / 2 ||
+        strcmp(keyValue->key, keys[i]) != 0)
+    {
+      return false;
+    }
+    count++;
+    if (forward)
+    {
+      GenUtils_BinaryTreeCursorNext(cursor);
+    }
+    else
+    {
+      GenUtils_BinaryTreeCursorPrev(cursor);
+    }
+    keyValue = GenUtils_BinaryTreeCursorGet(cursor);
+  }
+  return count == TEST_SIZE / 2;
+}
+
+int main(void)
+{
+  GenUtils_BinaryTree *tree = NULL;
+  static char keys[TEST_SIZE][16];
+  static int values[TEST_SIZE];
+  char buffer[16];
+  GenUtils_BinaryTreeCursor cursor;
+  size_t count = 0;
+  GenUtils_BinaryTreeKeyValue keyValue = {0};
+  GenUtils_BinaryTreeOptions options = {0};
+  TestAllocator allocator;
+  const char *previousKey = NULL;
+  puts("Test for the implementation of a binary tree.");
+  puts("Creating the test tree...");
+  tree = GenUtils_BinaryTreeCreate();
+  if (!GenUtils_BinaryTreeWasInit(tree))
+  {
+    puts("Error creating the tree.");
+    return EXIT_FAILURE;
+  }
+  puts("Inserting sorted keys...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    snprintf(keys[i], sizeof(keys[i]), "key%08d", i);
+    values[i] = i;
+    keyValue.key = keys[i];
+    keyValue.value = &values[i];
+    if (!GenUtils_BinaryTreeInsert(tree, keyValue))
+    {
+      puts("Error inserting keys.");
+      GenUtils_BinaryTreeDestroy(tree);
+      return EXIT_FAILURE;
+    }
+  }
+  if (GenUtils_BinaryTreeInsert(tree, keyValue))
+  {
+    puts("A duplicated key was inserted.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  if (!CheckTree(tree))
+  {
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  puts("Rebuilding the tree from a sorted array...");
+  tree = GenUtils_BinaryTreeBalance(tree);
+  if (tree == NULL || !CheckTree(tree) ||
+      GenUtils_BinaryTreeGetSize(tree) != TEST_SIZE ||
+      tree->pool != NULL)
+  {
+    puts("Error rebuilding the tree.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  puts("Searching the keys...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    if (GenUtils_BinaryTreeGet(tree, keys[i]) != &values[i])
+    {
+      puts("Error searching keys.");
+      GenUtils_BinaryTreeDestroy(tree);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Removing the even keys...");
+  for (int i = 0; i < TEST_SIZE; i += 2)
+  {
+    if (GenUtils_BinaryTreeRemove(tree, keys[i]) !=
+        &values[i])
+    {
+      puts("Error removing keys.");
+      GenUtils_BinaryTreeDestroy(tree);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!CheckTree(tree) ||
+      GenUtils_BinaryTreeGetSize(tree) != TEST_SIZE / 2)
+  {
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  puts("Checking the remaining keys...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    if (GenUtils_BinaryTreeExist(tree, keys[i]) != (i % 2))
+    {
+      puts("Error checking keys.");
+      GenUtils_BinaryTreeDestroy(tree);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Setting a value...");
+  keyValue.key = keys[1];
+  keyValue.value = &values[0];
+  if (!GenUtils_BinaryTreeSet(tree, keyValue) ||
+      GenUtils_BinaryTreeGet(tree, keys[1]) != &values[0])
+  {
+    puts("Error setting a value.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  puts("Checking the inorder traversal...");
+  GenUtils_BinaryTreeInorder(
+    tree, &previousKey, CheckInorder);
+  puts("Checking the other traversals...");
+  GenUtils_BinaryTreePreorder(tree, &count, CountKeys);
+  GenUtils_BinaryTreePostorder(tree, &count, CountKeys);
+  if (count != TEST_SIZE)
+  {
+    puts("Error in the traversals.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  puts("Moving a cursor...");
+  GenUtils_BinaryTreeCursorFirst(&cursor, tree);
+  if (!CheckCursor(&cursor, keys, true))
+  {
+    puts("Error moving the cursor forward.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  GenUtils_BinaryTreeCursorLast(&cursor, tree);
+  if (!CheckCursor(&cursor, keys, false))
+  {
+    puts("Error moving the cursor backward.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  if (!GenUtils_BinaryTreeCursorSeek(
+        &cursor, tree, keys[2]) ||
+      GenUtils_BinaryTreeCursorGet(&cursor)->key !=
+        keys[3] ||
+      !GenUtils_BinaryTreeCursorSeek(
+        &cursor, tree, keys[5]) ||
+      GenUtils_BinaryTreeCursorGet(&cursor)->key !=
+        keys[5] ||
+      !GenUtils_BinaryTreeCursorPrev(&cursor) ||
+      GenUtils_BinaryTreeCursorGet(&cursor)->key !=
+        keys[3] ||
+      GenUtils_BinaryTreeCursorSeek(&cursor, tree, "z"))
+  {
+    puts("Error seeking keys.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  puts("Querying ranges...");
+  count = 0;
+  GenUtils_BinaryTreeRange(
+    tree, keys[10], keys[20], &count, CountKeys);
+  GenUtils_BinaryTreePrefixRange(
+    tree, "key0000001", &count, CountKeys);
+  if (GenUtils_BinaryTreeLowerBound(tree, keys[2])->key !=
+        keys[3] ||
+      GenUtils_BinaryTreeUpperBound(tree, keys[3])->key !=
+        keys[5] ||
+      GenUtils_BinaryTreeUpperBound(
+        tree, keys[TEST_SIZE - 1]) != NULL ||
+      GenUtils_BinaryTreeRangeCount(
+        tree, keys[10], keys[20]) != 5 ||
+      GenUtils_BinaryTreeRangeCount(tree, NULL, NULL) !=
+        TEST_SIZE / 2 ||
+      count != 10)
+  {
+    puts("Error querying ranges.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  puts("Removing the remaining keys...");
+  for (int i = 1; i < TEST_SIZE; i += 2)
+  {
+    if (!GenUtils_BinaryTreeRemoveBool(tree, keys[i]))
+    {
+      puts("Error removing keys.");
+      GenUtils_BinaryTreeDestroy(tree);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!GenUtils_BinaryTreeEmpty(tree))
+  {
+    puts("The tree isn't empty.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  puts("Copying the keys to an arena...");
+  GenUtils_BinaryTreeDestroy(tree);
+  options.keyArena = true;
+  tree = GenUtils_BinaryTreeCreateWithOptions(&options);
+  if (!GenUtils_BinaryTreeWasInit(tree))
+  {
+    puts("Error creating the tree.");
+    return EXIT_FAILURE;
+  }
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    // The buffer is reused, so the tree must copy it.
+    snprintf(buffer, sizeof(buffer), "key%08d", i);
+    keyValue.key = buffer;
+    keyValue.value = &values[i];
+    if (!GenUtils_BinaryTreeInsert(tree, keyValue))
+    {
+      puts("Error inserting keys.");
+      GenUtils_BinaryTreeDestroy(tree);
+      return EXIT_FAILURE;
+    }
+    // The first key never moves while the arena grows.
+    if (i == 0)
+    {
+      GenUtils_BinaryTreeCursorFirst(&cursor, tree);
+      previousKey =
+        GenUtils_BinaryTreeCursorGet(&cursor)->key;
+    }
+  }
+  if (strcmp(previousKey, keys[0]) != 0)
+  {
+    puts("Error, a key of the arena moved.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    if (GenUtils_BinaryTreeGet(tree, keys[i]) != &values[i])
+    {
+      puts("Error searching keys.");
+      GenUtils_BinaryTreeDestroy(tree);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Compacting the arena...");
+  for (int i = 0; i < TEST_SIZE; i += 2)
+  {
+    GenUtils_BinaryTreeRemoveBool(tree, keys[i]);
+  }
+  tree = GenUtils_BinaryTreeBalance(tree);
+  if (tree == NULL || !CheckTree(tree) ||
+      tree->keyArena->size !=
+        TEST_SIZE / 2 * (strlen(keys[0]) + 1))
+  {
+    puts("Error compacting the arena.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    if (GenUtils_BinaryTreeExist(tree, keys[i]) != (i % 2))
+    {
+      puts("Error checking keys.");
+      GenUtils_BinaryTreeDestroy(tree);
+      return EXIT_FAILURE;
+    }
+  }
+  previousKey = NULL;
+  GenUtils_BinaryTreeInorder(
+    tree, &previousKey, CheckInorder);
+  GenUtils_BinaryTreeClear(tree);
+  if (!GenUtils_BinaryTreeEmpty(tree) ||
+      tree->keyArena->size != 0)
+  {
+    puts("Error clearing the tree.");
+    GenUtils_BinaryTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  puts("Ranking keys...");
+  GenUtils_BinaryTreeDestroy(tree);
+  TestAllocatorInit(&allocator, false);
+  options.allocator = &allocator.allocator;
+  options.pool = true;
+  options.counted = true;
+  tree = GenUtils_BinaryTreeCreateWithOptions(&options);
+  if (!GenUtils_BinaryTreeWasInit(tree))
+  {
+    puts("Error creating the tree.");
+    TestAllocatorDestroy(&allocator);
+    return EXIT_FAILURE;
+  }
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    keyValue.key = keys[i];
+    keyValue.value = &values[i];
+    GenUtils_BinaryTreeInsert(tree, keyValue);
+  }
+  for (int i = 0; i < TEST_SIZE; i += 2)
+  {
+    GenUtils_BinaryTreeRemoveBool(tree, keys[i]);
+  }
+  for (size_t i = 0; i < TEST_SIZE / 2; i++)
+  {
+    if (strcmp(GenUtils_BinaryTreeSelect(tree, i)->key,
+          keys[2 * i + 1]) != 0 ||
+        GenUtils_BinaryTreeRank(tree, keys[2 * i]) != i ||
+        GenUtils_BinaryTreeRank(tree, keys[2 * i + 1]) != i)
+    {
+      puts("Error ranking keys.");
+      GenUtils_BinaryTreeDestroy(tree);
+      TestAllocatorDestroy(&allocator);
+      return EXIT_FAILURE;
+    }
+  }
+  if (GenUtils_BinaryTreeSelect(tree, TEST_SIZE / 2) !=
+        NULL ||
+      GenUtils_BinaryTreeRangeCount(
+        tree, keys[10], keys[20]) != 5 ||
+      !CheckTree(tree))
+  {
+    puts("Error ranking keys.");
+    GenUtils_BinaryTreeDestroy(tree);
+    TestAllocatorDestroy(&allocator);
+    return EXIT_FAILURE;
+  }
+  puts("Balancing with all the options...");
+  tree = GenUtils_BinaryTreeBalance(tree);
+  if (tree == NULL || !CheckTree(tree) ||
+      tree->allocator != &allocator.allocator ||
+      tree->pool == NULL || tree->keyArena == NULL ||
+      !tree->counted ||
+      GenUtils_BinaryTreeRank(tree, keys[11]) != 5)
+  {
+    puts("Error balancing the tree.");
+    GenUtils_BinaryTreeDestroy(tree);
+    TestAllocatorDestroy(&allocator);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying tree...");
+  GenUtils_BinaryTreeDestroy(tree);
+  if (TestAllocatorLeaks(&allocator))
+  {
+    puts("Error, the tree leaked memory.");
+    TestAllocatorDestroy(&allocator);
+    return EXIT_FAILURE;
+  }
+  TestAllocatorDestroy(&allocator);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
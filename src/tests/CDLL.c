@@ -1,20 +1,24 @@
 /// @file CDLL.c
 /// @author DP-Dev.
 /// @brief Test for the implementation of CDLL.
-#include <Utils/CDLL.h>
+#include <GenUtils/CDLL.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 int main(void)
 {
-  Utils_CDLL *list = NULL;
+  GenUtils_CDLL *list = NULL;
+  GenUtils_CDLL *other = NULL;
+  GenUtils_CDLL *shared = NULL;
+  GenUtils_Pool *pool = NULL;
+  size_t size = 0;
   int array[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
   size_t j = 0;
-  Utils_DoubleNode *currentNode = NULL;
+  GenUtils_DoubleNode *currentNode = NULL;
   puts("Test for the implementation of a CDLL.");
   puts("Creating the test list...");
-  list = Utils_CDLLCreate();
-  if (!Utils_CDLLWasInit(list))
+  list = GenUtils_CDLLCreate();
+  if (!GenUtils_CDLLWasInit(list))
   {
     puts("Error creating the list.");
     return EXIT_FAILURE;
@@ -24,19 +28,19 @@ int main(void)
   for (size_t i = 0; i < 5; i++)
   {
     printf("Prepending integer %d...\n", array[i]);
-    if (!Utils_CDLLPushFront(list, &array[i]))
+    if (!GenUtils_CDLLPushFront(list, &array[i]))
     {
       puts("Error prepending elements.");
-      Utils_CDLLDestroy(list);
+      GenUtils_CDLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CDLLBegin(list);
+    currentNode = GenUtils_CDLLBegin(list);
     printf("{");
-    while (j < Utils_CDLLGetSize(list))
+    while (j < GenUtils_CDLLGetSize(list))
     {
-      if (j < Utils_CDLLGetSize(list) - 1)
+      if (j < GenUtils_CDLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -44,7 +48,7 @@ int main(void)
       {
         printf("%d", *((int *)(currentNode->userdata)));
       }
-      currentNode = currentNode->nextNode;
+      currentNode = currentNode->second;
       j++;
     }
     printf("}\n");
@@ -53,19 +57,19 @@ int main(void)
   for (size_t i = 0; i < 5; i++)
   {
     printf("Appending integer %d...\n", array[i + 5]);
-    if (!Utils_CDLLPushBack(list, &array[5 + i]))
+    if (!GenUtils_CDLLPushBack(list, &array[5 + i]))
     {
       puts("Error appending elements.");
-      Utils_CDLLDestroy(list);
+      GenUtils_CDLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CDLLBegin(list);
+    currentNode = GenUtils_CDLLBegin(list);
     printf("{");
-    while (j < Utils_CDLLGetSize(list))
+    while (j < GenUtils_CDLLGetSize(list))
     {
-      if (j < Utils_CDLLGetSize(list) - 1)
+      if (j < GenUtils_CDLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -73,7 +77,7 @@ int main(void)
       {
         printf("%d", *((int *)(currentNode->userdata)));
       }
-      currentNode = currentNode->nextNode;
+      currentNode = currentNode->second;
       j++;
     }
     printf("}\n");
@@ -82,20 +86,20 @@ int main(void)
   for (size_t i = 0; i < 5; i++)
   {
     printf("Inserting integer %d...\n", array[i + 3]);
-    if (!Utils_CDLLInsertAfter(
-          list, Utils_CDLLBegin(list), &array[i + 3]))
+    if (!GenUtils_CDLLInsertAfter(
+          list, GenUtils_CDLLBegin(list), &array[i + 3]))
     {
       puts("Error inserting elements.");
-      Utils_CDLLDestroy(list);
+      GenUtils_CDLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CDLLBegin(list);
+    currentNode = GenUtils_CDLLBegin(list);
     printf("{");
-    while (j < Utils_CDLLGetSize(list))
+    while (j < GenUtils_CDLLGetSize(list))
     {
-      if (j < Utils_CDLLGetSize(list) - 1)
+      if (j < GenUtils_CDLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -103,7 +107,7 @@ int main(void)
       {
         printf("%d", *((int *)(currentNode->userdata)));
       }
-      currentNode = currentNode->nextNode;
+      currentNode = currentNode->second;
       j++;
     }
     printf("}\n");
@@ -113,20 +117,20 @@ int main(void)
   for (size_t i = 0; i < 3; i++)
   {
     printf("Removing integer %d.\n",
-      *((int *)(Utils_CDLLBegin(list)->userdata)));
-    if (!Utils_CDLLPopFront(list))
+      *((int *)(GenUtils_CDLLBegin(list)->userdata)));
+    if (!GenUtils_CDLLPopFrontBool(list))
     {
       puts("Error popping elements.");
-      Utils_CDLLDestroy(list);
+      GenUtils_CDLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CDLLBegin(list);
+    currentNode = GenUtils_CDLLBegin(list);
     printf("{");
-    while (j < Utils_CDLLGetSize(list))
+    while (j < GenUtils_CDLLGetSize(list))
     {
-      if (j < Utils_CDLLGetSize(list) - 1)
+      if (j < GenUtils_CDLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -134,7 +138,7 @@ int main(void)
       {
         printf("%d", *((int *)(currentNode->userdata)));
       }
-      currentNode = currentNode->nextNode;
+      currentNode = currentNode->second;
       j++;
     }
     printf("}\n");
@@ -143,20 +147,20 @@ int main(void)
   for (size_t i = 0; i < 3; i++)
   {
     printf("Removing integer %d.\n",
-      *((int *)(Utils_CDLLEnd(list)->userdata)));
-    if (!Utils_CDLLPopBack(list))
+      *((int *)(GenUtils_CDLLEnd(list)->userdata)));
+    if (!GenUtils_CDLLPopBackBool(list))
     {
       puts("Error popping elements.");
-      Utils_CDLLDestroy(list);
+      GenUtils_CDLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CDLLBegin(list);
+    currentNode = GenUtils_CDLLBegin(list);
     printf("{");
-    while (j < Utils_CDLLGetSize(list))
+    while (j < GenUtils_CDLLGetSize(list))
     {
-      if (j < Utils_CDLLGetSize(list) - 1)
+      if (j < GenUtils_CDLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -164,7 +168,7 @@ int main(void)
       {
         printf("%d", *((int *)(currentNode->userdata)));
       }
-      currentNode = currentNode->nextNode;
+      currentNode = currentNode->second;
       j++;
     }
     printf("}\n");
@@ -173,20 +177,23 @@ int main(void)
   for (size_t i = 0; i < 2; i++)
   {
     printf("Removing integer %d.\n",
-      *((int *)(Utils_CDLLEnd(list)->nextNode->userdata)));
-    if (!Utils_CDLLRemoveAfter(list, Utils_CDLLBegin(list)))
+      *((int *)(GenUtils_CDLLBegin(list)
+                  ->second
+                  ->userdata)));
+    if (!GenUtils_CDLLRemoveAfter(
+          list, GenUtils_CDLLBegin(list)))
     {
       puts("Error removing elements.");
-      Utils_CDLLDestroy(list);
+      GenUtils_CDLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CDLLBegin(list);
+    currentNode = GenUtils_CDLLBegin(list);
     printf("{");
-    while (j < Utils_CDLLGetSize(list))
+    while (j < GenUtils_CDLLGetSize(list))
     {
-      if (j < Utils_CDLLGetSize(list) - 1)
+      if (j < GenUtils_CDLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -194,12 +201,109 @@ int main(void)
       {
         printf("%d", *((int *)(currentNode->userdata)));
       }
-      currentNode = currentNode->nextNode;
+      currentNode = currentNode->second;
       j++;
     }
     printf("}\n");
   }
+  puts("Moving elements between lists...");
+  other = GenUtils_CDLLCreate();
+  for (size_t i = 5; i < 10; i++)
+  {
+    if (!GenUtils_CDLLPushBack(other, &array[i]))
+    {
+      puts("Error appending elements.");
+      GenUtils_CDLLDestroy(other);
+      GenUtils_CDLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+  }
+  size = GenUtils_CDLLGetSize(list);
+  if (!GenUtils_CDLLConcat(list, other) ||
+      !GenUtils_CDLLEmpty(other) ||
+      GenUtils_CDLLGetSize(list) != size + 5 ||
+      GenUtils_CDLLEnd(list)->userdata != &array[9])
+  {
+    puts("Error concatenating lists.");
+    GenUtils_CDLLDestroy(other);
+    GenUtils_CDLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  if (!GenUtils_CDLLSplit(
+        list, GenUtils_CDLLBegin(list)->second, other) ||
+      GenUtils_CDLLGetSize(other) != size + 4 ||
+      GenUtils_CDLLGetSize(list) != 1 ||
+      GenUtils_CDLLEnd(other)->userdata != &array[9])
+  {
+    puts("Error splitting the list.");
+    GenUtils_CDLLDestroy(other);
+    GenUtils_CDLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  GenUtils_CDLLDestroy(other);
+  puts("Moving elements between lists sharing a pool...");
+  pool = GenUtils_PoolCreate(
+    sizeof(GenUtils_DoubleNode), 16);
+  other = GenUtils_CDLLCreateWithSharedPool(pool);
+  shared = GenUtils_CDLLCreateWithSharedPool(pool);
+  for (size_t i = 0; i < 10; i++)
+  {
+    if (!GenUtils_CDLLPushBack(
+          i < 5 ? other : shared, &array[i]))
+    {
+      puts("Error appending elements.");
+      GenUtils_CDLLDestroy(shared);
+      GenUtils_CDLLDestroy(other);
+      GenUtils_PoolDestroy(pool);
+      GenUtils_CDLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+  }
+  // A list with its own pool or with malloc can't take
+  // the nodes of the shared pool.
+  if (GenUtils_CDLLConcat(list, other) ||
+      !GenUtils_CDLLConcat(other, shared) ||
+      GenUtils_CDLLGetSize(other) != 10 ||
+      !GenUtils_CDLLEmpty(shared) ||
+      GenUtils_CDLLEnd(other)->userdata != &array[9])
+  {
+    puts("Error concatenating lists.");
+    GenUtils_CDLLDestroy(shared);
+    GenUtils_CDLLDestroy(other);
+    GenUtils_PoolDestroy(pool);
+    GenUtils_CDLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  // The shared pool outlives the lists.
+  GenUtils_CDLLClear(other);
+  GenUtils_CDLLDestroy(shared);
+  GenUtils_CDLLDestroy(other);
+  GenUtils_PoolDestroy(pool);
+  puts("Destroying a list with its data...");
+  other = GenUtils_CDLLCreate();
+  for (size_t i = 0; i < 10; i++)
+  {
+    if (!GenUtils_CDLLPushBack(other, malloc(sizeof(int))))
+    {
+      puts("Error appending elements.");
+      GenUtils_CDLLDestroyWith(other, free);
+      GenUtils_CDLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+    if (i == 4)
+    {
+      GenUtils_CDLLClearWith(other, free);
+    }
+  }
+  if (GenUtils_CDLLGetSize(other) != 5)
+  {
+    puts("Error clearing the list.");
+    GenUtils_CDLLDestroyWith(other, free);
+    GenUtils_CDLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  GenUtils_CDLLDestroyWith(other, free);
   puts("Detroying list...");
-  Utils_CDLLDestroy(list);
+  GenUtils_CDLLDestroy(list);
   puts("Test passed!");
 }
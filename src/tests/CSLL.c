@@ -1,20 +1,24 @@
 /// @file CSLL.c
 /// @author DP-Dev.
 /// @brief Test for the implementation of CSLL.
-#include <Utils/CSLL.h>
+#include <GenUtils/CSLL.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 int main(void)
 {
-  Utils_CSLL *list = NULL;
+  GenUtils_CSLL *list = NULL;
+  GenUtils_CSLL *other = NULL;
+  GenUtils_CSLL *shared = NULL;
+  GenUtils_Pool *pool = NULL;
+  size_t size = 0;
   int array[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
   size_t j = 0;
-  Utils_SingleNode *currentNode = NULL;
+  GenUtils_SingleNode *currentNode = NULL;
   puts("Test for the implementation of a CSLL.");
   puts("Creating the test list...");
-  list = Utils_CSLLCreate();
-  if (!Utils_CSLLWasInit(list))
+  list = GenUtils_CSLLCreate();
+  if (!GenUtils_CSLLWasInit(list))
   {
     puts("Error creating the list.");
     return EXIT_FAILURE;
@@ -24,19 +28,19 @@ int main(void)
   for (size_t i = 0; i < 5; i++)
   {
     printf("Prepending integer %d...\n", array[i]);
-    if (!Utils_CSLLPushFront(list, &array[i]))
+    if (!GenUtils_CSLLPushFront(list, &array[i]))
     {
       puts("Error prepending elements.");
-      Utils_CSLLDestroy(list);
+      GenUtils_CSLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CSLLBegin(list);
+    currentNode = GenUtils_CSLLBegin(list);
     printf("{");
-    while (j < Utils_CSLLGetSize(list))
+    while (j < GenUtils_CSLLGetSize(list))
     {
-      if (j < Utils_CSLLGetSize(list) - 1)
+      if (j < GenUtils_CSLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -53,19 +57,19 @@ int main(void)
   for (size_t i = 0; i < 5; i++)
   {
     printf("Appending integer %d...\n", array[i + 5]);
-    if (!Utils_CSLLPushBack(list, &array[5 + i]))
+    if (!GenUtils_CSLLPushBack(list, &array[5 + i]))
     {
       puts("Error appending elements.");
-      Utils_CSLLDestroy(list);
+      GenUtils_CSLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CSLLBegin(list);
+    currentNode = GenUtils_CSLLBegin(list);
     printf("{");
-    while (j < Utils_CSLLGetSize(list))
+    while (j < GenUtils_CSLLGetSize(list))
     {
-      if (j < Utils_CSLLGetSize(list) - 1)
+      if (j < GenUtils_CSLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -82,20 +86,20 @@ int main(void)
   for (size_t i = 0; i < 5; i++)
   {
     printf("Inserting integer %d...\n", array[i + 3]);
-    if (!Utils_CSLLInsertAfter(
-          list, Utils_CSLLBegin(list), &array[i + 3]))
+    if (!GenUtils_CSLLInsertAfter(
+          list, GenUtils_CSLLBegin(list), &array[i + 3]))
     {
       puts("Error inserting elements.");
-      Utils_CSLLDestroy(list);
+      GenUtils_CSLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CSLLBegin(list);
+    currentNode = GenUtils_CSLLBegin(list);
     printf("{");
-    while (j < Utils_CSLLGetSize(list))
+    while (j < GenUtils_CSLLGetSize(list))
     {
-      if (j < Utils_CSLLGetSize(list) - 1)
+      if (j < GenUtils_CSLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -113,20 +117,20 @@ int main(void)
   for (size_t i = 0; i < 3; i++)
   {
     printf("Removing integer %d.\n",
-      *((int *)(Utils_CSLLBegin(list)->userdata)));
-    if (!Utils_CSLLPopFront(list))
+      *((int *)(GenUtils_CSLLBegin(list)->userdata)));
+    if (!GenUtils_CSLLPopFrontBool(list))
     {
       puts("Error popping elements.");
-      Utils_CSLLDestroy(list);
+      GenUtils_CSLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CSLLBegin(list);
+    currentNode = GenUtils_CSLLBegin(list);
     printf("{");
-    while (j < Utils_CSLLGetSize(list))
+    while (j < GenUtils_CSLLGetSize(list))
     {
-      if (j < Utils_CSLLGetSize(list) - 1)
+      if (j < GenUtils_CSLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -143,20 +147,20 @@ int main(void)
   for (size_t i = 0; i < 3; i++)
   {
     printf("Removing integer %d.\n",
-      *((int *)(Utils_CSLLEnd(list)->userdata)));
-    if (!Utils_CSLLPopBack(list))
+      *((int *)(GenUtils_CSLLEnd(list)->userdata)));
+    if (!GenUtils_CSLLPopBackBool(list))
     {
       puts("Error popping elements.");
-      Utils_CSLLDestroy(list);
+      GenUtils_CSLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CSLLBegin(list);
+    currentNode = GenUtils_CSLLBegin(list);
     printf("{");
-    while (j < Utils_CSLLGetSize(list))
+    while (j < GenUtils_CSLLGetSize(list))
     {
-      if (j < Utils_CSLLGetSize(list) - 1)
+      if (j < GenUtils_CSLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -173,20 +177,23 @@ int main(void)
   for (size_t i = 0; i < 2; i++)
   {
     printf("Removing integer %d.\n",
-      *((int *)(Utils_CSLLEnd(list)->nextNode->userdata)));
-    if (!Utils_CSLLRemoveAfter(list, Utils_CSLLBegin(list)))
+      *((int *)(GenUtils_CSLLBegin(list)
+                  ->nextNode
+                  ->userdata)));
+    if (!GenUtils_CSLLRemoveAfter(
+          list, GenUtils_CSLLBegin(list)))
     {
       puts("Error removing elements.");
-      Utils_CSLLDestroy(list);
+      GenUtils_CSLLDestroy(list);
       return EXIT_FAILURE;
     }
     puts("Test list now is:");
     j = 0;
-    currentNode = Utils_CSLLBegin(list);
+    currentNode = GenUtils_CSLLBegin(list);
     printf("{");
-    while (j < Utils_CSLLGetSize(list))
+    while (j < GenUtils_CSLLGetSize(list))
     {
-      if (j < Utils_CSLLGetSize(list) - 1)
+      if (j < GenUtils_CSLLGetSize(list) - 1)
       {
         printf("%d, ", *((int *)(currentNode->userdata)));
       }
@@ -199,7 +206,104 @@ int main(void)
     }
     printf("}\n");
   }
+  puts("Moving elements between lists...");
+  other = GenUtils_CSLLCreate();
+  for (size_t i = 5; i < 10; i++)
+  {
+    if (!GenUtils_CSLLPushBack(other, &array[i]))
+    {
+      puts("Error appending elements.");
+      GenUtils_CSLLDestroy(other);
+      GenUtils_CSLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+  }
+  size = GenUtils_CSLLGetSize(list);
+  if (!GenUtils_CSLLConcat(list, other) ||
+      !GenUtils_CSLLEmpty(other) ||
+      GenUtils_CSLLGetSize(list) != size + 5 ||
+      GenUtils_CSLLEnd(list)->userdata != &array[9])
+  {
+    puts("Error concatenating lists.");
+    GenUtils_CSLLDestroy(other);
+    GenUtils_CSLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  if (!GenUtils_CSLLSplitAfter(
+        list, GenUtils_CSLLBegin(list)->nextNode, other) ||
+      GenUtils_CSLLGetSize(other) != size + 3 ||
+      GenUtils_CSLLGetSize(list) != 2 ||
+      GenUtils_CSLLEnd(other)->userdata != &array[9])
+  {
+    puts("Error splitting the list.");
+    GenUtils_CSLLDestroy(other);
+    GenUtils_CSLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  GenUtils_CSLLDestroy(other);
+  puts("Moving elements between lists sharing a pool...");
+  pool = GenUtils_PoolCreate(
+    sizeof(GenUtils_SingleNode), 16);
+  other = GenUtils_CSLLCreateWithSharedPool(pool);
+  shared = GenUtils_CSLLCreateWithSharedPool(pool);
+  for (size_t i = 0; i < 10; i++)
+  {
+    if (!GenUtils_CSLLPushBack(
+          i < 5 ? other : shared, &array[i]))
+    {
+      puts("Error appending elements.");
+      GenUtils_CSLLDestroy(shared);
+      GenUtils_CSLLDestroy(other);
+      GenUtils_PoolDestroy(pool);
+      GenUtils_CSLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+  }
+  // A list with its own pool or with malloc can't take
+  // the nodes of the shared pool.
+  if (GenUtils_CSLLConcat(list, other) ||
+      !GenUtils_CSLLConcat(other, shared) ||
+      GenUtils_CSLLGetSize(other) != 10 ||
+      !GenUtils_CSLLEmpty(shared) ||
+      GenUtils_CSLLEnd(other)->userdata != &array[9])
+  {
+    puts("Error concatenating lists.");
+    GenUtils_CSLLDestroy(shared);
+    GenUtils_CSLLDestroy(other);
+    GenUtils_PoolDestroy(pool);
+    GenUtils_CSLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  // The shared pool outlives the lists.
+  GenUtils_CSLLClear(other);
+  GenUtils_CSLLDestroy(shared);
+  GenUtils_CSLLDestroy(other);
+  GenUtils_PoolDestroy(pool);
+  puts("Destroying a list with its data...");
+  other = GenUtils_CSLLCreate();
+  for (size_t i = 0; i < 10; i++)
+  {
+    if (!GenUtils_CSLLPushBack(other, malloc(sizeof(int))))
+    {
+      puts("Error appending elements.");
+      GenUtils_CSLLDestroyWith(other, free);
+      GenUtils_CSLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+    if (i == 4)
+    {
+      GenUtils_CSLLClearWith(other, free);
+    }
+  }
+  if (GenUtils_CSLLGetSize(other) != 5)
+  {
+    puts("Error clearing the list.");
+    GenUtils_CSLLDestroyWith(other, free);
+    GenUtils_CSLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  GenUtils_CSLLDestroyWith(other, free);
   puts("Detroying list...");
-  Utils_CSLLDestroy(list);
+  GenUtils_CSLLDestroy(list);
   puts("Test passed!");
 }
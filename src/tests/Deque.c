@@ -0,0 +1,110 @@
+/// @file Deque.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a deque.
+#include <GenUtils/Deque.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Number of elements used in the test.
+#define TEST_SIZE 100
+
+/// @brief Count the elements of the segments of a deque.
+/// @param elements The first element of the segment.
+/// @param size The number of elements of the segment.
+/// @param extradata Pointer to the counter.
+static void CountSegment(
+  void **elements, size_t size, void *extradata)
+{
+  (void)elements;
+  *(size_t *)extradata += size;
+}
+
+int main(void)
+{
+  GenUtils_Deque *deque = NULL;
+  static int array[TEST_SIZE];
+  size_t count = 0;
+  puts("Test for the implementation of a deque.");
+  puts("Creating the test deque...");
+  deque = GenUtils_DequeCreate();
+  if (!GenUtils_DequeWasInit(deque))
+  {
+    puts("Error creating the deque.");
+    return EXIT_FAILURE;
+  }
+  puts("Pushing elements at both ends...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    array[i] = i;
+  }
+  for (int i = TEST_SIZE / 2; i < TEST_SIZE; i++)
+  {
+    if (!GenUtils_DequePushBack(deque, &array[i]))
+    {
+      puts("Error appending elements.");
+      GenUtils_DequeDestroy(deque);
+      return EXIT_FAILURE;
+    }
+  }
+  for (int i = TEST_SIZE / 2 - 1; i >= 0; i--)
+  {
+    if (!GenUtils_DequePushFront(deque, &array[i]))
+    {
+      puts("Error prepending elements.");
+      GenUtils_DequeDestroy(deque);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Checking the elements by index...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    if (GenUtils_DequeGet(deque, i) != &array[i])
+    {
+      puts("Error getting elements.");
+      GenUtils_DequeDestroy(deque);
+      return EXIT_FAILURE;
+    }
+  }
+  GenUtils_DequeIterateSegments(
+    deque, &count, CountSegment);
+  if (count != TEST_SIZE)
+  {
+    puts("Error iterating the segments.");
+    GenUtils_DequeDestroy(deque);
+    return EXIT_FAILURE;
+  }
+  puts("Using the deque as a queue...");
+  for (int j = 0; j < 3 * TEST_SIZE; j++)
+  {
+    int *element = GenUtils_DequePopFront(deque);
+    if (element != &array[j % TEST_SIZE] ||
+        !GenUtils_DequePushBack(deque, element))
+    {
+      puts("Error popping elements.");
+      GenUtils_DequeDestroy(deque);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Popping elements from the end...");
+  for (int i = TEST_SIZE - 1; i >= 0; i--)
+  {
+    if (GenUtils_DequeEnd(deque) != &array[i] ||
+        GenUtils_DequePopBack(deque) != &array[i])
+    {
+      puts("Error popping elements.");
+      GenUtils_DequeDestroy(deque);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!GenUtils_DequeEmpty(deque) ||
+      GenUtils_DequePopFrontBool(deque))
+  {
+    puts("The deque isn't empty.");
+    GenUtils_DequeDestroy(deque);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying deque...");
+  GenUtils_DequeDestroy(deque);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
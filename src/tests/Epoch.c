@@ -0,0 +1,269 @@
+/// @file Epoch.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of epoch-based
+/// memory reclamation.
+#include <GenUtils/Epoch.h>
+#include <GenUtils/types.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Number of reader threads.
+#define TEST_READERS 3
+/// @brief Number of objects replaced by the writer.
+#define TEST_SIZE 100000
+/// @brief Value of the objects that were not released.
+#define TEST_MAGIC 0x5EED5EEDu
+/// @brief Number of domains used by a single thread.
+#define TEST_DOMAINS 6
+
+/// @brief An object shared by the threads.
+typedef struct Object
+{
+  GenUtils_EpochEntry entry;
+  unsigned int magic;
+} Object;
+
+/// @brief The domain used by all the threads.
+static GenUtils_Epoch *epoch = NULL;
+/// @brief The object read by the readers.
+static _Atomic(Object *) shared = NULL;
+/// @brief Set when the writer ends.
+static _Atomic bool done = false;
+/// @brief The number of released objects.
+static _Atomic size_t released = 0;
+
+/// @brief Release an object.
+/// @param entry The entry of the object.
+/// @param extradata Not used.
+static void Release(
+  GenUtils_EpochEntry *entry, void *extradata)
+{
+  Object *object =
+    GENUTILS_CONTAINER_OF(entry, Object, entry);
+  (void)extradata;
+  object->magic = 0;
+  free(object);
+  atomic_fetch_add(&released, 1);
+}
+
+/// @brief Read the shared object until the writer ends.
+/// @param argument Not used.
+/// @return NULL.
+static void *Read(void *argument)
+{
+  GenUtils_EpochThread *thread =
+    GenUtils_EpochGetThread(epoch);
+  (void)argument;
+  if (thread == NULL)
+  {
+    puts("Error registering the threads.");
+    exit(EXIT_FAILURE);
+  }
+  while (!atomic_load(&done))
+  {
+    GenUtils_EpochEnter(thread);
+    if (atomic_load(&shared)->magic != TEST_MAGIC)
+    {
+      puts("Error, an object was released while read.");
+      exit(EXIT_FAILURE);
+    }
+    GenUtils_EpochExit(thread);
+    // Let the writer run on a single processor.
+    sched_yield();
+  }
+  GenUtils_EpochUnregister(thread);
+  return NULL;
+}
+
+/// @brief Exit inside a critical section without
+/// unregistering.
+/// @param argument Not used.
+/// @return The record of the thread.
+static void *ExitInside(void *argument)
+{
+  GenUtils_EpochThread *thread =
+    GenUtils_EpochGetThread(epoch);
+  (void)argument;
+  GenUtils_EpochEnter(thread);
+  return thread;
+}
+
+/// @brief Create an object.
+/// @return The new object.
+static Object *CreateObject(void)
+{
+  Object *object = malloc(sizeof(Object));
+  if (object == NULL)
+  {
+    puts("Error creating the objects.");
+    exit(EXIT_FAILURE);
+  }
+  object->magic = TEST_MAGIC;
+  return object;
+}
+
+int main(void)
+{
+  pthread_t threads[TEST_READERS];
+  GenUtils_Epoch *domains[TEST_DOMAINS];
+  GenUtils_EpochThread *records[TEST_DOMAINS];
+  GenUtils_EpochThread *thread = NULL;
+  void *exited = NULL;
+  Object *object = NULL;
+  puts("Test for the implementation of epoch-based memory "
+       "reclamation.");
+  puts("Creating the test domain...");
+  epoch = GenUtils_EpochCreate();
+  if (!GenUtils_EpochWasInit(epoch))
+  {
+    puts("Error creating the domain.");
+    return EXIT_FAILURE;
+  }
+  puts("Registering threads...");
+  thread = GenUtils_EpochGetThread(epoch);
+  if (thread == NULL ||
+      GenUtils_EpochGetThread(epoch) != thread)
+  {
+    puts("Error registering the threads.");
+    GenUtils_EpochDestroy(epoch);
+    return EXIT_FAILURE;
+  }
+  puts("Alternating between domains...");
+  for (size_t i = 0; i < TEST_DOMAINS; i++)
+  {
+    domains[i] = GenUtils_EpochCreate();
+    records[i] = GenUtils_EpochGetThread(domains[i]);
+    if (records[i] == NULL)
+    {
+      puts("Error registering the threads.");
+      return EXIT_FAILURE;
+    }
+  }
+  for (size_t i = 0; i < 4 * TEST_DOMAINS; i++)
+  {
+    if (GenUtils_EpochGetThread(epoch) != thread ||
+        GenUtils_EpochGetThread(
+          domains[i % TEST_DOMAINS]) !=
+          records[i % TEST_DOMAINS])
+    {
+      puts("Error getting the records.");
+      return EXIT_FAILURE;
+    }
+  }
+  for (size_t i = 0; i < TEST_DOMAINS; i++)
+  {
+    GenUtils_EpochDestroy(domains[i]);
+  }
+  puts("Retiring objects...");
+  GenUtils_EpochEnter(thread);
+  GenUtils_EpochRetire(thread, &CreateObject()->entry,
+    Release, NULL);
+  GenUtils_EpochCollect(thread);
+  GenUtils_EpochExit(thread);
+  if (atomic_load(&released) != 0)
+  {
+    puts("Error, an object was released too soon.");
+    GenUtils_EpochDestroy(epoch);
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < 3; i++)
+  {
+    GenUtils_EpochCollect(thread);
+  }
+  if (atomic_load(&released) != 1)
+  {
+    puts("Error collecting the objects.");
+    GenUtils_EpochDestroy(epoch);
+    return EXIT_FAILURE;
+  }
+  puts("Collecting while only reading...");
+  GenUtils_EpochEnter(thread);
+  GenUtils_EpochRetire(thread, &CreateObject()->entry,
+    Release, NULL);
+  GenUtils_EpochExit(thread);
+  for (size_t i = 0; i < GENUTILS_EPOCH_BATCH; i++)
+  {
+    GenUtils_EpochEnter(thread);
+    GenUtils_EpochExit(thread);
+  }
+  if (atomic_load(&released) != 2)
+  {
+    puts("Error collecting the objects.");
+    GenUtils_EpochDestroy(epoch);
+    return EXIT_FAILURE;
+  }
+  puts("Exiting inside a critical section...");
+  if (pthread_create(
+        &threads[0], NULL, ExitInside, NULL) != 0)
+  {
+    puts("Error creating the threads.");
+    return EXIT_FAILURE;
+  }
+  pthread_join(threads[0], &exited);
+  thread = exited;
+  if (thread == NULL || atomic_load(&thread->used) ||
+      atomic_load(&thread->owner) != NULL)
+  {
+    puts("Error, the record of the thread is still used.");
+    GenUtils_EpochDestroy(epoch);
+    return EXIT_FAILURE;
+  }
+  // The epoch still advances.
+  thread = GenUtils_EpochGetThread(epoch);
+  GenUtils_EpochEnter(thread);
+  GenUtils_EpochRetire(thread, &CreateObject()->entry,
+    Release, NULL);
+  GenUtils_EpochExit(thread);
+  for (size_t i = 0; i < 3; i++)
+  {
+    GenUtils_EpochCollect(thread);
+  }
+  if (atomic_load(&released) != 3)
+  {
+    puts("Error collecting the objects.");
+    GenUtils_EpochDestroy(epoch);
+    return EXIT_FAILURE;
+  }
+  puts("Replacing objects read by several threads...");
+  atomic_store(&shared, CreateObject());
+  for (size_t i = 0; i < TEST_READERS; i++)
+  {
+    if (pthread_create(&threads[i], NULL, Read, NULL) != 0)
+    {
+      puts("Error creating the threads.");
+      return EXIT_FAILURE;
+    }
+  }
+  for (size_t i = 0; i < TEST_SIZE; i++)
+  {
+    GenUtils_EpochEnter(thread);
+    object = atomic_exchange(&shared, CreateObject());
+    GenUtils_EpochRetire(
+      thread, &object->entry, Release, NULL);
+    GenUtils_EpochExit(thread);
+  }
+  atomic_store(&done, true);
+  for (size_t i = 0; i < TEST_READERS; i++)
+  {
+    pthread_join(threads[i], NULL);
+  }
+  if (atomic_load(&released) <= 1)
+  {
+    puts("Error, the objects were not released.");
+    GenUtils_EpochDestroy(epoch);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying domain...");
+  GenUtils_EpochDestroy(epoch);
+  free(atomic_load(&shared));
+  if (atomic_load(&released) != TEST_SIZE + 3)
+  {
+    puts("Error, the objects were not released.");
+    return EXIT_FAILURE;
+  }
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,98 @@
+/// @file FrozenMap.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a frozen map.
+#include "TestUtils.h"
+#include <GenUtils/FrozenMap.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Number of keys.
+#define TEST_SIZE 10000
+
+/// @brief The keys of the map, with long common prefixes.
+static char keys[TEST_SIZE][32];
+
+int main(void)
+{
+  GenUtils_BinaryTree *tree = GenUtils_BinaryTreeCreate();
+  GenUtils_FrozenMap *frozenMap = NULL;
+  GenUtils_BinaryTreeKeyValue keyValue;
+  const char *previous = NULL;
+  size_t count = 0;
+  puts("Test for the implementation of a frozen map.");
+  puts("Creating an empty frozen map...");
+  frozenMap = GenUtils_FrozenMapCreate(tree);
+  if (!GenUtils_FrozenMapWasInit(frozenMap) ||
+      !GenUtils_FrozenMapEmpty(frozenMap) ||
+      GenUtils_FrozenMapExist(frozenMap, "a"))
+  {
+    puts("Error creating the frozen map.");
+    return EXIT_FAILURE;
+  }
+  GenUtils_FrozenMapDestroy(frozenMap);
+  puts("Creating the test frozen map...");
+  for (uintptr_t i = 0; i < TEST_SIZE; i++)
+  {
+    // Half of the keys are shorter than the prefixes, and
+    // the other half only differ after them.
+    if (i % 2 == 0)
+    {
+      snprintf(keys[i], sizeof(keys[i]), "%zu", (size_t)i);
+    }
+    else
+    {
+      snprintf(keys[i], sizeof(keys[i]),
+        "common-prefix/%zu", (size_t)i);
+    }
+    keyValue.key = keys[i];
+    keyValue.value = (void *)(i + 1);
+    GenUtils_BinaryTreeInsert(tree, keyValue);
+  }
+  frozenMap = GenUtils_FrozenMapCreate(tree);
+  GenUtils_BinaryTreeDestroy(tree);
+  if (!GenUtils_FrozenMapWasInit(frozenMap) ||
+      GenUtils_FrozenMapGetSize(frozenMap) != TEST_SIZE)
+  {
+    puts("Error creating the frozen map.");
+    return EXIT_FAILURE;
+  }
+  puts("Searching elements...");
+  for (uintptr_t i = 0; i < TEST_SIZE; i++)
+  {
+    if ((uintptr_t)GenUtils_FrozenMapGet(
+          frozenMap, keys[i]) != i + 1)
+    {
+      puts("Error getting elements.");
+      GenUtils_FrozenMapDestroy(frozenMap);
+      return EXIT_FAILURE;
+    }
+  }
+  if (GenUtils_FrozenMapExist(frozenMap, "") ||
+      GenUtils_FrozenMapExist(frozenMap, "common-") ||
+      GenUtils_FrozenMapExist(frozenMap, "common-prefix") ||
+      GenUtils_FrozenMapExist(
+        frozenMap, "common-prefix/0") ||
+      GenUtils_FrozenMapExist(frozenMap, "99999") ||
+      GenUtils_FrozenMapExist(frozenMap, "~"))
+  {
+    puts("Error, found keys that don't exist.");
+    GenUtils_FrozenMapDestroy(frozenMap);
+    return EXIT_FAILURE;
+  }
+  puts("Iterating in order...");
+  GenUtils_FrozenMapInorder(
+    frozenMap, &previous, CheckOrder);
+  GenUtils_FrozenMapInorder(frozenMap, &count, Count);
+  if (count != TEST_SIZE)
+  {
+    puts("Error iterating the frozen map.");
+    GenUtils_FrozenMapDestroy(frozenMap);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying frozen map...");
+  GenUtils_FrozenMapDestroy(frozenMap);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/// @file HashMap.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a hash map.
+#include <GenUtils/HashMap.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Number of elements used in the test.
+#define TEST_SIZE 1000
+
+/// @brief Count the elements of a hash map.
+/// @param keyValue The current pair.
+/// @param extradata Pointer to the counter.
+static void CountPair(
+  const GenUtils_BinaryTreeKeyValue *keyValue,
+  void *extradata)
+{
+  (void)keyValue;
+  *(size_t *)extradata += 1;
+}
+
+int main(void)
+{
+  GenUtils_HashMap *hashMap = NULL;
+  static char keys[TEST_SIZE][16];
+  static int values[TEST_SIZE];
+  GenUtils_BinaryTreeKeyValue keyValue;
+  size_t count = 0;
+  puts("Test for the implementation of a hash map.");
+  puts("Creating the test hash map...");
+  hashMap = GenUtils_HashMapCreate();
+  if (!GenUtils_HashMapWasInit(hashMap))
+  {
+    puts("Error creating the hash map.");
+    return EXIT_FAILURE;
+  }
+  puts("Inserting elements...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    snprintf(keys[i], sizeof(keys[i]), "key%d", i);
+    values[i] = i;
+    keyValue.key = keys[i];
+    keyValue.value = &values[i];
+    if (!GenUtils_HashMapInsert(hashMap, keyValue))
+    {
+      puts("Error inserting elements.");
+      GenUtils_HashMapDestroy(hashMap);
+      return EXIT_FAILURE;
+    }
+  }
+  keyValue.key = keys[0];
+  if (GenUtils_HashMapInsert(hashMap, keyValue) ||
+      GenUtils_HashMapGetSize(hashMap) != TEST_SIZE)
+  {
+    puts("Error, a key was inserted twice.");
+    GenUtils_HashMapDestroy(hashMap);
+    return EXIT_FAILURE;
+  }
+  puts("Getting and setting elements...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    if (GenUtils_HashMapGet(hashMap, keys[i]) != &values[i])
+    {
+      puts("Error getting elements.");
+      GenUtils_HashMapDestroy(hashMap);
+      return EXIT_FAILURE;
+    }
+  }
+  keyValue.key = keys[1];
+  keyValue.value = &values[2];
+  if (!GenUtils_HashMapSet(hashMap, keyValue) ||
+      GenUtils_HashMapGet(hashMap, keys[1]) != &values[2])
+  {
+    puts("Error setting an element.");
+    GenUtils_HashMapDestroy(hashMap);
+    return EXIT_FAILURE;
+  }
+  puts("Removing the odd elements...");
+  for (int i = 1; i < TEST_SIZE; i += 2)
+  {
+    if (!GenUtils_HashMapRemoveBool(hashMap, keys[i]))
+    {
+      puts("Error removing elements.");
+      GenUtils_HashMapDestroy(hashMap);
+      return EXIT_FAILURE;
+    }
+  }
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    if (GenUtils_HashMapExist(hashMap, keys[i]) !=
+        (i % 2 == 0))
+    {
+      puts("Error, a removed key still exists.");
+      GenUtils_HashMapDestroy(hashMap);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Rehashing the hash map...");
+  if (!GenUtils_HashMapRehash(hashMap, 0) ||
+      !GenUtils_HashMapReserve(hashMap, TEST_SIZE * 4))
+  {
+    puts("Error rehashing the hash map.");
+    GenUtils_HashMapDestroy(hashMap);
+    return EXIT_FAILURE;
+  }
+  GenUtils_HashMapIterate(hashMap, &count, CountPair);
+  if (count != TEST_SIZE / 2 ||
+      GenUtils_HashMapGet(hashMap, keys[2]) != &values[2])
+  {
+    puts("Error, elements were lost while rehashing.");
+    GenUtils_HashMapDestroy(hashMap);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying hash map...");
+  GenUtils_HashMapDestroy(hashMap);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
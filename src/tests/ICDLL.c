@@ -0,0 +1,115 @@
+/// @file ICDLL.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of an intrusive CDLL.
+#include <GenUtils/ICDLL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Number of elements used in the test.
+#define TEST_SIZE 100
+
+/// @brief An object that can be stored in the list.
+typedef struct Task
+{
+  /// @brief Identifier of the task.
+  int id;
+  /// @brief The link of the task in the list.
+  GenUtils_DoubleLink link;
+} Task;
+
+/// @brief Add the identifiers of the tasks.
+/// @param link The link of the current task.
+/// @param extradata Pointer to the sum.
+static void SumTask(
+  GenUtils_DoubleLink *link, void *extradata)
+{
+  // The task of the link.
+  Task *task = GENUTILS_CONTAINER_OF(link, Task, link);
+  *(int *)extradata += task->id;
+}
+
+int main(void)
+{
+  GenUtils_ICDLL list;
+  static Task tasks[TEST_SIZE];
+  GenUtils_DoubleLink *link = NULL;
+  int expected = 0;
+  int sum = 0;
+  puts("Test for the implementation of an intrusive CDLL.");
+  puts("Initializing the test list...");
+  GenUtils_ICDLLInit(&list);
+  if (!GenUtils_ICDLLEmpty(&list))
+  {
+    puts("Error initializing the list.");
+    return EXIT_FAILURE;
+  }
+  puts("Pushing tasks at both ends...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    tasks[i].id = i;
+  }
+  for (int i = TEST_SIZE / 2; i < TEST_SIZE; i++)
+  {
+    GenUtils_ICDLLPushBack(&list, &tasks[i].link);
+  }
+  for (int i = TEST_SIZE / 2 - 1; i >= 0; i--)
+  {
+    GenUtils_ICDLLPushFront(&list, &tasks[i].link);
+  }
+  puts("Checking the order of the tasks...");
+  link = GenUtils_ICDLLBegin(&list);
+  while (link != NULL)
+  {
+    if (GENUTILS_CONTAINER_OF(link, Task, link)->id !=
+        expected)
+    {
+      puts("Error, the tasks are not in order.");
+      return EXIT_FAILURE;
+    }
+    expected++;
+    link = GenUtils_ICDLLNext(&list, link);
+  }
+  if (expected != TEST_SIZE ||
+      GenUtils_ICDLLGetSize(&list) != TEST_SIZE)
+  {
+    puts("Error, the list was not fully traversed.");
+    return EXIT_FAILURE;
+  }
+  puts("Removing the odd tasks...");
+  for (int i = 1; i < TEST_SIZE; i += 2)
+  {
+    GenUtils_ICDLLRemove(&list, &tasks[i].link);
+  }
+  GenUtils_ICDLLIterate(&list, &sum, SumTask);
+  if (GenUtils_ICDLLGetSize(&list) != TEST_SIZE / 2 ||
+      sum != (TEST_SIZE / 2) * (TEST_SIZE / 2 - 1))
+  {
+    puts("Error removing tasks.");
+    return EXIT_FAILURE;
+  }
+  puts("Popping tasks from both ends...");
+  for (int i = 0; i < TEST_SIZE / 2; i += 2)
+  {
+    link = GenUtils_ICDLLPopFront(&list);
+    if (GENUTILS_CONTAINER_OF(link, Task, link)->id != i)
+    {
+      puts("Error popping the head.");
+      return EXIT_FAILURE;
+    }
+    link = GenUtils_ICDLLPopBack(&list);
+    if (GENUTILS_CONTAINER_OF(link, Task, link)->id !=
+        TEST_SIZE - 2 - i)
+    {
+      puts("Error popping the tail.");
+      return EXIT_FAILURE;
+    }
+  }
+  if (!GenUtils_ICDLLEmpty(&list) ||
+      GenUtils_ICDLLPopFront(&list) != NULL)
+  {
+    puts("Error, the list is not empty.");
+    return EXIT_FAILURE;
+  }
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/// @file ICSLL.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of an intrusive CSLL.
+#include <GenUtils/ICSLL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Number of elements used in the test.
+#define TEST_SIZE 100
+
+/// @brief An object that can be stored in the list.
+typedef struct Task
+{
+  /// @brief Identifier of the task.
+  int id;
+  /// @brief The link of the task in the list.
+  GenUtils_SingleLink link;
+} Task;
+
+/// @brief Add the identifiers of the tasks.
+/// @param link The link of the current task.
+/// @param extradata Pointer to the sum.
+static void SumTask(
+  GenUtils_SingleLink *link, void *extradata)
+{
+  // The task of the link.
+  Task *task = GENUTILS_CONTAINER_OF(link, Task, link);
+  *(int *)extradata += task->id;
+}
+
+int main(void)
+{
+  GenUtils_ICSLL list;
+  static Task tasks[TEST_SIZE];
+  GenUtils_SingleLink *link = NULL;
+  int expected = 0;
+  int sum = 0;
+  puts("Test for the implementation of an intrusive CSLL.");
+  puts("Initializing the test list...");
+  GenUtils_ICSLLInit(&list);
+  if (!GenUtils_ICSLLEmpty(&list))
+  {
+    puts("Error initializing the list.");
+    return EXIT_FAILURE;
+  }
+  puts("Pushing tasks at both ends...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    tasks[i].id = i;
+  }
+  for (int i = TEST_SIZE / 2; i < TEST_SIZE; i++)
+  {
+    GenUtils_ICSLLPushBack(&list, &tasks[i].link);
+  }
+  for (int i = TEST_SIZE / 2 - 1; i >= 0; i--)
+  {
+    GenUtils_ICSLLPushFront(&list, &tasks[i].link);
+  }
+  puts("Checking the order of the tasks...");
+  link = GenUtils_ICSLLBegin(&list);
+  while (link != NULL)
+  {
+    if (GENUTILS_CONTAINER_OF(link, Task, link)->id !=
+        expected)
+    {
+      puts("Error, the tasks are not in order.");
+      return EXIT_FAILURE;
+    }
+    expected++;
+    link = GenUtils_ICSLLNext(&list, link);
+  }
+  if (expected != TEST_SIZE ||
+      GenUtils_ICSLLGetSize(&list) != TEST_SIZE)
+  {
+    puts("Error, the list was not fully traversed.");
+    return EXIT_FAILURE;
+  }
+  puts("Removing the odd tasks...");
+  for (int i = 1; i < TEST_SIZE; i += 2)
+  {
+    GenUtils_ICSLLRemove(&list, &tasks[i].link);
+  }
+  GenUtils_ICSLLIterate(&list, &sum, SumTask);
+  if (GenUtils_ICSLLGetSize(&list) != TEST_SIZE / 2 ||
+      sum != (TEST_SIZE / 2) * (TEST_SIZE / 2 - 1))
+  {
+    puts("Error removing tasks.");
+    return EXIT_FAILURE;
+  }
+  puts("Popping tasks from both ends...");
+  for (int i = 0; i < TEST_SIZE / 2; i += 2)
+  {
+    link = GenUtils_ICSLLPopFront(&list);
+    if (GENUTILS_CONTAINER_OF(link, Task, link)->id != i)
+    {
+      puts("Error popping the head.");
+      return EXIT_FAILURE;
+    }
+    link = GenUtils_ICSLLPopBack(&list);
+    if (GENUTILS_CONTAINER_OF(link, Task, link)->id !=
+        TEST_SIZE - 2 - i)
+    {
+      puts("Error popping the tail.");
+      return EXIT_FAILURE;
+    }
+  }
+  if (!GenUtils_ICSLLEmpty(&list) ||
+      GenUtils_ICSLLPopFront(&list) != NULL)
+  {
+    puts("Error, the list is not empty.");
+    return EXIT_FAILURE;
+  }
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,240 @@
+/// @file MPSCQueue.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a MPSC queue.
+#include <GenUtils/MPSCQueue.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Number of producer threads.
+#define TEST_PRODUCERS 4
+/// @brief Number of elements pushed by every producer.
+#define TEST_SIZE 100000
+/// @brief Number of nodes owned by the test.
+#define TEST_NODES 64
+
+/// @brief The queue used by all the threads.
+static GenUtils_MPSCQueue *queue = NULL;
+
+/// @brief Push TEST_SIZE elements, encoding the producer
+/// and the order in the data.
+/// @param argument The number of the producer.
+/// @return NULL.
+static void *Produce(void *argument)
+{
+  uintptr_t producer = (uintptr_t)argument;
+  for (uintptr_t i = 1; i <= TEST_SIZE; i++)
+  {
+    while (!GenUtils_MPSCQueuePush(
+      queue, (void *)(producer * (TEST_SIZE + 1) + i)))
+    {
+    }
+  }
+  return NULL;
+}
+
+/// @brief Check that the elements of every producer come
+/// in order.
+/// @param userdata The popped element.
+/// @param extradata The last element of every producer.
+static void Consume(void *userdata, void *extradata)
+{
+  uintptr_t *last = extradata;
+  uintptr_t value = (uintptr_t)userdata;
+  uintptr_t producer = value / (TEST_SIZE + 1);
+  uintptr_t order = value % (TEST_SIZE + 1);
+  if (order != last[producer] + 1)
+  {
+    puts("Error, the elements are not in order.");
+    exit(EXIT_FAILURE);
+  }
+  last[producer] = order;
+}
+
+/// @brief Check that the elements come in order when the
+/// nodes of the caller and of the queue are mixed.
+/// @param userdata The popped element.
+/// @param extradata The last element.
+static void ConsumeMixed(void *userdata, void *extradata)
+{
+  uintptr_t *last = extradata;
+  if ((uintptr_t)userdata != *last + 1)
+  {
+    puts("Error, the elements are not in order.");
+    exit(EXIT_FAILURE);
+  }
+  *last = (uintptr_t)userdata;
+}
+
+int main(void)
+{
+  pthread_t threads[TEST_PRODUCERS];
+  GenUtils_SingleNode nodes[TEST_NODES];
+  GenUtils_SingleNode *popped[TEST_NODES];
+  bool owned[TEST_NODES];
+  uintptr_t mixed = 0;
+  uintptr_t last[TEST_PRODUCERS] = {0};
+  size_t count = 0;
+  puts("Test for the implementation of a MPSC queue.");
+  puts("Creating the test queue...");
+  queue = GenUtils_MPSCQueueCreate();
+  if (!GenUtils_MPSCQueueWasInit(queue) ||
+      !GenUtils_MPSCQueueEmpty(queue))
+  {
+    puts("Error creating the queue.");
+    return EXIT_FAILURE;
+  }
+  puts("Pushing from several threads...");
+  for (uintptr_t i = 0; i < TEST_PRODUCERS; i++)
+  {
+    if (pthread_create(
+          &threads[i], NULL, Produce, (void *)i) != 0)
+    {
+      puts("Error creating the threads.");
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Draining in batches...");
+  while (count < TEST_PRODUCERS * TEST_SIZE)
+  {
+    count +=
+      GenUtils_MPSCQueueDrain(queue, 64, last, Consume);
+  }
+  for (size_t i = 0; i < TEST_PRODUCERS; i++)
+  {
+    pthread_join(threads[i], NULL);
+  }
+  if (!GenUtils_MPSCQueueEmpty(queue) ||
+      GenUtils_MPSCQueuePopBool(queue))
+  {
+    puts("Error, the queue is not empty.");
+    GenUtils_MPSCQueueDestroy(queue);
+    return EXIT_FAILURE;
+  }
+  puts("Mixing nodes of the caller and of the queue...");
+  for (uintptr_t i = 0; i < TEST_NODES; i++)
+  {
+    nodes[i].userdata = (void *)(2 * i + 1);
+    GenUtils_MPSCQueuePushNode(queue, &nodes[i]);
+    if (!GenUtils_MPSCQueuePush(
+          queue, (void *)(2 * i + 2)))
+    {
+      puts("Error pushing the elements.");
+      GenUtils_MPSCQueueDestroy(queue);
+      return EXIT_FAILURE;
+    }
+  }
+  // Pop, PopBool and Drain only release the nodes of the
+  // queue, the nodes of the caller stay in the array.
+  for (uintptr_t i = 1; i <= TEST_NODES / 2; i++)
+  {
+    if (GenUtils_MPSCQueuePop(queue) != (void *)i)
+    {
+      puts("Error popping the elements.");
+      GenUtils_MPSCQueueDestroy(queue);
+      return EXIT_FAILURE;
+    }
+  }
+  for (size_t i = 0; i < TEST_NODES / 2; i++)
+  {
+    if (!GenUtils_MPSCQueuePopBool(queue))
+    {
+      puts("Error popping the elements.");
+      GenUtils_MPSCQueueDestroy(queue);
+      return EXIT_FAILURE;
+    }
+  }
+  mixed = TEST_NODES;
+  if (GenUtils_MPSCQueueDrain(
+        queue, 0, &mixed, ConsumeMixed) != TEST_NODES ||
+      mixed != 2 * TEST_NODES)
+  {
+    puts("Error draining the elements.");
+    GenUtils_MPSCQueueDestroy(queue);
+    return EXIT_FAILURE;
+  }
+  for (uintptr_t i = 0; i < TEST_NODES; i++)
+  {
+    if (nodes[i].userdata != (void *)(2 * i + 1))
+    {
+      puts("Error, a node of the caller was changed.");
+      GenUtils_MPSCQueueDestroy(queue);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Popping the nodes with their owner...");
+  for (uintptr_t i = 0; i < TEST_NODES / 2; i++)
+  {
+    GenUtils_MPSCQueuePushNode(queue, &nodes[i]);
+    if (!GenUtils_MPSCQueuePush(
+          queue, (void *)(2 * i + 2)))
+    {
+      puts("Error pushing the elements.");
+      GenUtils_MPSCQueueDestroy(queue);
+      return EXIT_FAILURE;
+    }
+  }
+  // PopNode and DrainNodes tell which nodes the caller has
+  // to release with the allocator of the queue.
+  for (uintptr_t i = 0; i < TEST_NODES / 2; i++)
+  {
+    bool isOwned = true;
+    GenUtils_SingleNode *node =
+      GenUtils_MPSCQueuePopNode(queue, &isOwned);
+    if (node == NULL || isOwned != (i % 2 == 1) ||
+        node->userdata != (void *)(i + 1))
+    {
+      puts("Error popping the nodes.");
+      GenUtils_MPSCQueueDestroy(queue);
+      return EXIT_FAILURE;
+    }
+    if (isOwned)
+    {
+      GenUtils_AllocatorFree(queue->allocator, node,
+                             sizeof(GenUtils_SingleNode));
+    }
+  }
+  count = GenUtils_MPSCQueueDrainNodes(
+    queue, popped, owned, TEST_NODES);
+  for (uintptr_t i = 0; i < count; i++)
+  {
+    uintptr_t order = TEST_NODES / 2 + i;
+    if (owned[i] != (order % 2 == 1) ||
+        popped[i]->userdata != (void *)(order + 1))
+    {
+      puts("Error draining the nodes.");
+      GenUtils_MPSCQueueDestroy(queue);
+      return EXIT_FAILURE;
+    }
+    if (owned[i])
+    {
+      GenUtils_AllocatorFree(queue->allocator, popped[i],
+                             sizeof(GenUtils_SingleNode));
+    }
+  }
+  GenUtils_MPSCQueuePushNode(queue, &nodes[0]);
+  if (count != TEST_NODES / 2 ||
+      GenUtils_MPSCQueueDrainNodes(
+        queue, popped, NULL, TEST_NODES) != 1 ||
+      popped[0] != &nodes[0] ||
+      !GenUtils_MPSCQueueEmpty(queue))
+  {
+    puts("Error draining the nodes.");
+    GenUtils_MPSCQueueDestroy(queue);
+    return EXIT_FAILURE;
+  }
+  // The queue leaves the nodes of the caller it still has.
+  GenUtils_MPSCQueuePushNode(queue, &nodes[0]);
+  if (!GenUtils_MPSCQueuePush(queue, NULL))
+  {
+    puts("Error pushing the elements.");
+    GenUtils_MPSCQueueDestroy(queue);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying queue...");
+  GenUtils_MPSCQueueDestroy(queue);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
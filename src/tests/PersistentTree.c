@@ -0,0 +1,162 @@
+/// @file PersistentTree.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a persistent
+/// binary tree.
+#include "TestUtils.h"
+#include <GenUtils/PersistentTree.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Number of keys.
+#define TEST_SIZE 20000
+
+/// @brief The keys of the tree.
+static char keys[TEST_SIZE][16];
+
+/// @brief Check a snapshot with all the keys and the
+/// first values, and destroy it.
+/// @param argument The snapshot.
+/// @return NULL.
+static void *ReadSnapshot(void *argument)
+{
+  GenUtils_PersistentTree *snapshot = argument;
+  const char *previous = NULL;
+  for (uintptr_t i = 0; i < TEST_SIZE; i++)
+  {
+    if ((uintptr_t)GenUtils_PersistentTreeGet(
+          snapshot, keys[i]) != i + 1)
+    {
+      puts("Error, the snapshot changed.");
+      exit(EXIT_FAILURE);
+    }
+  }
+  GenUtils_PersistentTreeInorder(
+    snapshot, &previous, CheckOrder);
+  GenUtils_PersistentTreeDestroy(snapshot);
+  return NULL;
+}
+
+int main(void)
+{
+  pthread_t thread;
+  GenUtils_PersistentTree *tree = NULL;
+  GenUtils_PersistentTree *snapshot = NULL;
+  GenUtils_BinaryTreeKeyValue keyValue = {"b", "B"};
+  const char *previous = NULL;
+  puts("Test for the implementation of a persistent binary "
+       "tree.");
+  puts("Creating the test tree...");
+  tree = GenUtils_PersistentTreeCreate();
+  if (!GenUtils_PersistentTreeWasInit(tree) ||
+      !GenUtils_PersistentTreeEmpty(tree))
+  {
+    puts("Error creating the tree.");
+    return EXIT_FAILURE;
+  }
+  puts("Inserting, setting and removing elements...");
+  if (!GenUtils_PersistentTreeInsert(tree, keyValue) ||
+      GenUtils_PersistentTreeInsert(tree, keyValue))
+  {
+    puts("Error inserting elements.");
+    GenUtils_PersistentTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  snapshot = GenUtils_PersistentTreeSnapshot(tree);
+  keyValue.value = "Z";
+  if (snapshot == NULL ||
+      !GenUtils_PersistentTreeSet(tree, keyValue) ||
+      strcmp(GenUtils_PersistentTreeGet(tree, "b"), "Z") !=
+        0 ||
+      strcmp(GenUtils_PersistentTreeGet(snapshot, "b"),
+        "B") != 0)
+  {
+    puts("Error setting elements.");
+    GenUtils_PersistentTreeDestroy(snapshot);
+    GenUtils_PersistentTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  if (strcmp(GenUtils_PersistentTreeRemove(tree, "b"),
+        "Z") != 0 ||
+      GenUtils_PersistentTreeRemoveBool(tree, "b") ||
+      !GenUtils_PersistentTreeEmpty(tree) ||
+      !GenUtils_PersistentTreeExist(snapshot, "b"))
+  {
+    puts("Error removing elements.");
+    GenUtils_PersistentTreeDestroy(snapshot);
+    GenUtils_PersistentTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  GenUtils_PersistentTreeDestroy(snapshot);
+  puts("Inserting many elements...");
+  for (uintptr_t i = 0; i < TEST_SIZE; i++)
+  {
+    // Insert the keys out of order.
+    uintptr_t j = i * 7919 % TEST_SIZE;
+    snprintf(keys[j], sizeof(keys[j]), "key%08zu",
+      (size_t)j);
+  }
+  for (uintptr_t i = 0; i < TEST_SIZE; i++)
+  {
+    uintptr_t j = i * 7919 % TEST_SIZE;
+    keyValue.key = keys[j];
+    keyValue.value = (void *)(j + 1);
+    if (!GenUtils_PersistentTreeInsert(tree, keyValue))
+    {
+      puts("Error inserting elements.");
+      GenUtils_PersistentTreeDestroy(tree);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Changing the tree while a snapshot is read...");
+  snapshot = GenUtils_PersistentTreeSnapshot(tree);
+  if (snapshot == NULL ||
+      pthread_create(
+        &thread, NULL, ReadSnapshot, snapshot) != 0)
+  {
+    puts("Error creating the snapshot.");
+    return EXIT_FAILURE;
+  }
+  for (uintptr_t i = 0; i < TEST_SIZE; i++)
+  {
+    keyValue.key = keys[i];
+    keyValue.value = NULL;
+    if ((i % 2 == 1 &&
+          (uintptr_t)GenUtils_PersistentTreeRemove(
+            tree, keys[i]) != i + 1) ||
+        (i % 2 == 0 &&
+          !GenUtils_PersistentTreeSet(tree, keyValue)))
+    {
+      puts("Error changing the tree.");
+      exit(EXIT_FAILURE);
+    }
+  }
+  pthread_join(thread, NULL);
+  if (GenUtils_PersistentTreeGetSize(tree) !=
+        TEST_SIZE / 2 ||
+      GenUtils_PersistentTreeExist(tree, keys[1]) ||
+      !GenUtils_PersistentTreeExist(tree, keys[0]) ||
+      GenUtils_PersistentTreeGet(tree, keys[0]) != NULL)
+  {
+    puts("Error, wrong elements.");
+    GenUtils_PersistentTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  GenUtils_PersistentTreeInorder(
+    tree, &previous, CheckOrder);
+  puts("Clearing the tree...");
+  GenUtils_PersistentTreeClear(tree);
+  if (!GenUtils_PersistentTreeEmpty(tree) ||
+      GenUtils_PersistentTreeExist(tree, keys[0]))
+  {
+    puts("Error clearing the tree.");
+    GenUtils_PersistentTreeDestroy(tree);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying tree...");
+  GenUtils_PersistentTreeDestroy(tree);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+/// @file SPSCRing.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a SPSC ring.
+#include <GenUtils/SPSCRing.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Number of elements pushed by the producer.
+#define TEST_SIZE 1000000
+/// @brief Number of elements pushed or popped at once.
+#define TEST_BATCH 32
+
+/// @brief The ring used by both threads.
+static GenUtils_SPSCRing *ring = NULL;
+
+/// @brief Push TEST_SIZE elements in order, alternating
+/// single and batch pushes.
+/// @param argument Unused.
+/// @return NULL.
+static void *Produce(void *argument)
+{
+  void *batch[TEST_BATCH];
+  uintptr_t next = 1;
+  (void)argument;
+  while (next <= TEST_SIZE)
+  {
+    if (next % 2 == 0)
+    {
+      if (GenUtils_SPSCRingTryPush(ring, (void *)next))
+      {
+        next++;
+      }
+      else
+      {
+        sched_yield();
+      }
+      continue;
+    }
+    size_t count = 0;
+    while (count < TEST_BATCH && next + count <= TEST_SIZE)
+    {
+      batch[count] = (void *)(next + count);
+      count++;
+    }
+    count = GenUtils_SPSCRingTryPushN(ring, batch, count);
+    if (count == 0)
+    {
+      sched_yield();
+    }
+    next += count;
+  }
+  return NULL;
+}
+
+int main(void)
+{
+  pthread_t thread;
+  void *batch[TEST_BATCH];
+  void *userdata = NULL;
+  uintptr_t last = 0;
+  size_t count = 0;
+  puts("Test for the implementation of a SPSC ring.");
+  puts("Creating the test ring...");
+  ring = GenUtils_SPSCRingCreate(100);
+  if (!GenUtils_SPSCRingWasInit(ring) ||
+      !GenUtils_SPSCRingEmpty(ring) ||
+      GenUtils_SPSCRingGetCapacity(ring) != 128)
+  {
+    puts("Error creating the ring.");
+    return EXIT_FAILURE;
+  }
+  puts("Filling the ring...");
+  for (uintptr_t i = 1; i <= 128; i++)
+  {
+    if (!GenUtils_SPSCRingTryPush(ring, (void *)i))
+    {
+      puts("Error pushing elements.");
+      GenUtils_SPSCRingDestroy(ring);
+      return EXIT_FAILURE;
+    }
+  }
+  if (GenUtils_SPSCRingTryPush(ring, NULL) ||
+      GenUtils_SPSCRingGetSize(ring) != 128)
+  {
+    puts("Error, the ring is not full.");
+    GenUtils_SPSCRingDestroy(ring);
+    return EXIT_FAILURE;
+  }
+  puts("Emptying the ring...");
+  while ((count = GenUtils_SPSCRingTryPopN(
+            ring, batch, TEST_BATCH)) != 0)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      if ((uintptr_t)batch[i] != ++last)
+      {
+        puts("Error, the elements are not in order.");
+        GenUtils_SPSCRingDestroy(ring);
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (last != 128 || !GenUtils_SPSCRingEmpty(ring) ||
+      GenUtils_SPSCRingTryPop(ring, &userdata))
+  {
+    puts("Error, the ring is not empty.");
+    GenUtils_SPSCRingDestroy(ring);
+    return EXIT_FAILURE;
+  }
+  puts("Pushing and popping from two threads...");
+  if (pthread_create(&thread, NULL, Produce, NULL) != 0)
+  {
+    puts("Error creating the thread.");
+    GenUtils_SPSCRingDestroy(ring);
+    return EXIT_FAILURE;
+  }
+  last = 0;
+  while (last < TEST_SIZE)
+  {
+    if (last % 3 == 0)
+    {
+      if (!GenUtils_SPSCRingTryPop(ring, &userdata))
+      {
+        sched_yield();
+      }
+      else if ((uintptr_t)userdata != ++last)
+      {
+        puts("Error, the elements are not in order.");
+        exit(EXIT_FAILURE);
+      }
+      continue;
+    }
+    count = GenUtils_SPSCRingTryPopN(
+      ring, batch, TEST_BATCH);
+    if (count == 0)
+    {
+      sched_yield();
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+      if ((uintptr_t)batch[i] != ++last)
+      {
+        puts("Error, the elements are not in order.");
+        exit(EXIT_FAILURE);
+      }
+    }
+  }
+  pthread_join(thread, NULL);
+  if (!GenUtils_SPSCRingEmpty(ring))
+  {
+    puts("Error, the ring is not empty.");
+    GenUtils_SPSCRingDestroy(ring);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying ring...");
+  GenUtils_SPSCRingDestroy(ring);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
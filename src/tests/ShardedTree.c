@@ -0,0 +1,202 @@
+/// @file ShardedTree.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a sharded tree.
+#include "TestUtils.h"
+#include <GenUtils/ShardedTree.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Number of threads.
+#define TEST_THREADS 4
+/// @brief Number of keys of every thread.
+#define TEST_SIZE 20000
+
+/// @brief The keys of all the threads.
+static char keys[TEST_THREADS * TEST_SIZE][16];
+/// @brief The sharded tree used by all the threads.
+static GenUtils_ShardedTree *shardedTree = NULL;
+/// @brief Allocator of the sharded tree.
+static TestAllocator allocator;
+
+/// @brief Insert the keys of a thread, remove the odd ones
+/// and read the keys of the other threads, iterating in
+/// the middle.
+/// @param argument The number of the thread.
+/// @return NULL.
+static void *Work(void *argument)
+{
+  uintptr_t thread = (uintptr_t)argument;
+  GenUtils_BinaryTreeKeyValue keyValue;
+  const char *previous = NULL;
+  for (uintptr_t i = thread; i < TEST_THREADS * TEST_SIZE;
+       i += TEST_THREADS)
+  {
+    keyValue.key = keys[i];
+    keyValue.value = (void *)(i + 1);
+    if (!GenUtils_ShardedTreeInsert(shardedTree, keyValue))
+    {
+      puts("Error inserting elements.");
+      exit(EXIT_FAILURE);
+    }
+    // Read a key that another thread may be changing.
+    GenUtils_ShardedTreeGet(shardedTree,
+      keys[(i + 1) % (TEST_THREADS * TEST_SIZE)]);
+  }
+  // Iterate while the other threads are writing.
+  GenUtils_ShardedTreeInorder(
+    shardedTree, &previous, CheckOrder);
+  for (uintptr_t i = thread; i < TEST_THREADS * TEST_SIZE;
+       i += TEST_THREADS)
+  {
+    if ((uintptr_t)GenUtils_ShardedTreeGet(
+          shardedTree, keys[i]) != i + 1)
+    {
+      puts("Error getting elements.");
+      exit(EXIT_FAILURE);
+    }
+    if (i % 2 == 1 &&
+        (uintptr_t)GenUtils_ShardedTreeRemove(
+          shardedTree, keys[i]) != i + 1)
+    {
+      puts("Error removing elements.");
+      exit(EXIT_FAILURE);
+    }
+  }
+  return NULL;
+}
+
+int main(void)
+{
+  pthread_t threads[TEST_THREADS];
+  GenUtils_BinaryTreeKeyValue keyValue = {"b", "B"};
+  const char *previous = NULL;
+  size_t count = 0;
+  puts("Test for the implementation of a sharded tree.");
+  puts("Creating the test sharded tree...");
+  shardedTree = GenUtils_ShardedTreeCreate(5);
+  if (!GenUtils_ShardedTreeWasInit(shardedTree) ||
+      shardedTree->shardCount != 8 ||
+      !GenUtils_ShardedTreeEmpty(shardedTree))
+  {
+    puts("Error creating the sharded tree.");
+    return EXIT_FAILURE;
+  }
+  puts("Inserting, setting and removing elements...");
+  if (!GenUtils_ShardedTreeInsert(shardedTree, keyValue) ||
+      GenUtils_ShardedTreeInsert(shardedTree, keyValue))
+  {
+    puts("Error inserting elements.");
+    GenUtils_ShardedTreeDestroy(shardedTree);
+    return EXIT_FAILURE;
+  }
+  keyValue.key = "a";
+  keyValue.value = "A";
+  if (GenUtils_ShardedTreeSet(shardedTree, keyValue) ||
+      !GenUtils_ShardedTreeInsert(shardedTree, keyValue))
+  {
+    puts("Error setting elements.");
+    GenUtils_ShardedTreeDestroy(shardedTree);
+    return EXIT_FAILURE;
+  }
+  keyValue.value = "Z";
+  if (!GenUtils_ShardedTreeSet(shardedTree, keyValue) ||
+      strcmp(
+        GenUtils_ShardedTreeGet(shardedTree, "a"), "Z") !=
+        0 ||
+      GenUtils_ShardedTreeGetSize(shardedTree) != 2)
+  {
+    puts("Error getting elements.");
+    GenUtils_ShardedTreeDestroy(shardedTree);
+    return EXIT_FAILURE;
+  }
+  if (strcmp(GenUtils_ShardedTreeRemove(shardedTree, "b"),
+        "B") != 0 ||
+      GenUtils_ShardedTreeRemoveBool(shardedTree, "b") ||
+      GenUtils_ShardedTreeExist(shardedTree, "b") ||
+      !GenUtils_ShardedTreeExist(shardedTree, "a"))
+  {
+    puts("Error removing elements.");
+    GenUtils_ShardedTreeDestroy(shardedTree);
+    return EXIT_FAILURE;
+  }
+  GenUtils_ShardedTreeClear(shardedTree);
+  if (!GenUtils_ShardedTreeEmpty(shardedTree) ||
+      GenUtils_ShardedTreeExist(shardedTree, "a"))
+  {
+    puts("Error clearing the sharded tree.");
+    GenUtils_ShardedTreeDestroy(shardedTree);
+    return EXIT_FAILURE;
+  }
+  puts("Inserting and removing from several threads...");
+  for (size_t i = 0; i < TEST_THREADS * TEST_SIZE; i++)
+  {
+    snprintf(keys[i], sizeof(keys[i]), "key%08zu", i);
+  }
+  for (uintptr_t i = 0; i < TEST_THREADS; i++)
+  {
+    if (pthread_create(
+          &threads[i], NULL, Work, (void *)i) != 0)
+    {
+      puts("Error creating the threads.");
+      return EXIT_FAILURE;
+    }
+  }
+  for (size_t i = 0; i < TEST_THREADS; i++)
+  {
+    pthread_join(threads[i], NULL);
+  }
+  if (GenUtils_ShardedTreeGetSize(shardedTree) !=
+      TEST_THREADS * TEST_SIZE / 2)
+  {
+    puts("Error, wrong number of elements.");
+    GenUtils_ShardedTreeDestroy(shardedTree);
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < TEST_THREADS * TEST_SIZE; i++)
+  {
+    if (GenUtils_ShardedTreeExist(shardedTree, keys[i]) !=
+        (i % 2 == 0))
+    {
+      puts("Error, wrong elements.");
+      GenUtils_ShardedTreeDestroy(shardedTree);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Iterating in order...");
+  GenUtils_ShardedTreeInorder(
+    shardedTree, &previous, CheckOrder);
+  GenUtils_ShardedTreeInorder(shardedTree, &count, Count);
+  if (count != TEST_THREADS * TEST_SIZE / 2)
+  {
+    puts("Error iterating the sharded tree.");
+    GenUtils_ShardedTreeDestroy(shardedTree);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying sharded tree...");
+  GenUtils_ShardedTreeDestroy(shardedTree);
+  puts("Creating with an allocator that fails...");
+  shardedTree = NULL;
+  for (size_t limit = 1; shardedTree == NULL; limit++)
+  {
+    TestAllocatorInit(&allocator, true);
+    allocator.limit = limit;
+    shardedTree = GenUtils_ShardedTreeCreateWithAllocator(
+      4, &allocator.allocator);
+    if (shardedTree != NULL)
+    {
+      GenUtils_ShardedTreeDestroy(shardedTree);
+    }
+    else if (atomic_load(&allocator.resets) != 0 ||
+             TestAllocatorLeaks(&allocator))
+    {
+      puts("Error undoing a failed creation.");
+      return EXIT_FAILURE;
+    }
+    TestAllocatorDestroy(&allocator);
+  }
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
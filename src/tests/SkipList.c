@@ -0,0 +1,225 @@
+/// @file SkipList.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a skip list.
+#include "TestUtils.h"
+#include <GenUtils/SkipList.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Number of threads.
+#define TEST_THREADS 4
+/// @brief Number of keys of every thread.
+#define TEST_SIZE 20000
+
+/// @brief The keys of all the threads.
+static char keys[TEST_THREADS * TEST_SIZE][16];
+/// @brief The skip list used by all the threads.
+static GenUtils_SkipList *skipList = NULL;
+/// @brief Allocator that counts the released blocks.
+static TestAllocator allocator;
+
+/// @brief Insert the keys of a thread, remove the odd ones
+/// and read the keys of the other threads.
+/// @param argument The number of the thread.
+/// @return NULL.
+static void *Work(void *argument)
+{
+  uintptr_t thread = (uintptr_t)argument;
+  GenUtils_BinaryTreeKeyValue keyValue;
+  for (uintptr_t i = thread; i < TEST_THREADS * TEST_SIZE;
+       i += TEST_THREADS)
+  {
+    keyValue.key = keys[i];
+    keyValue.value = (void *)(i + 1);
+    if (!GenUtils_SkipListInsert(skipList, keyValue))
+    {
+      puts("Error inserting elements.");
+      exit(EXIT_FAILURE);
+    }
+    // Read a key that another thread may be changing.
+    GenUtils_SkipListGet(
+      skipList, keys[(i + 1) % (TEST_THREADS * TEST_SIZE)]);
+  }
+  for (uintptr_t i = thread; i < TEST_THREADS * TEST_SIZE;
+       i += TEST_THREADS)
+  {
+    if ((uintptr_t)GenUtils_SkipListGet(
+          skipList, keys[i]) != i + 1)
+    {
+      puts("Error getting elements.");
+      exit(EXIT_FAILURE);
+    }
+    if (i % 2 == 1 &&
+        (uintptr_t)GenUtils_SkipListRemove(
+          skipList, keys[i]) != i + 1)
+    {
+      puts("Error removing elements.");
+      exit(EXIT_FAILURE);
+    }
+  }
+  // Leave the removed nodes to the other threads.
+  GenUtils_SkipListUnregister(skipList);
+  return NULL;
+}
+
+int main(void)
+{
+  pthread_t threads[TEST_THREADS];
+  GenUtils_BinaryTreeKeyValue keyValue = {"b", "B"};
+  const char *previous = NULL;
+  size_t count = 0;
+  puts("Test for the implementation of a skip list.");
+  puts("Creating the test skip list...");
+  TestAllocatorInit(&allocator, false);
+  skipList = GenUtils_SkipListCreateWithAllocator(
+    &allocator.allocator);
+  if (!GenUtils_SkipListWasInit(skipList) ||
+      !GenUtils_SkipListEmpty(skipList))
+  {
+    puts("Error creating the skip list.");
+    return EXIT_FAILURE;
+  }
+  puts("Inserting, setting and removing elements...");
+  if (!GenUtils_SkipListInsert(skipList, keyValue) ||
+      GenUtils_SkipListInsert(skipList, keyValue))
+  {
+    puts("Error inserting elements.");
+    GenUtils_SkipListDestroy(skipList);
+    return EXIT_FAILURE;
+  }
+  keyValue.key = "a";
+  keyValue.value = "A";
+  if (GenUtils_SkipListSet(skipList, keyValue) ||
+      !GenUtils_SkipListInsert(skipList, keyValue))
+  {
+    puts("Error setting elements.");
+    GenUtils_SkipListDestroy(skipList);
+    return EXIT_FAILURE;
+  }
+  keyValue.value = "Z";
+  if (!GenUtils_SkipListSet(skipList, keyValue) ||
+      strcmp(GenUtils_SkipListGet(skipList, "a"), "Z") !=
+        0 ||
+      GenUtils_SkipListGetSize(skipList) != 2)
+  {
+    puts("Error getting elements.");
+    GenUtils_SkipListDestroy(skipList);
+    return EXIT_FAILURE;
+  }
+  if (strcmp(GenUtils_SkipListRemove(skipList, "b"), "B") !=
+        0 ||
+      GenUtils_SkipListRemoveBool(skipList, "b") ||
+      GenUtils_SkipListExist(skipList, "b") ||
+      !GenUtils_SkipListExist(skipList, "a"))
+  {
+    puts("Error removing elements.");
+    GenUtils_SkipListDestroy(skipList);
+    return EXIT_FAILURE;
+  }
+  GenUtils_SkipListClear(skipList);
+  if (!GenUtils_SkipListEmpty(skipList) ||
+      GenUtils_SkipListExist(skipList, "a"))
+  {
+    puts("Error clearing the skip list.");
+    GenUtils_SkipListDestroy(skipList);
+    return EXIT_FAILURE;
+  }
+  atomic_store(&allocator.released, 0);
+  puts("Inserting and removing from several threads...");
+  for (size_t i = 0; i < TEST_THREADS * TEST_SIZE; i++)
+  {
+    snprintf(keys[i], sizeof(keys[i]), "key%08zu", i);
+  }
+  for (uintptr_t i = 0; i < TEST_THREADS; i++)
+  {
+    if (pthread_create(
+          &threads[i], NULL, Work, (void *)i) != 0)
+    {
+      puts("Error creating the threads.");
+      return EXIT_FAILURE;
+    }
+  }
+  for (size_t i = 0; i < TEST_THREADS; i++)
+  {
+    pthread_join(threads[i], NULL);
+  }
+  if (GenUtils_SkipListGetSize(skipList) !=
+      TEST_THREADS * TEST_SIZE / 2)
+  {
+    puts("Error, wrong number of elements.");
+    GenUtils_SkipListDestroy(skipList);
+    return EXIT_FAILURE;
+  }
+  puts("Collecting the removed nodes...");
+  GenUtils_SkipListCollect(skipList);
+  if (atomic_load(&allocator.released) !=
+      TEST_THREADS * TEST_SIZE / 2)
+  {
+    puts("Error, the removed nodes were not released.");
+    GenUtils_SkipListDestroy(skipList);
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < TEST_THREADS * TEST_SIZE; i++)
+  {
+    if (GenUtils_SkipListExist(skipList, keys[i]) !=
+        (i % 2 == 0))
+    {
+      puts("Error, wrong elements.");
+      GenUtils_SkipListDestroy(skipList);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Iterating in order...");
+  GenUtils_SkipListInorder(skipList, &previous, CheckOrder);
+  GenUtils_SkipListInorder(skipList, &count, Count);
+  if (count != TEST_THREADS * TEST_SIZE / 2)
+  {
+    puts("Error iterating the skip list.");
+    GenUtils_SkipListDestroy(skipList);
+    return EXIT_FAILURE;
+  }
+  puts("Iterating a range...");
+  count = 0;
+  GenUtils_SkipListRange(
+    skipList, "key00000100", "key00000200", &count, Count);
+  if (count != 50)
+  {
+    puts("Error iterating a range.");
+    GenUtils_SkipListDestroy(skipList);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying skip list...");
+  GenUtils_SkipListDestroy(skipList);
+  if (TestAllocatorLeaks(&allocator))
+  {
+    puts("Error, some memory was not released.");
+    return EXIT_FAILURE;
+  }
+  TestAllocatorDestroy(&allocator);
+  puts("Creating with an allocator that fails...");
+  skipList = NULL;
+  for (size_t limit = 1; skipList == NULL; limit++)
+  {
+    TestAllocatorInit(&allocator, true);
+    allocator.limit = limit;
+    skipList = GenUtils_SkipListCreateWithAllocator(
+      &allocator.allocator);
+    if (skipList != NULL)
+    {
+      GenUtils_SkipListDestroy(skipList);
+    }
+    else if (atomic_load(&allocator.resets) != 0 ||
+             TestAllocatorLeaks(&allocator))
+    {
+      puts("Error undoing a failed creation.");
+      return EXIT_FAILURE;
+    }
+    TestAllocatorDestroy(&allocator);
+  }
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
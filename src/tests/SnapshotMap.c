@@ -0,0 +1,210 @@
+/// @file SnapshotMap.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a read-copy-update
+/// map.
+#include "TestUtils.h"
+#include <GenUtils/SnapshotMap.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Number of reader threads.
+#define TEST_READERS 3
+/// @brief Number of keys of every version.
+#define TEST_SIZE 1000
+/// @brief Number of versions published.
+#define TEST_VERSIONS 2000
+
+/// @brief The keys of the versions.
+static char keys[TEST_SIZE][16];
+/// @brief The snapshot map used by all the threads.
+static GenUtils_SnapshotMap *snapshotMap = NULL;
+/// @brief Set when the writer ends.
+static _Atomic bool done = false;
+/// @brief Allocator that counts the released blocks.
+static TestAllocator allocator;
+
+/// @brief Read versions until the writer ends, checking
+/// that all the values of a version are the same.
+/// @param argument Not used.
+/// @return NULL.
+static void *Read(void *argument)
+{
+  const GenUtils_SnapshotMapVersion *version = NULL;
+  void *value = NULL;
+  (void)argument;
+  while (!atomic_load(&done))
+  {
+    version = GenUtils_SnapshotMapAcquire(snapshotMap);
+    if (version == NULL)
+    {
+      puts("Error reading versions.");
+      exit(EXIT_FAILURE);
+    }
+    value =
+      GenUtils_SnapshotMapVersionGet(version, keys[0]);
+    for (size_t i = 0; i < version->size; i++)
+    {
+      if (GenUtils_SnapshotMapVersionGet(
+            version, keys[i]) != value)
+      {
+        puts("Error, a version changed while read.");
+        exit(EXIT_FAILURE);
+      }
+    }
+    GenUtils_SnapshotMapRelease(snapshotMap);
+    // Let the writer run on a single processor.
+    sched_yield();
+  }
+  return NULL;
+}
+
+int main(void)
+{
+  pthread_t threads[TEST_READERS];
+  GenUtils_BinaryTree *tree = NULL;
+  GenUtils_BinaryTreeKeyValue keyValue = {"b", "B"};
+  size_t count = 0;
+  puts("Test for the implementation of a read-copy-update "
+       "map.");
+  puts("Creating the test snapshot map...");
+  TestAllocatorInit(&allocator, false);
+  snapshotMap = GenUtils_SnapshotMapCreateWithAllocator(
+    &allocator.allocator);
+  tree = GenUtils_BinaryTreeCreate();
+  if (!GenUtils_SnapshotMapWasInit(snapshotMap) ||
+      !GenUtils_SnapshotMapEmpty(snapshotMap) ||
+      tree == NULL)
+  {
+    puts("Error creating the snapshot map.");
+    return EXIT_FAILURE;
+  }
+  puts("Publishing versions...");
+  GenUtils_BinaryTreeInsert(tree, keyValue);
+  keyValue.key = "a";
+  keyValue.value = "A";
+  GenUtils_BinaryTreeInsert(tree, keyValue);
+  if (!GenUtils_SnapshotMapPublish(snapshotMap, tree) ||
+      GenUtils_SnapshotMapGetSize(snapshotMap) != 2 ||
+      strcmp(GenUtils_SnapshotMapGet(snapshotMap, "a"),
+        "A") != 0 ||
+      !GenUtils_SnapshotMapExist(snapshotMap, "b") ||
+      GenUtils_SnapshotMapExist(snapshotMap, "c"))
+  {
+    puts("Error publishing versions.");
+    GenUtils_SnapshotMapDestroy(snapshotMap);
+    return EXIT_FAILURE;
+  }
+  GenUtils_BinaryTreeClear(tree);
+  if (GenUtils_SnapshotMapGetSize(snapshotMap) != 2 ||
+      !GenUtils_SnapshotMapPublish(snapshotMap, tree) ||
+      !GenUtils_SnapshotMapEmpty(snapshotMap))
+  {
+    puts("Error publishing empty versions.");
+    GenUtils_SnapshotMapDestroy(snapshotMap);
+    return EXIT_FAILURE;
+  }
+  // With no reader, every replaced version is released by
+  // the Publish that replaced it.
+  if (atomic_load(&allocator.released) != 2)
+  {
+    puts("Error, the old versions were not released.");
+    GenUtils_SnapshotMapDestroy(snapshotMap);
+    return EXIT_FAILURE;
+  }
+  puts("Publishing while several threads read...");
+  for (size_t i = 0; i < TEST_SIZE; i++)
+  {
+    snprintf(keys[i], sizeof(keys[i]), "key%08zu", i);
+  }
+  for (size_t i = 0; i < TEST_READERS; i++)
+  {
+    if (pthread_create(&threads[i], NULL, Read, NULL) != 0)
+    {
+      puts("Error creating the threads.");
+      return EXIT_FAILURE;
+    }
+  }
+  for (uintptr_t version = 1; version <= TEST_VERSIONS;
+       version++)
+  {
+    GenUtils_BinaryTreeClear(tree);
+    for (size_t i = 0; i < TEST_SIZE; i++)
+    {
+      keyValue.key = keys[i];
+      keyValue.value = (void *)version;
+      GenUtils_BinaryTreeInsert(tree, keyValue);
+    }
+    if (!GenUtils_SnapshotMapPublish(snapshotMap, tree))
+    {
+      puts("Error publishing versions.");
+      exit(EXIT_FAILURE);
+    }
+  }
+  atomic_store(&done, true);
+  for (size_t i = 0; i < TEST_READERS; i++)
+  {
+    pthread_join(threads[i], NULL);
+  }
+  // The versions held by the readers are released by the
+  // next Publish.
+  if (!GenUtils_SnapshotMapPublish(snapshotMap, tree) ||
+      atomic_load(&allocator.released) != TEST_VERSIONS + 3)
+  {
+    puts("Error, the old versions were not released.");
+    GenUtils_SnapshotMapDestroy(snapshotMap);
+    return EXIT_FAILURE;
+  }
+  puts("Iterating in order...");
+  GenUtils_SnapshotMapInorder(snapshotMap, &count, Count);
+  if (count != TEST_SIZE ||
+      (uintptr_t)GenUtils_SnapshotMapGet(
+        snapshotMap, keys[0]) != TEST_VERSIONS)
+  {
+    puts("Error iterating the snapshot map.");
+    GenUtils_SnapshotMapDestroy(snapshotMap);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying snapshot map...");
+  GenUtils_SnapshotMapDestroy(snapshotMap);
+  if (TestAllocatorLeaks(&allocator))
+  {
+    puts("Error, some memory was not released.");
+    return EXIT_FAILURE;
+  }
+  TestAllocatorDestroy(&allocator);
+  puts("Destroying with an allocator that is reset...");
+  TestAllocatorInit(&allocator, true);
+  snapshotMap = GenUtils_SnapshotMapCreateWithAllocator(
+    &allocator.allocator);
+  if (!GenUtils_SnapshotMapPublish(snapshotMap, tree) ||
+      GenUtils_SnapshotMapAcquire(snapshotMap) == NULL)
+  {
+    puts("Error publishing versions.");
+    GenUtils_SnapshotMapDestroy(snapshotMap);
+    return EXIT_FAILURE;
+  }
+  // The acquired version keeps the replaced one retired.
+  if (!GenUtils_SnapshotMapPublish(snapshotMap, tree))
+  {
+    puts("Error publishing versions.");
+    GenUtils_SnapshotMapDestroy(snapshotMap);
+    return EXIT_FAILURE;
+  }
+  GenUtils_SnapshotMapRelease(snapshotMap);
+  GenUtils_SnapshotMapDestroy(snapshotMap);
+  if (atomic_load(&allocator.resets) != 1 ||
+      TestAllocatorLeaks(&allocator))
+  {
+    puts("Error, the allocator was not reset once.");
+    return EXIT_FAILURE;
+  }
+  TestAllocatorDestroy(&allocator);
+  GenUtils_BinaryTreeDestroy(tree);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+/// @file Stack.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a stack.
+#include <GenUtils/Stack.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Number of elements used in the test.
+#define TEST_SIZE 1000
+
+int main(void)
+{
+  GenUtils_Stack *stack = NULL;
+  static int array[TEST_SIZE];
+  puts("Test for the implementation of a stack.");
+  puts("Creating the test stack...");
+  stack = GenUtils_StackCreate();
+  if (!GenUtils_StackWasInit(stack))
+  {
+    puts("Error creating the stack.");
+    return EXIT_FAILURE;
+  }
+  puts("Pushing elements...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    array[i] = i;
+    if (!GenUtils_StackPush(stack, &array[i]) ||
+        GenUtils_StackTop(stack) != &array[i])
+    {
+      puts("Error pushing elements.");
+      GenUtils_StackDestroy(stack);
+      return EXIT_FAILURE;
+    }
+  }
+  printf("Size: %zu, capacity: %zu.\n",
+    GenUtils_StackGetSize(stack),
+    GenUtils_StackGetCapacity(stack));
+  puts("Popping elements...");
+  for (int i = TEST_SIZE - 1; i >= 0; i--)
+  {
+    if (i % 2 == 0 && GenUtils_StackPop(stack) != &array[i])
+    {
+      puts("Error popping elements.");
+      GenUtils_StackDestroy(stack);
+      return EXIT_FAILURE;
+    }
+    if (i % 2 == 1 &&
+        (GenUtils_StackTop(stack) != &array[i] ||
+          !GenUtils_StackPopBool(stack)))
+    {
+      puts("Error popping elements.");
+      GenUtils_StackDestroy(stack);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!GenUtils_StackEmpty(stack) ||
+      GenUtils_StackPopBool(stack))
+  {
+    puts("The stack isn't empty.");
+    GenUtils_StackDestroy(stack);
+    return EXIT_FAILURE;
+  }
+  puts("Shrinking the stack...");
+  GenUtils_StackPush(stack, &array[0]);
+  if (!GenUtils_StackShrink(stack) ||
+      GenUtils_StackGetCapacity(stack) !=
+        GENUTILS_STACK_INLINE_CAPACITY ||
+      GenUtils_StackTop(stack) != &array[0])
+  {
+    puts("Error shrinking the stack.");
+    GenUtils_StackDestroy(stack);
+    return EXIT_FAILURE;
+  }
+  puts("Reserving memory...");
+  if (!GenUtils_StackReserve(stack, TEST_SIZE) ||
+      GenUtils_StackGetCapacity(stack) != TEST_SIZE ||
+      GenUtils_StackTop(stack) != &array[0])
+  {
+    puts("Error reserving memory.");
+    GenUtils_StackDestroy(stack);
+    return EXIT_FAILURE;
+  }
+  puts("Clearing the stack...");
+  GenUtils_StackClear(stack);
+  if (!GenUtils_StackEmpty(stack))
+  {
+    puts("Error clearing the stack.");
+    GenUtils_StackDestroy(stack);
+    return EXIT_FAILURE;
+  }
+  puts("Destroying stack...");
+  GenUtils_StackDestroy(stack);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,181 @@
+/// @file TestUtils.h
+/// @author DP-Dev.
+/// @brief Helpers shared by the tests of the containers.
+#ifndef GENUTILS_TEST_UTILS_H
+#define GENUTILS_TEST_UTILS_H
+#include <GenUtils/Allocator.h>
+#include <GenUtils/BinaryTree.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// @brief Check that the elements of a traversal come in
+/// order.
+/// @param keyValue The current element.
+/// @param extradata The previous key.
+static inline void CheckOrder(
+  const GenUtils_BinaryTreeKeyValue *keyValue,
+  void *extradata)
+{
+  const char **previous = extradata;
+  if (*previous != NULL &&
+      strcmp(*previous, keyValue->key) >= 0)
+  {
+    puts("Error, the elements are not in order.");
+    exit(EXIT_FAILURE);
+  }
+  *previous = keyValue->key;
+}
+
+/// @brief Count the elements of a traversal.
+/// @param keyValue The current element.
+/// @param extradata The counter.
+static inline void Count(
+  const GenUtils_BinaryTreeKeyValue *keyValue,
+  void *extradata)
+{
+  (void)keyValue;
+  (*(size_t *)extradata)++;
+}
+
+/// @brief The header of a block of a test allocator,
+/// keeping the alignment of malloc.
+typedef union TestBlock
+{
+  /// @brief The links of the live blocks.
+  struct
+  {
+    union TestBlock *previous;
+    union TestBlock *next;
+  } links;
+  /// @brief Keeps the memory after the header aligned.
+  max_align_t align;
+} TestBlock;
+
+/// @brief An allocator that counts the released blocks and
+/// can release all its blocks at once. It's thread-safe.
+typedef struct TestAllocator
+{
+  /// @brief The allocator passed to the containers.
+  GenUtils_Allocator allocator;
+  /// @brief The lock of the live blocks.
+  pthread_mutex_t lock;
+  /// @brief The list of live blocks.
+  TestBlock blocks;
+  /// @brief The number of blocks released one by one.
+  _Atomic size_t released;
+  /// @brief The number of resets.
+  _Atomic size_t resets;
+  /// @brief The number of blocks allocated.
+  _Atomic size_t allocated;
+  /// @brief The number of blocks allocated before the next
+  /// ones fail, 0 for no limit.
+  size_t limit;
+} TestAllocator;
+
+/// @brief Allocate a block of a test allocator.
+/// @param context The test allocator.
+/// @param size The number of bytes to allocate.
+/// @return The memory or NULL on error.
+static inline void *TestAlloc(void *context, size_t size)
+{
+  TestAllocator *test = context;
+  TestBlock *block = NULL;
+  size_t index = atomic_fetch_add(&test->allocated, 1);
+  if (test->limit != 0 && index >= test->limit)
+  {
+    return NULL;
+  }
+  block = malloc(sizeof(TestBlock) + size);
+  if (block == NULL)
+  {
+    return NULL;
+  }
+  pthread_mutex_lock(&test->lock);
+  block->links.previous = &test->blocks;
+  block->links.next = test->blocks.links.next;
+  block->links.next->links.previous = block;
+  test->blocks.links.next = block;
+  pthread_mutex_unlock(&test->lock);
+  return block + 1;
+}
+
+/// @brief Release a block of a test allocator, counting it.
+/// @param context The test allocator.
+/// @param pointer The memory to release.
+/// @param size Not used.
+static inline void TestFree(
+  void *context, void *pointer, size_t size)
+{
+  TestAllocator *test = context;
+  TestBlock *block = (TestBlock *)pointer - 1;
+  (void)size;
+  pthread_mutex_lock(&test->lock);
+  block->links.previous->links.next = block->links.next;
+  block->links.next->links.previous = block->links.previous;
+  pthread_mutex_unlock(&test->lock);
+  free(block);
+  atomic_fetch_add(&test->released, 1);
+}
+
+/// @brief Release all the blocks of a test allocator.
+/// @param context The test allocator.
+static inline void TestReset(void *context)
+{
+  TestAllocator *test = context;
+  TestBlock *block = NULL;
+  pthread_mutex_lock(&test->lock);
+  while ((block = test->blocks.links.next) != &test->blocks)
+  {
+    test->blocks.links.next = block->links.next;
+    free(block);
+  }
+  test->blocks.links.previous = &test->blocks;
+  pthread_mutex_unlock(&test->lock);
+  atomic_fetch_add(&test->resets, 1);
+}
+
+/// @brief Initialize a test allocator.
+/// @param test The allocator to initialize.
+/// @param canReset true to let the containers reset it.
+static inline void TestAllocatorInit(
+  TestAllocator *test, bool canReset)
+{
+  test->allocator.alloc = TestAlloc;
+  test->allocator.free = TestFree;
+  test->allocator.reset = canReset ? TestReset : NULL;
+  test->allocator.context = test;
+  pthread_mutex_init(&test->lock, NULL);
+  test->blocks.links.previous = &test->blocks;
+  test->blocks.links.next = &test->blocks;
+  atomic_init(&test->released, 0);
+  atomic_init(&test->resets, 0);
+  atomic_init(&test->allocated, 0);
+  test->limit = 0;
+}
+
+/// @brief Release the blocks left in a test allocator.
+/// @param test The allocator to destroy.
+static inline void TestAllocatorDestroy(TestAllocator *test)
+{
+  TestReset(test);
+  pthread_mutex_destroy(&test->lock);
+}
+
+/// @brief Check if a test allocator has live blocks.
+/// @param test The allocator to query.
+/// @return true if some block was not released.
+static inline bool TestAllocatorLeaks(TestAllocator *test)
+{
+  bool leaks = false;
+  pthread_mutex_lock(&test->lock);
+  leaks = test->blocks.links.next != &test->blocks;
+  pthread_mutex_unlock(&test->lock);
+  return leaks;
+}
+
+#endif
@@ -0,0 +1,205 @@
+/// @file UCDLL.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of an unrolled CDLL.
+#include "TestUtils.h"
+#include <GenUtils/UCDLL.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Number of elements used in the test.
+#define TEST_SIZE 100
+
+/// @brief Count the elements of a list.
+/// @param userdata The current element.
+/// @param extradata Pointer to the counter.
+static void CountElement(void *userdata, void *extradata)
+{
+  (void)userdata;
+  *(size_t *)extradata += 1;
+}
+
+/// @brief Check that the blocks of a list are aligned and
+/// that all of them but the tail are at least half full.
+/// @param list The list to check.
+/// @return true if the blocks are right.
+static bool CheckBlocks(GenUtils_UCDLL *list)
+{
+  GenUtils_UCDLLBlock *block = list->head;
+  if (block == NULL)
+  {
+    return true;
+  }
+  do
+  {
+    if ((uintptr_t)block % GENUTILS_CACHE_LINE != 0 ||
+        (block->next != list->head &&
+          block->count < GENUTILS_UCDLL_BLOCK_CAPACITY / 2))
+    {
+      return false;
+    }
+    block = block->next;
+  } while (block != list->head);
+  return true;
+}
+
+int main(void)
+{
+  GenUtils_UCDLL *list = NULL;
+  GenUtils_UCDLLPosition position;
+  static int array[TEST_SIZE];
+  TestAllocator allocator;
+  size_t count = 0;
+  int expected = 0;
+  puts("Test for the implementation of an unrolled CDLL.");
+  puts("Creating the test list...");
+  list = GenUtils_UCDLLCreate();
+  if (!GenUtils_UCDLLWasInit(list))
+  {
+    puts("Error creating the list.");
+    return EXIT_FAILURE;
+  }
+  puts("Pushing elements at both ends...");
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    array[i] = i;
+  }
+  for (int i = TEST_SIZE / 2; i < TEST_SIZE; i++)
+  {
+    if (!GenUtils_UCDLLPushBack(list, &array[i]))
+    {
+      puts("Error appending elements.");
+      GenUtils_UCDLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+  }
+  for (int i = TEST_SIZE / 2 - 1; i >= 0; i--)
+  {
+    if (!GenUtils_UCDLLPushFront(list, &array[i]))
+    {
+      puts("Error prepending elements.");
+      GenUtils_UCDLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Checking the order of the elements...");
+  position = GenUtils_UCDLLBegin(list);
+  while (position.block != NULL)
+  {
+    if (GenUtils_UCDLLGet(position) != &array[expected])
+    {
+      puts("Error, the elements are not in order.");
+      GenUtils_UCDLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+    expected++;
+    position = GenUtils_UCDLLNext(list, position);
+  }
+  if (expected != TEST_SIZE)
+  {
+    puts("Error, the list was not fully traversed.");
+    GenUtils_UCDLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  puts("Finding and removing the odd elements...");
+  for (int i = 1; i < TEST_SIZE; i += 2)
+  {
+    position = GenUtils_UCDLLFind(list, &array[i]);
+    if (GenUtils_UCDLLGet(position) != &array[i] ||
+        !GenUtils_UCDLLRemove(list, position))
+    {
+      puts("Error finding an element.");
+      GenUtils_UCDLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+  }
+  position = GenUtils_UCDLLFind(list, &array[1]);
+  if (position.block != NULL ||
+      GenUtils_UCDLLGetSize(list) != TEST_SIZE / 2 ||
+      !CheckBlocks(list))
+  {
+    puts("Error, a removed element is still in the list.");
+    GenUtils_UCDLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  puts("Inserting the odd elements back...");
+  for (int i = 1; i < TEST_SIZE; i += 2)
+  {
+    position = GenUtils_UCDLLFind(list, &array[i - 1]);
+    if (!GenUtils_UCDLLInsertAfter(
+          list, position, &array[i]))
+    {
+      puts("Error inserting an element.");
+      GenUtils_UCDLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+  }
+  GenUtils_UCDLLIterate(list, &count, CountElement);
+  if (count != TEST_SIZE)
+  {
+    puts("Error iterating the list.");
+    GenUtils_UCDLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  puts("Popping elements from both ends...");
+  for (int i = 0; i < TEST_SIZE / 2; i++)
+  {
+    if (GenUtils_UCDLLPopFront(list) != &array[i] ||
+        GenUtils_UCDLLPopBack(list) !=
+          &array[TEST_SIZE - 1 - i])
+    {
+      puts("Error popping elements.");
+      GenUtils_UCDLLDestroy(list);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!GenUtils_UCDLLEmpty(list))
+  {
+    puts("Error, the list is not empty.");
+    GenUtils_UCDLLDestroy(list);
+    return EXIT_FAILURE;
+  }
+  puts("Removing elements after a position...");
+  GenUtils_UCDLLDestroy(list);
+  TestAllocatorInit(&allocator, false);
+  list = GenUtils_UCDLLCreateWithAllocator(
+    &allocator.allocator);
+  for (int i = 0; i < TEST_SIZE; i++)
+  {
+    if (!GenUtils_UCDLLPushBack(list, &array[i]))
+    {
+      puts("Error appending elements.");
+      GenUtils_UCDLLDestroy(list);
+      TestAllocatorDestroy(&allocator);
+      return EXIT_FAILURE;
+    }
+  }
+  position = GenUtils_UCDLLBegin(list);
+  // Removals in the next blocks can merge them into the
+  // head, but the position of the head must stay valid.
+  while (position.block->next != position.block)
+  {
+    GenUtils_UCDLLPosition next = {
+      position.block->next, 0};
+    GenUtils_UCDLLRemove(list, next);
+    if (GenUtils_UCDLLGet(position) != &array[0] ||
+        !CheckBlocks(list))
+    {
+      puts("Error, a position was invalidated.");
+      GenUtils_UCDLLDestroy(list);
+      TestAllocatorDestroy(&allocator);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Destroying list...");
+  GenUtils_UCDLLDestroy(list);
+  if (TestAllocatorLeaks(&allocator))
+  {
+    puts("Error, the list leaked memory.");
+    TestAllocatorDestroy(&allocator);
+    return EXIT_FAILURE;
+  }
+  TestAllocatorDestroy(&allocator);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}
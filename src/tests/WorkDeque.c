@@ -0,0 +1,163 @@
+/// @file WorkDeque.c
+/// @author DP-Dev.
+/// @brief Test for the implementation of a work-stealing
+/// deque.
+#include <GenUtils/WorkDeque.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/// @brief Number of thief threads.
+#define TEST_THIEVES 3
+/// @brief Number of elements pushed by the owner.
+#define TEST_SIZE 200000
+
+/// @brief The deque used by all the threads.
+static GenUtils_WorkDeque *deque = NULL;
+/// @brief Set when the owner has finished.
+static atomic_bool done = false;
+/// @brief The number of times every element was taken.
+static _Atomic unsigned char taken[TEST_SIZE + 1];
+
+/// @brief Mark an element as taken.
+/// @param userdata The element.
+static void Take(void *userdata)
+{
+  atomic_fetch_add_explicit(&taken[(uintptr_t)userdata], 1,
+    memory_order_relaxed);
+}
+
+/// @brief Steal elements until the owner has finished and
+/// the deque is empty.
+/// @param argument Unused.
+/// @return NULL.
+static void *Steal(void *argument)
+{
+  void *userdata = NULL;
+  (void)argument;
+  while (!atomic_load(&done) ||
+         !GenUtils_WorkDequeEmpty(deque))
+  {
+    if (GenUtils_WorkDequeSteal(deque, &userdata))
+    {
+      Take(userdata);
+    }
+    else
+    {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+int main(void)
+{
+  pthread_t threads[TEST_THIEVES];
+  void *userdata = NULL;
+  puts("Test for the implementation of a work-stealing "
+       "deque.");
+  puts("Creating the test deque...");
+  deque = GenUtils_WorkDequeCreate();
+  if (!GenUtils_WorkDequeWasInit(deque) ||
+      !GenUtils_WorkDequeEmpty(deque))
+  {
+    puts("Error creating the deque.");
+    return EXIT_FAILURE;
+  }
+  puts("Pushing elements...");
+  for (uintptr_t i = 1; i <= 1000; i++)
+  {
+    if (!GenUtils_WorkDequePush(deque, (void *)i))
+    {
+      puts("Error pushing elements.");
+      GenUtils_WorkDequeDestroy(deque);
+      return EXIT_FAILURE;
+    }
+  }
+  if (GenUtils_WorkDequeGetSize(deque) != 1000 ||
+      (uintptr_t)GenUtils_WorkDequeTop(deque) != 1000)
+  {
+    puts("Error, the top is not the last element.");
+    GenUtils_WorkDequeDestroy(deque);
+    return EXIT_FAILURE;
+  }
+  puts("Stealing the oldest elements...");
+  for (uintptr_t i = 1; i <= 10; i++)
+  {
+    if (!GenUtils_WorkDequeSteal(deque, &userdata) ||
+        (uintptr_t)userdata != i)
+    {
+      puts("Error stealing elements.");
+      GenUtils_WorkDequeDestroy(deque);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Popping the newest elements...");
+  for (uintptr_t i = 1000; i > 10; i--)
+  {
+    if ((uintptr_t)GenUtils_WorkDequePop(deque) != i)
+    {
+      puts("Error popping elements.");
+      GenUtils_WorkDequeDestroy(deque);
+      return EXIT_FAILURE;
+    }
+  }
+  if (!GenUtils_WorkDequeEmpty(deque) ||
+      GenUtils_WorkDequePopBool(deque) ||
+      GenUtils_WorkDequeSteal(deque, &userdata))
+  {
+    puts("Error, the deque is not empty.");
+    GenUtils_WorkDequeDestroy(deque);
+    return EXIT_FAILURE;
+  }
+  puts("Pushing and popping while other threads steal...");
+  for (size_t i = 0; i < TEST_THIEVES; i++)
+  {
+    if (pthread_create(&threads[i], NULL, Steal, NULL) != 0)
+    {
+      puts("Error creating the threads.");
+      return EXIT_FAILURE;
+    }
+  }
+  for (uintptr_t i = 1; i <= TEST_SIZE; i++)
+  {
+    if (!GenUtils_WorkDequePush(deque, (void *)i))
+    {
+      puts("Error pushing elements.");
+      exit(EXIT_FAILURE);
+    }
+    // Pop one element of every three pushed.
+    if (i % 3 == 0 && GenUtils_WorkDequePopBool(deque))
+    {
+      Take((void *)i);
+    }
+  }
+  while (!GenUtils_WorkDequeEmpty(deque))
+  {
+    userdata = GenUtils_WorkDequePop(deque);
+    if (userdata != NULL)
+    {
+      Take(userdata);
+    }
+  }
+  atomic_store(&done, true);
+  for (size_t i = 0; i < TEST_THIEVES; i++)
+  {
+    pthread_join(threads[i], NULL);
+  }
+  for (size_t i = 1; i <= TEST_SIZE; i++)
+  {
+    if (atomic_load(&taken[i]) != 1)
+    {
+      puts("Error, an element was lost or taken twice.");
+      GenUtils_WorkDequeDestroy(deque);
+      return EXIT_FAILURE;
+    }
+  }
+  puts("Destroying deque...");
+  GenUtils_WorkDequeDestroy(deque);
+  puts("Test passed!");
+  return EXIT_SUCCESS;
+}